@@ -0,0 +1,233 @@
+#ifndef GlobalHitsHistoFiles_h
+#define GlobalHitsHistoFiles_h
+
+/** \file GlobalHitsHistoFiles.h
+ *
+ *  Reading of the GlobalHitsV histograms of a DQM output file, shared by
+ *  the globalHitsMerge and globalHitsCompare executables. The histograms
+ *  are detached from their file (TH1::AddDirectory(kFALSE) must be set
+ *  before reading) and keyed by their full path.
+ *
+ *  A fingerprint is a 64 bit FNV-1a hash of the binning (number of bins,
+ *  limits and, for variable bins, the edges of every axis of the
+ *  histogram), of all bin contents including under- and overflow, of the sums of squared weights
+ *  and of the entries of a histogram. The bytes of every number are fed
+ *  in a fixed order, so the hash does not depend on the platform, and
+ *  identical fingerprints mean bitwise identical histograms (up to hash
+ *  collisions). They are kept next to a ROOT file as "<file>.fingerprints",
+ *  one "hash path" line per histogram, after a "# uuid" line with the
+ *  TFile UUID of the file they were computed from. A fingerprint file
+ *  whose UUID is not the one of the file next to it (e.g. the ROOT file
+ *  was replaced, but not its fingerprints) is not used.
+ */
+
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TH1.h"
+#include "TAxis.h"
+#include "TArrayD.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace globalhits {
+
+  typedef std::map<std::string, std::unique_ptr<TH1> > Histos;
+
+  // every histogram below a directory called folder, by its full path; of
+  // several cycles of one key only the highest, which is listed first
+  inline void collect(TDirectory* dir, const std::string& path,
+		      const std::string& folder, bool inFolder, 
+		      Histos& histos)
+  {
+    std::set<std::string> seen;
+    TIter next(dir->GetListOfKeys());
+    while (TKey* key = (TKey*)next()) {
+      std::string name = key->GetName();
+      if (!seen.insert(name).second) continue;
+
+      TClass* cl = TClass::GetClass(key->GetClassName());
+      if (!cl) continue;
+      std::string keypath = path.empty() ? name : path + "/" + name;
+
+      if (cl->InheritsFrom(TDirectory::Class())) {
+	TDirectory* sub = dir->GetDirectory(name.c_str());
+	if (sub) collect(sub, keypath, folder, inFolder || name == folder,
+			 histos);
+      } else if (inFolder && cl->InheritsFrom(TH1::Class())) {
+	TH1* h = (TH1*)key->ReadObj();
+	if (h) histos[keypath].reset(h);
+      }
+    }
+  }
+
+  // path from the folder directory on, so that files whose folder sits at
+  // different depths (e.g. below "DQMData/Run 1") can be matched
+  inline std::string relativePath(const std::string& path,
+				  const std::string& folder)
+  {
+    if (path.compare(0, folder.size() + 1, folder + "/") == 0) return path;
+    std::string::size_type pos = path.find("/" + folder + "/");
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+  }
+
+  // false if the file cannot be opened
+  inline bool read(const std::string& file, const std::string& folder,
+		   Histos& histos)
+  {
+    std::unique_ptr<TFile> in(TFile::Open(file.c_str(), "READ"));
+    if (!in || in->IsZombie()) return false;
+    collect(in.get(), "", folder, false, histos);
+    return true;
+  }
+
+  typedef unsigned long long Fingerprint;
+  typedef std::map<std::string, Fingerprint> Fingerprints;
+
+  inline void hashBytes(Fingerprint& h, unsigned long long bits, int n)
+  {
+    for (int k = 0; k < n; ++k) {
+      h ^= (bits >> (8 * k)) & 0xff;
+      h *= 1099511628211ULL;
+    }
+  }
+
+  inline void hashDouble(Fingerprint& h, double x)
+  {
+    unsigned long long bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    hashBytes(h, bits, 8);
+  }
+
+  inline void hashAxis(Fingerprint& h, const TAxis* axis)
+  {
+    hashBytes(h, axis->GetNbins(), 4);
+    hashDouble(h, axis->GetXmin());
+    hashDouble(h, axis->GetXmax());
+    const TArrayD* edges = axis->GetXbins();
+    hashBytes(h, edges->GetSize(), 4);
+    for (int i = 0; i < edges->GetSize(); ++i) hashDouble(h, edges->GetAt(i));
+  }
+
+  // the axes used by a histogram of its dimension
+  inline int axes(const TH1* hist, const TAxis* axis[3])
+  {
+    axis[0] = hist->GetXaxis();
+    axis[1] = hist->GetYaxis();
+    axis[2] = hist->GetZaxis();
+    return hist->GetDimension();
+  }
+
+  inline bool sameAxis(const TAxis* a, const TAxis* b)
+  {
+    if (a->GetNbins() != b->GetNbins() || a->GetXmin() != b->GetXmin() ||
+	a->GetXmax() != b->GetXmax()) return false;
+    const TArrayD* ea = a->GetXbins();
+    const TArrayD* eb = b->GetXbins();
+    if (ea->GetSize() != eb->GetSize()) return false;
+    for (int i = 0; i < ea->GetSize(); ++i)
+      if (ea->GetAt(i) != eb->GetAt(i)) return false;
+    return true;
+  }
+
+  // same dimension and bin edges on every axis
+  inline bool sameBinning(const TH1* a, const TH1* b)
+  {
+    const TAxis* aa[3];
+    const TAxis* ba[3];
+    const int dim = axes(a, aa);
+    if (axes(b, ba) != dim) return false;
+    for (int i = 0; i < dim; ++i)
+      if (!sameAxis(aa[i], ba[i])) return false;
+    return true;
+  }
+
+  inline Fingerprint fingerprint(const TH1* hist)
+  {
+    Fingerprint h = 14695981039346656037ULL;
+    const TAxis* axis[3];
+    const int dim = axes(hist, axis);
+    hashBytes(h, dim, 4);
+    for (int i = 0; i < dim; ++i) hashAxis(h, axis[i]);
+    const int nx = hist->GetNbinsX();
+    const int ny = dim > 1 ? hist->GetNbinsY() : -1;
+    const int nz = dim > 2 ? hist->GetNbinsZ() : -1;
+    const bool sumw2 = hist->GetSumw2N() > 0;
+    for (int iz = 0; iz <= nz + 1; ++iz) {
+      for (int iy = 0; iy <= ny + 1; ++iy) {
+	for (int ix = 0; ix <= nx + 1; ++ix) {
+	  const int bin = hist->GetBin(ix, iy, iz);
+	  hashDouble(h, hist->GetBinContent(bin));
+	  if (sumw2) hashDouble(h, hist->GetBinError(bin));
+	}
+      }
+    }
+    hashDouble(h, hist->GetEntries());
+    return h;
+  }
+
+  inline std::string fingerprintFile(const std::string& file)
+  {
+    return file + ".fingerprints";
+  }
+
+  // UUID of file, empty if it cannot be opened
+  inline std::string fileUUID(const std::string& file)
+  {
+    std::unique_ptr<TFile> in(TFile::Open(file.c_str(), "READ"));
+    if (!in || in->IsZombie()) return "";
+    return in->GetUUID().AsString();
+  }
+
+  // false if there is no fingerprint file, or if it does not belong to
+  // the file with this UUID
+  inline bool readFingerprints(const std::string& file,
+			       const std::string& uuid, Fingerprints& prints)
+  {
+    std::ifstream in(fingerprintFile(file).c_str());
+    if (!in || uuid.empty()) return false;
+    const std::string uuidTag = "# uuid ";
+    bool matched = false;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.compare(0, uuidTag.size(), uuidTag) == 0)
+	matched = line.substr(uuidTag.size()) == uuid;
+      if (line.empty() || line[0] == '#') continue;
+      if (!matched) break;
+      std::istringstream fields(line);
+      Fingerprint h;
+      fields >> std::hex >> h;
+      std::string path;
+      std::getline(fields >> std::ws, path);
+      if (!path.empty()) prints[path] = h;
+    }
+    if (!matched) prints.clear();
+    return matched;
+  }
+
+  // uuid is the one of file, see fileUUID
+  inline bool writeFingerprints(const std::string& file,
+				const std::string& uuid,
+				const Fingerprints& prints)
+  {
+    std::ofstream out(fingerprintFile(file).c_str());
+    if (!out) return false;
+    out << "# fingerprints of the histograms in " << file << "\n"
+	<< "# uuid " << uuid << "\n";
+    for (Fingerprints::const_iterator iter = prints.begin();
+	 iter != prints.end(); ++iter)
+      out << std::hex << std::setw(16) << std::setfill('0') << iter->second
+	  << " " << iter->first << "\n";
+    return true;
+  }
+}
+
+#endif
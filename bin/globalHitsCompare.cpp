@@ -0,0 +1,359 @@
+/** \file globalHitsCompare.cpp
+ *
+ *  Compares the GlobalHitsV histograms of a new DQM output file with
+ *  those of a reference file:
+ *
+ *    globalHitsCompare [-j threads] [-f folder] [-t pvalue] [-o summary]
+ *                      [-w] [-r] new.root reference.root
+ *
+ *  Every histogram found below the folder (default GlobalHitsV) of either
+ *  file is matched by its path from the folder on and compared with
+ *  TH1::Chi2Test, TH1::KolmogorovTest and bin by bin pulls, the reference
+ *  being scaled to the integral of the new histogram for the pulls. The
+ *  comparisons run in parallel with ROOT 6.04 or later, made thread safe
+ *  first, and one after the other with older versions; the results are
+ *  reported in path order as [OVAL] lines on stdout and, with -o, as a
+ *  JSON summary.
+ *
+ *  A histogram fails when it is missing from one file, has a different
+ *  binning, or its Kolmogorov probability is below pvalue (default 0.01);
+ *  the exit code is 2 if any histogram failed, so the tool can gate a
+ *  validation. Plots are not drawn here: test/MakeValidation.C renders
+ *  the comparison when wanted.
+ *
+ *  Histograms whose fingerprint (see GlobalHitsHistoFiles.h) equals the
+ *  one of the reference are reported as identical without any test. The
+ *  reference fingerprints are taken from reference.root.fingerprints when
+ *  it exists and was written for this very file (its UUID matches; unless
+ *  -r), and the histograms of the reference are then only read if some
+ *  histogram differs. Once they are read, the reference fingerprints are
+ *  recomputed from them. -w stores the fingerprints of new.root next to
+ *  it, so that it can serve as the next reference.
+ */
+
+#include "GlobalHitsHistoFiles.h"
+
+#include "TROOT.h"
+#include "RVersion.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_scheduler_init.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Chi2Test and KolmogorovTest report through the ROOT error handler,
+// which is only safe to call concurrently once ROOT has been made thread
+// safe; older versions compare the histograms one after the other
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+#define GLOBALHITSCOMPARE_PARALLEL 1
+#else
+#define GLOBALHITSCOMPARE_PARALLEL 0
+#endif
+
+namespace {
+
+  typedef globalhits::Histos Histos;
+
+  // f(0) to f(n-1), concurrently where ROOT allows it
+  template <class F>
+  void forEach(std::size_t n, const F& f)
+  {
+#if GLOBALHITSCOMPARE_PARALLEL
+    tbb::parallel_for(std::size_t(0), n, f);
+#else
+    for (std::size_t i = 0; i < n; ++i) f(i);
+#endif
+  }
+
+  struct Result {
+    std::string path;
+    std::string status;      // identical, pass, fail, missing or binning
+    double entries;
+    double refEntries;
+    double chi2Prob;
+    double ksProb;
+    double maxPull;
+    int pullsAbove3;
+  };
+
+  void usage(const char* name)
+  {
+    std::cerr << "usage: " << name
+	      << " [-j threads] [-f folder] [-t pvalue] [-o summary.json]"
+	      << " new.root reference.root\n"
+	      << "  -j  number of threads (default: all cores)\n"
+	      << "  -f  name of the directory compared (default: GlobalHitsV)\n"
+	      << "  -t  minimal Kolmogorov probability (default: 0.01)\n"
+	      << "  -o  JSON summary of all comparisons\n"
+	      << "  -w  write the fingerprints of new.root next to it\n"
+	      << "  -r  ignore stored reference fingerprints\n";
+  }
+
+  // the histograms of one file keyed by their path from the folder on
+  bool readRelative(const std::string& file, const std::string& folder,
+		    Histos& histos)
+  {
+    Histos all;
+    if (!globalhits::read(file, folder, all)) return false;
+    for (Histos::iterator iter = all.begin(); iter != all.end(); ++iter)
+      histos[globalhits::relativePath(iter->first, folder)].swap
+	(iter->second);
+    return true;
+  }
+
+  void compare(const TH1* sh, const TH1* rh, double threshold, Result& r)
+  {
+    r.entries = sh ? sh->GetEntries() : 0.;
+    r.refEntries = rh ? rh->GetEntries() : 0.;
+    r.chi2Prob = r.ksProb = r.maxPull = 0.;
+    r.pullsAbove3 = 0;
+
+    if (!sh || !rh) {
+      r.status = "missing";
+      return;
+    }
+    if (!globalhits::sameBinning(sh, rh)) {
+      r.status = "binning";
+      return;
+    }
+
+    const double sint = sh->Integral();
+    const double rint = rh->Integral();
+    if (sint == 0. && rint == 0.) {
+      r.chi2Prob = r.ksProb = 1.;
+    } else if (sint == 0. || rint == 0.) {
+      r.chi2Prob = r.ksProb = 0.;
+    } else {
+      r.chi2Prob = rh->Chi2Test(sh, "UU");
+      r.ksProb = rh->KolmogorovTest(sh);
+    }
+
+    // pulls of the new contents against the scaled reference
+    const double scale = rint > 0. ? sint / rint : 1.;
+    for (int iz = 1; iz <= sh->GetNbinsZ(); ++iz) {
+      for (int iy = 1; iy <= sh->GetNbinsY(); ++iy) {
+	for (int ix = 1; ix <= sh->GetNbinsX(); ++ix) {
+	  const int bin = sh->GetBin(ix, iy, iz);
+	  const double es = sh->GetBinError(bin);
+	  const double er = scale * rh->GetBinError(bin);
+	  const double sigma = std::sqrt(es * es + er * er);
+	  if (sigma == 0.) continue;
+	  const double pull = (sh->GetBinContent(bin) -
+			       scale * rh->GetBinContent(bin)) / sigma;
+	  if (std::fabs(pull) > std::fabs(r.maxPull)) r.maxPull = pull;
+	  if (std::fabs(pull) > 3.) ++r.pullsAbove3;
+	}
+      }
+    }
+
+    r.status = r.ksProb >= threshold ? "pass" : "fail";
+  }
+
+  void fingerprintAll(const Histos& histos, globalhits::Fingerprints& prints)
+  {
+    std::vector<const TH1*> hists;
+    for (Histos::const_iterator iter = histos.begin();
+	 iter != histos.end(); ++iter)
+      hists.push_back(iter->second.get());
+    std::vector<globalhits::Fingerprint> hashes(hists.size());
+    forEach(hists.size(), [&](std::size_t i) {
+	hashes[i] = globalhits::fingerprint(hists[i]);
+      });
+    std::size_t i = 0;
+    for (Histos::const_iterator iter = histos.begin();
+	 iter != histos.end(); ++iter, ++i)
+      prints[iter->first] = hashes[i];
+  }
+
+  // JSON has no NaN or infinity
+  std::string number(double x)
+  {
+    if (std::isnan(x) || std::isinf(x)) return "null";
+    std::ostringstream s;
+    s.precision(8);
+    s << x;
+    return s.str();
+  }
+
+  std::string quoted(const std::string& text)
+  {
+    std::string q = "\"";
+    for (std::string::size_type i = 0; i < text.size(); ++i) {
+      if (text[i] == '"' || text[i] == '\\') q += '\\';
+      q += text[i];
+    }
+    return q + "\"";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int threads = tbb::task_scheduler_init::automatic;
+  std::string folder = "GlobalHitsV";
+  std::string summary;
+  double threshold = 0.01;
+  bool writePrints = false;
+  bool storedPrints = true;
+  std::vector<std::string> files;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if ((arg == "-j" || arg == "-f" || arg == "-t" || arg == "-o") &&
+	i + 1 >= argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    if (arg == "-j") {
+      threads = std::atoi(argv[++i]);
+    } else if (arg == "-f") {
+      folder = argv[++i];
+    } else if (arg == "-t") {
+      threshold = std::atof(argv[++i]);
+    } else if (arg == "-o") {
+      summary = argv[++i];
+    } else if (arg == "-w") {
+      writePrints = true;
+    } else if (arg == "-r") {
+      storedPrints = false;
+    } else if (arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      return 0;
+    } else {
+      files.push_back(arg);
+    }
+  }
+  if (files.size() != 2 || threads == 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  tbb::task_scheduler_init init(threads);
+#if GLOBALHITSCOMPARE_PARALLEL
+  ROOT::EnableThreadSafety();
+#endif
+
+  // the histograms are owned here, not by the directory they come from
+  TH1::AddDirectory(kFALSE);
+
+  Histos histos[2];
+  globalhits::Fingerprints prints[2];
+  if (!readRelative(files[0], folder, histos[0])) {
+    std::cerr << "Unable to open input file " << files[0] << "\n";
+    return 1;
+  }
+  fingerprintAll(histos[0], prints[0]);
+  if (writePrints &&
+      !globalhits::writeFingerprints(files[0],
+				     globalhits::fileUUID(files[0]),
+				     prints[0]))
+    std::cerr << "Unable to write fingerprints of " << files[0] << "\n";
+
+  // the reference is only read when a histogram differs from its
+  // stored fingerprint
+  bool readReference = !storedPrints ||
+    !globalhits::readFingerprints(files[1], globalhits::fileUUID(files[1]),
+				  prints[1]);
+  for (globalhits::Fingerprints::iterator iter = prints[0].begin();
+       iter != prints[0].end() && !readReference; ++iter) {
+    globalhits::Fingerprints::iterator ref = prints[1].find(iter->first);
+    if (ref == prints[1].end() || ref->second != iter->second)
+      readReference = true;
+  }
+  if (readReference) {
+    if (!readRelative(files[1], folder, histos[1])) {
+      std::cerr << "Unable to open input file " << files[1] << "\n";
+      return 1;
+    }
+    // what was read, not what was stored, is compared
+    prints[1].clear();
+    fingerprintAll(histos[1], prints[1]);
+  }
+
+  // the union of both files, in path order
+  std::map<std::string, std::pair<const TH1*, const TH1*> > pairs;
+  for (int f = 0; f < 2; ++f) {
+    for (globalhits::Fingerprints::iterator iter = prints[f].begin();
+	 iter != prints[f].end(); ++iter)
+      pairs[iter->first];
+    for (Histos::iterator iter = histos[f].begin();
+	 iter != histos[f].end(); ++iter) {
+      std::pair<const TH1*, const TH1*>& p = pairs[iter->first];
+      if (f == 0) p.first = iter->second.get();
+      else p.second = iter->second.get();
+    }
+  }
+
+  std::vector<Result> results(pairs.size());
+  std::vector<std::pair<const TH1*, const TH1*> > work;
+  std::size_t k = 0;
+  for (std::map<std::string, std::pair<const TH1*, const TH1*> >::iterator
+	 iter = pairs.begin(); iter != pairs.end(); ++iter, ++k) {
+    results[k].path = iter->first;
+    work.push_back(iter->second);
+  }
+  forEach(work.size(), [&](std::size_t i) {
+      Result& r = results[i];
+      globalhits::Fingerprints::const_iterator s = prints[0].find(r.path);
+      globalhits::Fingerprints::const_iterator f = prints[1].find(r.path);
+      if (work[i].first && s != prints[0].end() && f != prints[1].end() &&
+	  s->second == f->second) {
+	r.status = "identical";
+	r.entries = r.refEntries = work[i].first->GetEntries();
+	r.chi2Prob = r.ksProb = 1.;
+	r.maxPull = 0.;
+	r.pullsAbove3 = 0;
+      } else {
+	compare(work[i].first, work[i].second, threshold, r);
+      }
+    });
+
+  int failed = 0, identical = 0;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    if (r.status == "identical") ++identical;
+    else if (r.status != "pass") ++failed;
+    std::cout << "[OVAL] " << r.path << " " << r.status
+	      << " PV = " << r.ksProb << " Chi2PV = " << r.chi2Prob
+	      << " MaxPull = " << r.maxPull << "\n";
+  }
+  std::cout << "Compared " << results.size() << " histograms, "
+	    << identical << " identical, " << failed << " failed\n";
+
+  if (!summary.empty()) {
+    std::ofstream out(summary.c_str());
+    if (!out) {
+      std::cerr << "Unable to create summary file " << summary << "\n";
+      return 1;
+    }
+    out << "{\n"
+	<< "  \"new\": " << quoted(files[0]) << ",\n"
+	<< "  \"reference\": " << quoted(files[1]) << ",\n"
+	<< "  \"threshold\": " << number(threshold) << ",\n"
+	<< "  \"compared\": " << results.size() << ",\n"
+	<< "  \"identical\": " << identical << ",\n"
+	<< "  \"failed\": " << failed << ",\n"
+	<< "  \"histograms\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      const Result& r = results[i];
+      out << (i ? ",\n" : "\n")
+	  << "    {\"path\": " << quoted(r.path)
+	  << ", \"status\": " << quoted(r.status)
+	  << ", \"entries\": " << number(r.entries)
+	  << ", \"refEntries\": " << number(r.refEntries)
+	  << ", \"chi2Prob\": " << number(r.chi2Prob)
+	  << ", \"ksProb\": " << number(r.ksProb)
+	  << ", \"maxPull\": " << number(r.maxPull)
+	  << ", \"pullsAbove3\": " << r.pullsAbove3 << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+  return failed ? 2 : 0;
+}
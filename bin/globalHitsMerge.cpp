@@ -0,0 +1,255 @@
+/** \file globalHitsMerge.cpp
+ *
+ *  Merges the GlobalHitsV histograms of many DQM output files, e.g. the
+ *  100 jobs of data/SVSuiteSpec.xml, into one file:
+ *
+ *    globalHitsMerge [-j threads] [-f folder] [-l list] -o out.root
+ *                    in1.root in2.root ...
+ *
+ *  Only the histograms below a directory called folder (default
+ *  GlobalHitsV) are read. Each histogram is merged over the input files
+ *  by a pairwise tree reduction whose shape depends only on the number of
+ *  files: at every level file i absorbs file i+stride. The reductions of
+ *  all histograms, and the pairs within one level, run in parallel, but
+ *  every sum is taken in the same order whatever the number of threads,
+ *  so the merged contents are bitwise identical; the output is written
+ *  in sorted path order, together with the fingerprints of the merged
+ *  histograms in out.root.fingerprints (see GlobalHitsHistoFiles.h).
+ *
+ *  A histogram binned differently in two files, or that TH1::Add refuses
+ *  to sum, stops the merge with exit code 1 and no output is written.
+ *
+ *  The GlobalHitsHist1D run products of GlobalHitsProdHist are merged by
+ *  the framework itself (GlobalHitsHist1D::mergeProduct) when the EDM
+ *  files are merged, and need not go through this tool.
+ */
+
+#include "GlobalHitsHistoFiles.h"
+
+#include "TROOT.h"
+#include "RVersion.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_scheduler_init.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ROOT I/O of separate files and additions of separate histograms may
+// only run concurrently once ROOT has been made thread safe; with older
+// versions the inputs are read and summed one after the other
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,4,0)
+#define GLOBALHITSMERGE_PARALLEL 1
+#else
+#define GLOBALHITSMERGE_PARALLEL 0
+#endif
+
+namespace {
+
+  typedef globalhits::Histos Histos;
+
+  void usage(const char* name)
+  {
+    std::cerr << "usage: " << name
+	      << " [-j threads] [-f folder] [-l list] -o out.root"
+	      << " in1.root [in2.root ...]\n"
+	      << "  -j  number of threads (default: all cores)\n"
+	      << "  -f  name of the directory merged (default: GlobalHitsV)\n"
+	      << "  -l  file with one input file name per line\n"
+	      << "  -o  output file\n";
+  }
+
+  // f(0) to f(n-1), concurrently where ROOT allows it
+  template <class F>
+  void forEach(std::size_t n, const F& f)
+  {
+#if GLOBALHITSMERGE_PARALLEL
+    tbb::parallel_for(std::size_t(0), n, f);
+#else
+    for (std::size_t i = 0; i < n; ++i) f(i);
+#endif
+  }
+
+  // sum the histograms of one path over the files: slot i absorbs slot
+  // i+stride, level by level, so the order of the additions is fixed;
+  // false if TH1::Add refused a pair, whose slots are left in failed
+  bool reduce(std::vector<TH1*>& slots, std::size_t failed[2])
+  {
+    const std::size_t n = slots.size();
+    for (std::size_t stride = 1; stride < n; stride *= 2) {
+      const std::size_t pairs = (n + 2 * stride - 1) / (2 * stride);
+      std::vector<char> added(pairs, 1);
+      forEach(pairs, [&](std::size_t p) {
+	  const std::size_t i = 2 * stride * p;
+	  const std::size_t j = i + stride;
+	  if (j >= n || !slots[j]) return;
+	  if (!slots[i]) slots[i] = slots[j];
+	  else added[p] = slots[i]->Add(slots[j]);
+	});
+      for (std::size_t p = 0; p < pairs; ++p) {
+	if (added[p]) continue;
+	failed[0] = 2 * stride * p;
+	failed[1] = failed[0] + stride;
+	return false;
+      }
+    }
+    return true;
+  }
+
+  TDirectory* makeDirectory(TDirectory* top, const std::string& path)
+  {
+    TDirectory* dir = top;
+    std::string::size_type begin = 0, end;
+    while ((end = path.find('/', begin)) != std::string::npos) {
+      std::string name = path.substr(begin, end - begin);
+      TDirectory* sub = dir->GetDirectory(name.c_str());
+      if (!sub) sub = dir->mkdir(name.c_str());
+      dir = sub;
+      begin = end + 1;
+    }
+    return dir;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int threads = tbb::task_scheduler_init::automatic;
+  std::string folder = "GlobalHitsV";
+  std::string output;
+  std::vector<std::string> inputs;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if ((arg == "-j" || arg == "-f" || arg == "-l" || arg == "-o") &&
+	i + 1 >= argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    if (arg == "-j") {
+      threads = std::atoi(argv[++i]);
+    } else if (arg == "-f") {
+      folder = argv[++i];
+    } else if (arg == "-o") {
+      output = argv[++i];
+    } else if (arg == "-l") {
+      std::ifstream list(argv[++i]);
+      if (!list) {
+	std::cerr << "Unable to open input list " << argv[i] << "\n";
+	return 1;
+      }
+      std::string file;
+      while (list >> file) inputs.push_back(file);
+    } else if (arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      return 0;
+    } else {
+      inputs.push_back(arg);
+    }
+  }
+  if (output.empty() || inputs.empty() || threads == 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  tbb::task_scheduler_init init(threads);
+
+  // the histograms are owned here, not by the directory they come from
+  TH1::AddDirectory(kFALSE);
+
+  // read every input into its own map
+  std::vector<Histos> perFile(inputs.size());
+  std::vector<char> good(inputs.size(), 0);
+#if GLOBALHITSMERGE_PARALLEL
+  ROOT::EnableThreadSafety();
+#endif
+  forEach(inputs.size(), [&](std::size_t i) {
+      good[i] = globalhits::read(inputs[i], folder, perFile[i]);
+    });
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    if (!good[i]) {
+      std::cerr << "Unable to open input file " << inputs[i] << "\n";
+      return 1;
+    }
+  }
+
+  // one slot per file and path, empty where a file lacks the histogram
+  std::map<std::string, std::vector<TH1*> > slots;
+  for (std::size_t i = 0; i < perFile.size(); ++i) {
+    for (Histos::iterator iter = perFile[i].begin();
+	 iter != perFile[i].end(); ++iter) {
+      std::vector<TH1*>& s = slots[iter->first];
+      if (s.empty()) s.resize(inputs.size(), 0);
+      s[i] = iter->second.get();
+    }
+  }
+
+  // a histogram can only be summed over files that bin it the same way
+  for (std::map<std::string, std::vector<TH1*> >::iterator iter =
+	 slots.begin(); iter != slots.end(); ++iter) {
+    const std::vector<TH1*>& s = iter->second;
+    std::size_t first = 0;
+    while (!s[first]) ++first;
+    for (std::size_t i = first + 1; i < s.size(); ++i) {
+      if (s[i] && !globalhits::sameBinning(s[first], s[i])) {
+	std::cerr << "Inconsistent binning of " << iter->first << " in "
+		  << inputs[first] << " and " << inputs[i] << "\n";
+	return 1;
+      }
+    }
+  }
+
+  std::vector<const std::string*> paths;
+  std::vector<std::vector<TH1*>*> work;
+  for (std::map<std::string, std::vector<TH1*> >::iterator iter =
+	 slots.begin(); iter != slots.end(); ++iter) {
+    paths.push_back(&iter->first);
+    work.push_back(&iter->second);
+  }
+  std::vector<char> summed(work.size(), 1);
+  std::vector<std::size_t> failed(2 * work.size(), 0);
+  forEach(work.size(), [&](std::size_t k) {
+      summed[k] = reduce(*work[k], &failed[2 * k]);
+    });
+  for (std::size_t k = 0; k < work.size(); ++k) {
+    if (summed[k]) continue;
+    // slot i holds the sum of the files from i on at this point
+    std::cerr << "Unable to add " << *paths[k] << " of the files from "
+	      << inputs[failed[2 * k + 1]] << " on to the sum from "
+	      << inputs[failed[2 * k]] << " on\n";
+    return 1;
+  }
+
+  // write the sums in path order
+  std::unique_ptr<TFile> out(TFile::Open(output.c_str(), "RECREATE"));
+  if (!out || out->IsZombie()) {
+    std::cerr << "Unable to create output file " << output << "\n";
+    return 1;
+  }
+  for (std::map<std::string, std::vector<TH1*> >::iterator iter =
+	 slots.begin(); iter != slots.end(); ++iter) {
+    const std::string& path = iter->first;
+    TDirectory* dir = makeDirectory(out.get(), path);
+    dir->WriteTObject(iter->second[0], path.substr(path.rfind('/') + 1)
+		      .c_str());
+  }
+  const std::string uuid = out->GetUUID().AsString();
+  out->Close();
+
+  globalhits::Fingerprints prints;
+  for (std::map<std::string, std::vector<TH1*> >::iterator iter =
+	 slots.begin(); iter != slots.end(); ++iter)
+    prints[globalhits::relativePath(iter->first, folder)] =
+      globalhits::fingerprint(iter->second[0]);
+  if (!globalhits::writeFingerprints(output, uuid, prints))
+    std::cerr << "Unable to write fingerprints of " << output << "\n";
+
+  std::cout << "Merged " << slots.size() << " histograms of "
+	    << inputs.size() << " files into " << output << "\n";
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef GlobalHitsCaloCellCache_h
+#define GlobalHitsCaloCellCache_h
+
+/** \class GlobalHitsCaloCellCache
+ *
+ *  Table of the global position, eta and phi of every calorimeter cell of
+ *  a CaloGeometry. EB, EE and ES cells are stored densely by the hashed
+ *  index of their DetId, so looking up a PCaloHit is a single array load;
+ *  HCAL cells are kept sorted by raw DetId and found by binary search. The
+ *  table is only rebuilt when the cacheIdentifier of the CaloGeometryRecord
+ *  changes, replacing the getSubdetectorGeometry(id)->getGeometry(id) call
+ *  and the eta/phi computation made for every hit.
+ */
+
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "DataFormats/DetId/interface/DetId.h"
+
+#include <vector>
+
+class GlobalHitsCaloCellCache
+{
+
+ public:
+
+  struct Cell {
+    float pos[3];
+    float eta;
+    float phi;
+    bool valid;   // false for hashed indices without a cell
+  };
+
+  GlobalHitsCaloCellCache();
+
+  // rebuild the table from geom if cacheId differs from the one it was
+  // built with; returns true if the table was rebuilt
+  bool update(unsigned long long cacheId, const CaloGeometry& geom);
+  void clear();
+
+  // cached cell of id, or 0 if the geometry has no such cell
+  const Cell* cell(const DetId& id) const;
+
+  // number of cells in the table
+  unsigned int size() const { return nCells_; }
+
+ private:
+
+  void fillDense(const CaloGeometry& geom, int subdet,
+		 std::vector<Cell>& table, unsigned int tableSize);
+
+  unsigned long long cacheId_;
+  unsigned int nCells_;
+
+  // ECAL cells indexed by hashedIndex
+  std::vector<Cell> eb_;
+  std::vector<Cell> ee_;
+  std::vector<Cell> es_;
+
+  // sorted raw HCAL DetIds and the cells in the same order
+  std::vector<unsigned int> hcalIds_;
+  std::vector<Cell> hcal_;
+
+}; // end class declaration
+
+#endif
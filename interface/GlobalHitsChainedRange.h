@@ -0,0 +1,136 @@
+#ifndef GlobalHitsChainedRange_h
+#define GlobalHitsChainedRange_h
+
+/** \class GlobalHitsChainedRange
+ *
+ *  Non-owning view that iterates over several hit containers (e.g. the
+ *  LowTof and HighTof PSimHit collections) one after the other, in the
+ *  order they were added. It replaces building a merged copy of the
+ *  collections every event; the containers must outlive the range. The
+ *  iterator moves on by n elements (+=) in a step per container, for the
+ *  sampled fill loops.
+ */
+
+#include <cstddef>
+#include <iterator>
+
+template <class C, unsigned int N = 4>
+class GlobalHitsChainedRange
+{
+
+ public:
+
+  typedef typename C::value_type value_type;
+
+  class const_iterator
+  {
+
+   public:
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename C::value_type value_type;
+    typedef typename C::const_iterator::difference_type difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    const_iterator() : range_(0), seg_(0) {}
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &(*it_); }
+
+    const_iterator& operator++()
+    {
+      ++it_;
+      if (it_ == range_->parts_[seg_]->end()) {
+	++seg_;
+	skipEmpty();
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    // move n elements on, jumping within each container
+    const_iterator& operator+=(difference_type n)
+    {
+      while (n > 0 && seg_ < range_->nParts_) {
+	const difference_type left = range_->parts_[seg_]->end() - it_;
+	if (n < left) {
+	  it_ += n;
+	  return *this;
+	}
+	n -= left;
+	++seg_;
+	skipEmpty();
+      }
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const
+    {
+      if (seg_ != other.seg_) return false;
+      if (seg_ == range_->nParts_) return true;
+      return it_ == other.it_;
+    }
+
+    bool operator!=(const const_iterator& other) const
+    { return !(*this == other); }
+
+   private:
+
+    friend class GlobalHitsChainedRange;
+
+    const_iterator(const GlobalHitsChainedRange* range, unsigned int seg)
+      : range_(range), seg_(seg)
+    { skipEmpty(); }
+
+    // move to the first element of the next non-empty part
+    void skipEmpty()
+    {
+      while (seg_ < range_->nParts_ && range_->parts_[seg_]->empty()) ++seg_;
+      if (seg_ < range_->nParts_) it_ = range_->parts_[seg_]->begin();
+    }
+
+    const GlobalHitsChainedRange* range_;
+    unsigned int seg_;
+    typename C::const_iterator it_;
+
+  }; // end iterator declaration
+
+  GlobalHitsChainedRange() : nParts_(0) {}
+
+  // append a container to the view; returns false if the view is full
+  bool add(const C& part)
+  {
+    if (nParts_ == N) return false;
+    parts_[nParts_++] = &part;
+    return true;
+  }
+
+  void clear() { nParts_ = 0; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, nParts_); }
+
+  std::size_t size() const
+  {
+    std::size_t n = 0;
+    for (unsigned int i = 0; i < nParts_; ++i) n += parts_[i]->size();
+    return n;
+  }
+
+  bool empty() const { return size() == 0; }
+
+ private:
+
+  const C* parts_[N];
+  unsigned int nParts_;
+
+}; // end class declaration
+
+#endif
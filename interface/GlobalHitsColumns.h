@@ -0,0 +1,174 @@
+#ifndef GlobalHitsColumns_h
+#define GlobalHitsColumns_h
+
+/** \class GlobalHitsColumns
+ *
+ *  Structure-of-arrays staging buffer for the sim hits of one event, one
+ *  set of columns per PGlobalSimHit hit block. Clearing keeps the column
+ *  capacity, so once a stream has seen a typical event the fill functions
+ *  no longer allocate. The columnar layout stops at the product boundary:
+ *  the columns are passed to the PGlobalSimHit put* methods, which still
+ *  repack them into one struct per hit.
+ *
+ *  Each fill loop calls reserve() with the number of hits it stages, the
+ *  size of its input collections unless they are sampled, first, so a block grows at most once per event instead of reallocating
+ *  hit by hit. The largest reservation of every block is kept as its
+ *  high-water mark for the end of stream summary.
+ *
+ *  The fill loops only stage the global x/y/z of each hit; computeEtaPhi
+ *  then derives the pos, phi and eta columns of the whole block in one
+ *  GlobalHitsKinematics batch. PSimHit blocks stage the local position
+ *  and the cached frame index of each hit instead (addLocal), and the
+ *  whole block is turned into global coordinates by the batched
+ *  GlobalHitsGeometryCache::toGlobal before computeEtaPhi. Calorimeter
+ *  blocks take phi and eta straight from the GlobalHitsCaloCellCache
+ *  (addCell) and need no computeEtaPhi.
+ *
+ *  With a GlobalHitsSampler set, the fill loops only stage a random subset
+ *  of the input hits of each block and the weight of the columns says how
+ *  many hits every staged one stands for; it is 1 otherwise.
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsKinematics.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+class GlobalHitsSampler;
+
+class GlobalHitsColumns
+{
+
+ public:
+
+  typedef std::vector<float> FloatVector;
+
+  // hit blocks in the order they appear in PGlobalSimHit
+  enum Block { PxlBrl = 0, PxlFwd, SiBrl, SiFwd,
+	       MuonCsc, MuonDt, MuonRpcBrl, MuonRpcFwd,
+	       ECal, PreSh, HCal, nBlocks };
+
+  struct Columns {
+    FloatVector e;    // calorimeter blocks only
+    FloatVector tof;
+    FloatVector pos;  // R (barrel) or Z (forward), PSimHit blocks only
+    FloatVector phi;
+    FloatVector eta;
+    FloatVector x, y, z;  // global position staged by the fill loop
+    std::vector<int> det; // frame index of each hit, PSimHit blocks only
+    float weight;         // hits each staged hit stands for
+
+    Columns() : weight(1.f) {}
+
+    unsigned int size() const { return tof.size(); }
+    void clear()
+    { e.clear(); tof.clear(); pos.clear(); phi.clear(); eta.clear();
+      x.clear(); y.clear(); z.clear(); det.clear(); weight = 1.f; }
+
+    void addPosition(float gx, float gy, float gz)
+    { x.push_back(gx); y.push_back(gy); z.push_back(gz); }
+
+    // phi and eta of a calorimeter hit, taken from the cached cell
+    void addCell(float cellPhi, float cellEta)
+    { phi.push_back(cellPhi); eta.push_back(cellEta); }
+
+    // stage a local position in x/y/z until the block is transformed
+    void addLocal(int theDet, float lx, float ly, float lz)
+    { det.push_back(theDet); addPosition(lx, ly, lz); }
+  };
+
+  GlobalHitsColumns() : sampler_(0)
+  { std::fill(highWater_, highWater_ + nBlocks, 0); }
+
+  // sampler of the staged blocks, or 0 to keep every hit
+  void setSampler(const GlobalHitsSampler* sampler) { sampler_ = sampler; }
+  const GlobalHitsSampler* sampler() const { return sampler_; }
+
+  Columns& operator[](Block b) { return blocks_[b]; }
+  const Columns& operator[](Block b) const { return blocks_[b]; }
+
+  // true for the PCaloHit blocks, which fill e instead of pos
+  static bool isCalo(Block b) { return b >= ECal; }
+
+  // true for the PSimHit blocks whose pos column is Z rather than R
+  static bool isForward(Block b)
+  { return b == PxlFwd || b == SiFwd || b == MuonCsc || b == MuonRpcFwd; }
+
+  static const char* name(Block b)
+  {
+    static const char* const names[nBlocks] = 
+      { "PxlBrl", "PxlFwd", "SiBrl", "SiFwd",
+	"MuonCsc", "MuonDt", "MuonRpcBrl", "MuonRpcFwd",
+	"ECal", "PreSh", "HCal" };
+    return names[b];
+  }
+
+  // make room for n hits in the columns block b fills
+  void reserve(Block b, std::size_t n)
+  {
+    Columns& c = blocks_[b];
+    if (isCalo(b)) {
+      c.e.reserve(n);
+    } else {
+      c.pos.reserve(n);
+      c.det.reserve(n);
+      c.x.reserve(n);
+      c.y.reserve(n);
+      c.z.reserve(n);
+    }
+    c.tof.reserve(n);
+    c.phi.reserve(n);
+    c.eta.reserve(n);
+    highWater_[b] = std::max(highWater_[b], n);
+  }
+
+  // largest number of hits reserved for block b so far
+  std::size_t highWater(Block b) const { return highWater_[b]; }
+
+  // memory currently held by all columns, in bytes
+  std::size_t capacityBytes() const
+  {
+    std::size_t n = 0;
+    for (int b = 0; b < nBlocks; ++b) {
+      const Columns& c = blocks_[b];
+      n += c.e.capacity() + c.tof.capacity() + c.pos.capacity() +
+	c.phi.capacity() + c.eta.capacity() +
+	c.x.capacity() + c.y.capacity() + c.z.capacity() +
+	c.det.capacity() * sizeof(int) / sizeof(float);
+    }
+    return n * sizeof(float);
+  }
+
+  // fill the pos, phi and eta columns of block b from its staged
+  // positions in one batch
+  void computeEtaPhi(Block b)
+  {
+    Columns& c = blocks_[b];
+    const std::size_t n = c.x.size();
+    float* perp = 0;
+    if (!isCalo(b)) {
+      if (isForward(b)) {
+	c.pos.assign(c.z.begin(), c.z.end());
+      } else {
+	c.pos.resize(n);
+	perp = c.pos.data();
+      }
+    }
+    c.phi.resize(n);
+    c.eta.resize(n);
+    GlobalHitsKinematics::compute(n, c.x.data(), c.y.data(), c.z.data(),
+				  perp, c.phi.data(), c.eta.data());
+  }
+
+  void clear() { for (int b = 0; b < nBlocks; ++b) blocks_[b].clear(); }
+
+ private:
+
+  Columns blocks_[nBlocks];
+  std::size_t highWater_[nBlocks];
+  const GlobalHitsSampler* sampler_;
+
+}; // end class declaration
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef GlobalHitsCompactHits_h
+#define GlobalHitsCompactHits_h
+
+/** \class GlobalHitsCompactHits
+ *
+ *  Reduced precision form of PGlobalSimHit, written by GlobalHitsProducer
+ *  instead of it with CompactOutput = true. The G4 vertices and tracks are
+ *  kept as floats; every hit of the eleven hit blocks is stored as four
+ *  16 bit fixed point codes (ToF, R or Z or E, phi, eta) instead of four
+ *  floats, which halves the bytes of the hit blocks before compression.
+ *  It has the put methods of PGlobalSimHit, and unpack() turns it back
+ *  into one for GlobalHitsHistogrammer.
+ *
+ *  The range of each quantity of a block is the widest axis the
+ *  GlobalHitsProdHist histograms of that quantity book, e.g. ToF in
+ *  [0,250) ns and Z in [-1500,1500) cm for the CSC hits. Codes 1 to 65534
+ *  divide the range into equal steps and decode to the step center, so
+ *  a value in range comes back within half a step:
+ *
+ *    ToF   PxlBrl 3e-4, PxlFwd, SiBrl 4e-4, SiFwd 6e-4, muon 2e-3,
+ *          calorimeters 8e-3 ns
+ *    R/Z   PxlBrl 4e-4, PxlFwd 2e-3, SiBrl 2e-3, SiFwd 5e-3,
+ *          muon 1.2e-2 (DT, RPC barrel R) or 2.3e-2 cm (CSC, RPC forward Z)
+ *    E     8e-5 GeV
+ *    phi   5e-5, eta 5e-5 (tracker, muon) or 8e-5 (calorimeters)
+ *
+ *  which is well below the bin width of every histogram filled from
+ *  them. Values below or above the range (and NaN, as below) are coded
+ *  0 and 65535 and decode to just outside it, so they still fall into
+ *  the under- or overflow of the histograms, but lose their value.
+ */
+
+#include "SimDataFormats/ValidationFormats/interface/PValidationFormats.h"
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+
+#include <vector>
+
+class GlobalHitsCompactHits
+{
+
+ public:
+
+  typedef std::vector<float> FloatVector;
+  typedef std::vector<unsigned short> CodeVector;
+
+  // the quantities of a hit; Pos is R or Z, or E for the calorimeters
+  enum Quantity { ToF = 0, Pos, Phi, Eta, nQuantities };
+
+  struct Range {
+    float lo;
+    float hi;
+  };
+
+  // the codes of one hit block
+  struct Hits {
+    std::vector<unsigned short> tof;
+    std::vector<unsigned short> pos;
+    std::vector<unsigned short> phi;
+    std::vector<unsigned short> eta;
+  };
+
+  static const unsigned short underflow = 0;
+  static const unsigned short overflow = 0xffff;
+
+  GlobalHitsCompactHits();
+
+  static Range range(GlobalHitsColumns::Block b, Quantity q);
+
+  static unsigned short encode(float x, const Range& r)
+  {
+    if (!(x >= r.lo)) return underflow;
+    if (!(x < r.hi)) return overflow;
+    const unsigned int steps = overflow - 1;
+    const unsigned int code =
+      1 + (unsigned int)((double(x) - r.lo) / (double(r.hi) - r.lo) * steps);
+    // rounding of x just below hi
+    return code > steps ? steps : code;
+  }
+
+  static float decode(unsigned short code, const Range& r)
+  {
+    const double step = (double(r.hi) - r.lo) / (overflow - 1);
+    if (code == underflow) return r.lo - step;
+    if (code == overflow) return r.hi + step;
+    return r.lo + (code - 0.5) * step;
+  }
+
+  // same as PGlobalSimHit
+  void putRawGenPart(int n) { nRawGenPart_ = n; }
+  void putG4Vtx(const FloatVector& x, const FloatVector& y,
+		const FloatVector& z)
+  { g4VtxX_ = x; g4VtxY_ = y; g4VtxZ_ = z; }
+  void putG4Trk(const FloatVector& pt, const FloatVector& e)
+  { g4TrkPt_ = pt; g4TrkE_ = e; }
+
+  void putECalHits(const FloatVector& e, const FloatVector& tof,
+		   const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::ECal, tof, e, phi, eta); }
+  void putPreShHits(const FloatVector& e, const FloatVector& tof,
+		    const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::PreSh, tof, e, phi, eta); }
+  void putHCalHits(const FloatVector& e, const FloatVector& tof,
+		   const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::HCal, tof, e, phi, eta); }
+
+  void putPxlBrlHits(const FloatVector& tof, const FloatVector& r,
+		     const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::PxlBrl, tof, r, phi, eta); }
+  void putPxlFwdHits(const FloatVector& tof, const FloatVector& z,
+		     const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::PxlFwd, tof, z, phi, eta); }
+  void putSiBrlHits(const FloatVector& tof, const FloatVector& r,
+		    const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::SiBrl, tof, r, phi, eta); }
+  void putSiFwdHits(const FloatVector& tof, const FloatVector& z,
+		    const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::SiFwd, tof, z, phi, eta); }
+
+  void putMuonCscHits(const FloatVector& tof, const FloatVector& z,
+		      const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::MuonCsc, tof, z, phi, eta); }
+  void putMuonDtHits(const FloatVector& tof, const FloatVector& r,
+		     const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::MuonDt, tof, r, phi, eta); }
+  void putMuonRpcFwdHits(const FloatVector& tof, const FloatVector& z,
+			 const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::MuonRpcFwd, tof, z, phi, eta); }
+  void putMuonRpcBrlHits(const FloatVector& tof, const FloatVector& r,
+			 const FloatVector& phi, const FloatVector& eta)
+  { put(GlobalHitsColumns::MuonRpcBrl, tof, r, phi, eta); }
+
+  int getnRawGenPart() const { return nRawGenPart_; }
+  unsigned int getnHits(GlobalHitsColumns::Block b) const
+  { return hits_[b].tof.size(); }
+  const Hits& getHits(GlobalHitsColumns::Block b) const { return hits_[b]; }
+
+  // decode everything into product
+  void unpack(PGlobalSimHit& product) const;
+
+ private:
+
+  void put(GlobalHitsColumns::Block b, const FloatVector& tof,
+	   const FloatVector& pos, const FloatVector& phi,
+	   const FloatVector& eta);
+
+  // decoded quantity q of block b
+  void get(GlobalHitsColumns::Block b, Quantity q, FloatVector& out) const;
+
+  int nRawGenPart_;
+  std::vector<float> g4VtxX_;
+  std::vector<float> g4VtxY_;
+  std::vector<float> g4VtxZ_;
+  std::vector<float> g4TrkPt_;
+  std::vector<float> g4TrkE_;
+  std::vector<Hits> hits_;   // one per GlobalHitsColumns::Block
+
+}; // end class declaration
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef GlobalHitsDiagnostics_h
+#define GlobalHitsDiagnostics_h
+
+/** \class GlobalHitsDiagnostics
+ *
+ *  Gate for the per event output of the fill and store functions of the
+ *  GlobalHits modules. The levels follow Verbosity: gather() is the
+ *  "Gathering info" summary of a fill function (1), counts() adds the
+ *  number of objects collected (2) and dump() lists every stored hit (3).
+ *
+ *  The output is only compiled in when GLOBALHITS_DEBUG is defined, which
+ *  the debug builds with EDM_ML_DEBUG do as well; otherwise every level is
+ *  a compile time false and no message is ever formatted. Within a debug
+ *  build the levels are fixed from Verbosity once, when the module is
+ *  constructed.
+ *
+ *  A Message is the text of one fill or store function. It only allocates
+ *  and formats anything if it was created active, and log() hands it to
+ *  edm::LogInfo in one piece.
+ */
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#if defined(EDM_ML_DEBUG) && !defined(GLOBALHITS_DEBUG)
+#define GLOBALHITS_DEBUG
+#endif
+
+class GlobalHitsDiagnostics
+{
+
+ public:
+
+#ifdef GLOBALHITS_DEBUG
+  static constexpr bool compiled = true;
+#else
+  static constexpr bool compiled = false;
+#endif
+
+  explicit GlobalHitsDiagnostics(int verbosity = 0) :
+    level_(compiled ? verbosity : 0) {}
+
+  bool gather() const { return compiled && level_ > 0; }
+  bool counts() const { return compiled && level_ > 1; }
+  bool dump() const { return compiled && level_ > 2; }
+
+  class Message
+  {
+   public:
+    Message(bool active, const char* head) :
+      out_(active ? new std::ostringstream : 0)
+    {
+      if (out_) *out_ << head;
+    }
+
+    bool active() const { return out_.get() != 0; }
+
+    template <class T>
+    Message& operator<<(const T& value)
+    {
+      if (out_) *out_ << value;
+      return *this;
+    }
+
+    void log(const std::string& category) const
+    {
+      if (out_) edm::LogInfo(category) << out_->str() << "\n";
+    }
+
+   private:
+    std::unique_ptr<std::ostringstream> out_;
+  };
+
+ private:
+
+  int level_;
+
+}; // end class declaration
+
+#endif
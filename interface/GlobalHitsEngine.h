@@ -0,0 +1,341 @@
+#ifndef GlobalHitsEngine_h
+#define GlobalHitsEngine_h
+
+/** \class GlobalHitsEngine
+ *
+ *  Hit extraction shared by GlobalHitsProducer, GlobalHitsAnalyzer and
+ *  GlobalHitsProdHist. fillSimHits and fillCaloHits run the hit loop of
+ *  one subdetector, described at compile time by a GlobalHitsTraits type,
+ *  into the GlobalHitsColumns of its block(s), and then hand every block to
+ *  a sink policy:
+ *    GlobalHitsColumnSink       keeps the columns for the PGlobalSimHit
+ *    GlobalHitsHistSink<Hist>   fills the columns into lock-free per stream
+ *                               counters of histograms, with Hist =
+ *                               MonitorElement, TH1F or GlobalHitsHist1D
+ *  Each loop is compiled once per subdetector and sink, without virtual
+ *  calls, and histogram pointers are checked once per block rather than
+ *  once per hit.
+ *
+ *  If the columns have a GlobalHitsSampler, the hit loop only visits the
+ *  random subset of the input hits its GlobalHitsSampler::Selection
+ *  picks, jumping over the others, and only those are checked, looked up
+ *  and staged. The returned number of hits collected is then estimated
+ *  from the sample; it is exact whenever none of the sampled hits is of
+ *  the wrong detector or without geometry (the hits left out are not
+ *  checked, so neither are they warned about).
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+#include "Validation/GlobalHits/interface/GlobalHitsGeometryCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCaloCellCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsHistShard.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSampler.h"
+#include "DataFormats/DetId/interface/DetId.h"
+#include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
+#include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
+#include "DataFormats/MuonDetId/interface/MuonSubdetId.h"
+#include "DataFormats/MuonDetId/interface/DTWireId.h"
+#include "DataFormats/MuonDetId/interface/RPCDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "DataFormats/HcalDetId/interface/HcalSubdetector.h"
+#include "SimDataFormats/TrackingHit/interface/PSimHit.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// subdetector description: hits with det() == Det and a subdetId() whose
+// bit is set in SubMask belong to block B
+template <GlobalHitsColumns::Block B, int Det, unsigned int SubMask>
+struct GlobalHitsTraits
+{
+  static const GlobalHitsColumns::Block firstBlock = B;
+  static const GlobalHitsColumns::Block lastBlock = B;
+
+  // block of the hit with DetId id, or -1 if it is not of this subdetector
+  static int block(const DetId& id)
+  {
+    return (id.det() == Det && ((SubMask >> id.subdetId()) & 1)) ? B : -1;
+  }
+
+  // raw DetId of the geometry frame of a PSimHit
+  static unsigned int frameId(const PSimHit& hit) { return hit.detUnitId(); }
+};
+
+// the subdetectors of PGlobalSimHit
+struct GlobalHitsSubdets
+{
+  typedef GlobalHitsTraits<GlobalHitsColumns::PxlBrl, DetId::Tracker,
+			   (1u << PixelSubdetector::PixelBarrel)> PxlBrl;
+  typedef GlobalHitsTraits<GlobalHitsColumns::PxlFwd, DetId::Tracker,
+			   (1u << PixelSubdetector::PixelEndcap)> PxlFwd;
+  typedef GlobalHitsTraits<GlobalHitsColumns::SiBrl, DetId::Tracker,
+			   (1u << StripSubdetector::TIB) |
+			   (1u << StripSubdetector::TOB)> SiBrl;
+  typedef GlobalHitsTraits<GlobalHitsColumns::SiFwd, DetId::Tracker,
+			   (1u << StripSubdetector::TID) |
+			   (1u << StripSubdetector::TEC)> SiFwd;
+  typedef GlobalHitsTraits<GlobalHitsColumns::MuonCsc, DetId::Muon,
+			   (1u << MuonSubdetId::CSC)> MuonCsc;
+
+  // DT hits carry a wire id; the frame is the one of its layer
+  struct MuonDt : GlobalHitsTraits<GlobalHitsColumns::MuonDt, DetId::Muon,
+				   (1u << MuonSubdetId::DT)>
+  {
+    static unsigned int frameId(const PSimHit& hit)
+    { return DTWireId(hit.detUnitId()).layerId().rawId(); }
+  };
+
+  // RPC hits are split into the barrel and forward blocks by region
+  struct MuonRpc : GlobalHitsTraits<GlobalHitsColumns::MuonRpcBrl,
+				    DetId::Muon, (1u << MuonSubdetId::RPC)>
+  {
+    static const GlobalHitsColumns::Block lastBlock =
+      GlobalHitsColumns::MuonRpcFwd;
+
+    static int block(const DetId& id)
+    {
+      if (id.det() != DetId::Muon || id.subdetId() != MuonSubdetId::RPC)
+	return -1;
+      const int region = RPCDetId(id.rawId()).region();
+      if (region == 0) return GlobalHitsColumns::MuonRpcBrl;
+      if (region == 1 || region == -1) return GlobalHitsColumns::MuonRpcFwd;
+      return -1;
+    }
+  };
+
+  typedef GlobalHitsTraits<GlobalHitsColumns::ECal, DetId::Ecal,
+			   (1u << EcalBarrel) | (1u << EcalEndcap)> ECal;
+  typedef GlobalHitsTraits<GlobalHitsColumns::PreSh, DetId::Ecal,
+			   (1u << EcalPreshower)> PreSh;
+  typedef GlobalHitsTraits<GlobalHitsColumns::HCal, DetId::Hcal,
+			   (1u << HcalBarrel) | (1u << HcalEndcap) |
+			   (1u << HcalOuter) | (1u << HcalForward)> HCal;
+};
+
+// sink policy of the Producer: the columns are the product as they are
+struct GlobalHitsColumnSink
+{
+  void drain(GlobalHitsColumns::Block,
+	     const GlobalHitsColumns::Columns&) const {}
+};
+
+// sink policy filling the columns of every block into GlobalHitsHist1D
+// counters: a GlobalHitsHist1D histogram is filled in place, a TH1F or
+// MonitorElement through a per stream GlobalHitsHistShard that flush()
+// adds into it. Any of the histogram pointers may be 0. The hits are
+// filled with the weight of their columns
+template <class Hist>
+class GlobalHitsHistSink
+{
+
+ public:
+
+  GlobalHitsHistSink() { clear(); }
+
+  // the histograms of block b; e is only filled for calorimeter blocks
+  // and pos only for PSimHit blocks
+  void route(GlobalHitsColumns::Block b, Hist* e0, Hist* e1,
+	     Hist* tof0, Hist* tof1, Hist* pos, Hist* phi, Hist* eta)
+  {
+    Targets& t = targets_[b];
+    t.e[0] = counter(e0); t.e[1] = counter(e1);
+    t.tof[0] = counter(tof0); t.tof[1] = counter(tof1);
+    t.pos = counter(pos); t.phi = counter(phi); t.eta = counter(eta);
+  }
+
+  // forget all routes and shards, e.g. before the histograms are rebooked
+  void clear()
+  {
+    shards_.clear();
+    for (int b = 0; b < GlobalHitsColumns::nBlocks; ++b) {
+      Targets& t = targets_[b];
+      t.e[0] = t.e[1] = t.tof[0] = t.tof[1] = 0;
+      t.pos = t.phi = t.eta = 0;
+    }
+  }
+
+  void drain(GlobalHitsColumns::Block b,
+	     const GlobalHitsColumns::Columns& c) const
+  {
+    const Targets& t = targets_[b];
+    fill(t.e[0], c.e, c.weight);
+    fill(t.e[1], c.e, c.weight);
+    fill(t.tof[0], c.tof, c.weight);
+    fill(t.tof[1], c.tof, c.weight);
+    fill(t.pos, c.pos, c.weight);
+    fill(t.phi, c.phi, c.weight);
+    fill(t.eta, c.eta, c.weight);
+  }
+
+  // add the shards into their histograms; nothing to do for
+  // GlobalHitsHist1D histograms
+  void flush()
+  {
+    for (unsigned int i = 0; i < shards_.size(); ++i) shards_[i]->flush();
+  }
+
+ private:
+
+  struct Targets {
+    GlobalHitsHist1D* e[2];
+    GlobalHitsHist1D* tof[2];
+    GlobalHitsHist1D* pos;
+    GlobalHitsHist1D* phi;
+    GlobalHitsHist1D* eta;
+  };
+
+  // the counters filled for h. Histograms shared between blocks (e.g. phi
+  // and eta of the barrel and forward pixels) share one shard, so they
+  // accumulate in fill order
+  GlobalHitsHist1D* counter(GlobalHitsHist1D* h) { return h; }
+  template <class H> GlobalHitsHist1D* counter(H* h)
+  {
+    if (!h) return 0;
+    TH1* target = rootHist(h);
+    for (unsigned int i = 0; i < shards_.size(); ++i)
+      if (shards_[i]->target() == target) return &shards_[i]->counts();
+    shards_.push_back(std::unique_ptr<GlobalHitsHistShard>
+		      (new GlobalHitsHistShard(target)));
+    return &shards_.back()->counts();
+  }
+
+  static void fill(GlobalHitsHist1D* h,
+		   const GlobalHitsColumns::FloatVector& v, float w)
+  {
+    if (h && !v.empty()) h->fill(v.data(), v.size(), w);
+  }
+
+  Targets targets_[GlobalHitsColumns::nBlocks];
+  std::vector<std::unique_ptr<GlobalHitsHistShard> > shards_;
+
+}; // end class declaration
+
+class GlobalHitsEngine
+{
+
+ public:
+
+  // stage the PSimHits of one subdetector in its blocks, transform them to
+  // global coordinates with cache, derive R/Z, phi and eta and drain the
+  // blocks into sink; returns the number of hits collected
+  template <class Traits, class Range, class Sink>
+  static int fillSimHits(const Range& hits, GlobalHitsGeometryCache& cache,
+			 GlobalHitsColumns& cols, const Sink& sink,
+			 const std::string& cat)
+  {
+    GlobalHitsSampler::Selection pick(cols.sampler(), Traits::firstBlock,
+				      hits.size());
+    for (int b = Traits::firstBlock; b <= Traits::lastBlock; ++b) {
+      cols.reserve(GlobalHitsColumns::Block(b), pick.kept());
+      cols[GlobalHitsColumns::Block(b)].weight = pick.weight();
+    }
+
+    int i = 0;
+    unsigned int rejected = 0;
+    typename Range::const_iterator itHit = hits.begin();
+    for (unsigned int k = 0; k < pick.kept(); ++k, ++itHit) {
+
+      // jump to the next picked hit; 0 without sampling
+      const unsigned int skip = pick.next();
+      if (skip) itHit += skip;
+      i += skip + 1;
+
+      // check that expected detector is returned
+      const DetId theDetUnitId(itHit->detUnitId());
+      const int b = Traits::block(theDetUnitId);
+      if (b < 0) {
+	wrongDetector(cat, Traits::firstBlock, i, theDetUnitId);
+	++rejected;
+	continue;
+      }
+
+      // get the cached frame of the DetUnit
+      const int theDet = cache.index(Traits::frameId(*itHit));
+      if (theDet < 0) {
+	missingGeometry(cat, GlobalHitsColumns::Block(b), i);
+	++rejected;
+	continue;
+      }
+
+      // staged in local coordinates, transformed per block below
+      const LocalPoint localposition = itHit->localPosition();
+      GlobalHitsColumns::Columns& c = cols[GlobalHitsColumns::Block(b)];
+      c.tof.push_back(itHit->tof());
+      c.addLocal(theDet, localposition.x(), localposition.y(),
+		 localposition.z());
+    }
+
+    for (int b = Traits::firstBlock; b <= Traits::lastBlock; ++b) {
+      GlobalHitsColumns::Columns& c = cols[GlobalHitsColumns::Block(b)];
+      cache.toGlobal(c.det, c.x, c.y, c.z);
+      cols.computeEtaPhi(GlobalHitsColumns::Block(b));
+      sink.drain(GlobalHitsColumns::Block(b), c);
+    }
+
+    return pick.passed(rejected);
+  }
+
+  // stage the PCaloHits of one subdetector with the phi and eta of their
+  // cached cells and drain the block into sink; returns the number of hits
+  // collected
+  template <class Traits, class Range, class Sink>
+  static int fillCaloHits(const Range& hits,
+			  const GlobalHitsCaloCellCache& cells,
+			  GlobalHitsColumns& cols, const Sink& sink,
+			  const std::string& cat)
+  {
+    const GlobalHitsColumns::Block b = Traits::firstBlock;
+    GlobalHitsSampler::Selection pick(cols.sampler(), b, hits.size());
+    cols.reserve(b, pick.kept());
+    GlobalHitsColumns::Columns& c = cols[b];
+    c.weight = pick.weight();
+
+    int i = 0;
+    unsigned int rejected = 0;
+    typename Range::const_iterator itHit = hits.begin();
+    for (unsigned int k = 0; k < pick.kept(); ++k, ++itHit) {
+
+      // jump to the next picked hit; 0 without sampling
+      const unsigned int skip = pick.next();
+      if (skip) itHit += skip;
+      i += skip + 1;
+
+      // check that expected detector is returned
+      const DetId theDetUnitId(itHit->id());
+      if (Traits::block(theDetUnitId) < 0) {
+	wrongDetector(cat, b, i, theDetUnitId);
+	++rejected;
+	continue;
+      }
+
+      // get the cached cell
+      const GlobalHitsCaloCellCache::Cell *theCell =
+	cells.cell(theDetUnitId);
+      if (!theCell) {
+	missingGeometry(cat, b, i);
+	++rejected;
+	continue;
+      }
+
+      c.e.push_back(itHit->energy());
+      c.tof.push_back(itHit->time());
+      c.addCell(theCell->phi, theCell->eta);
+    }
+
+    sink.drain(b, c);
+
+    return pick.passed(rejected);
+  }
+
+ private:
+
+  // warnings, kept out of line of the hit loops
+  static void wrongDetector(const std::string& cat, GlobalHitsColumns::Block b,
+			    int hit, const DetId& id);
+  static void missingGeometry(const std::string& cat,
+			      GlobalHitsColumns::Block b, int hit);
+
+}; // end class declaration
+
+#endif
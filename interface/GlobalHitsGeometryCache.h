@@ -0,0 +1,81 @@
+#ifndef GlobalHitsGeometryCache_h
+#define GlobalHitsGeometryCache_h
+
+/** \class GlobalHitsGeometryCache
+ *
+ *  Flat table of the local to global frames of every DetUnit of a
+ *  TrackingGeometry, keyed by raw DetId. The table is only rebuilt when the
+ *  cacheIdentifier of the geometry record changes, so that the per hit cost
+ *  is a lookup plus a 3x3 matrix-vector product instead of an idToDetUnit
+ *  call and a BoundPlane::toGlobal for every PSimHit.
+ *
+ *  The batched toGlobal transforms a whole block of staged local positions
+ *  at once: the hits are grouped by frame, each frame is loaded once and
+ *  its group is transformed in a plain loop over float arrays, and the
+ *  results are written back in the original hit order. The grouping
+ *  scratch space is kept in the cache, so a cache must not be shared by
+ *  concurrently running fill functions.
+ */
+
+#include "Geometry/CommonDetUnit/interface/TrackingGeometry.h"
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+#include "DataFormats/GeometryVector/interface/LocalPoint.h"
+
+#include <cstddef>
+#include <vector>
+
+class GlobalHitsGeometryCache
+{
+
+ public:
+
+  // global = rot * local + pos, with rot stored row-major
+  struct Frame {
+    float rot[9];
+    float pos[3];
+  };
+
+  GlobalHitsGeometryCache();
+
+  // rebuild the table from geom if cacheId differs from the one it was
+  // built with; returns true if the table was rebuilt
+  bool update(unsigned long long cacheId, const TrackingGeometry& geom);
+  void clear();
+
+  // position of rawId in the frame table, or -1 if it is not a DetUnit
+  int index(unsigned int rawId) const;
+
+  const Frame& frame(int idx) const { return frames_[idx]; }
+  unsigned int size() const { return ids_.size(); }
+
+  GlobalPoint toGlobal(int idx, const LocalPoint& lp) const
+  {
+    const Frame& f = frames_[idx];
+    return GlobalPoint(f.rot[0]*lp.x() + f.rot[1]*lp.y() + f.rot[2]*lp.z()
+		       + f.pos[0],
+		       f.rot[3]*lp.x() + f.rot[4]*lp.y() + f.rot[5]*lp.z()
+		       + f.pos[1],
+		       f.rot[6]*lp.x() + f.rot[7]*lp.y() + f.rot[8]*lp.z()
+		       + f.pos[2]);
+  }
+
+  // replace the local x/y/z of every hit by its global position; det holds
+  // the frame index of each hit as returned by index() and must be >= 0
+  void toGlobal(const std::vector<int>& det, std::vector<float>& x,
+		std::vector<float>& y, std::vector<float>& z);
+
+ private:
+
+  unsigned long long cacheId_;
+
+  // sorted raw DetIds and the frames in the same order
+  std::vector<unsigned int> ids_;
+  std::vector<Frame> frames_;
+
+  // scratch space of the batched toGlobal, reused from event to event
+  std::vector<unsigned int> order_;
+  std::vector<float> lx_, ly_, lz_, gx_, gy_, gz_;
+
+}; // end class declaration
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef GlobalHitsHist1D_h
+#define GlobalHitsHist1D_h
+
+/** \class GlobalHitsHist1D
+ *
+ *  Fixed binning histogram used as the run product of GlobalHitsProdHist:
+ *  a plain Header with the binning and the TH1 fill statistics, a
+ *  contiguous array of bin contents including under- and overflow, and
+ *  the names needed to rebuild the TH1F. It is not registered with
+ *  gDirectory and carries no ROOT attribute state, so filling it is a
+ *  bin lookup and an increment and a run writes a fraction of the bytes
+ *  of a TH1F. toTH1F/addTo convert it for the stripper or any other
+ *  consumer that needs a ROOT histogram.
+ *
+ *  fill keeps exactly the bookkeeping of TH1::Fill(x) with unit weight,
+ *  so the converted histogram is identical to one filled directly. The
+ *  bulk fill also takes the weight of GlobalHitsSampler hits, as
+ *  TH1::Fill(x, w). The squared weights this needs are only kept in
+ *  memory, for the shards of GlobalHitsAnalyzer, and are not part of the
+ *  stored product, so the run products of GlobalHitsProdHist are only
+ *  ever filled with unit weight.
+ */
+
+#include "TH1.h"
+#include "TH1F.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class GlobalHitsHist1D
+{
+
+ public:
+
+  // binning and fill statistics, as kept by TH1
+  struct Header {
+    unsigned int nbins;
+    double xmin;
+    double xmax;
+    double entries;
+    double sumw;     // sum of weights of the in range fills
+    double sumwx;
+    double sumwx2;
+  };
+
+  GlobalHitsHist1D();
+  GlobalHitsHist1D(const std::string& name, const std::string& title,
+		   unsigned int nbins, double xmin, double xmax);
+
+  const std::string& name() const { return name_; }
+  const std::string& title() const { return title_; }
+  const std::string& xTitle() const { return xTitle_; }
+  const std::string& yTitle() const { return yTitle_; }
+  void setXTitle(const std::string& t) { xTitle_ = t; }
+  void setYTitle(const std::string& t) { yTitle_ = t; }
+
+  const Header& header() const { return header_; }
+  unsigned int nbins() const { return header_.nbins; }
+  double entries() const { return header_.entries; }
+
+  // bin 0 is the underflow and bin nbins+1 the overflow, as in TH1
+  float binContent(unsigned int bin) const { return counts_[bin]; }
+  double binCenter(unsigned int bin) const
+  { return header_.xmin + (bin - 0.5) * binWidth(); }
+  double binWidth() const
+  { return (header_.xmax - header_.xmin) / header_.nbins; }
+  const std::vector<float>& counts() const { return counts_; }
+
+  void fill(double x)
+  {
+    header_.entries += 1.;
+
+    // same bin lookup as TAxis::FindBin
+    int bin;
+    const int nbins = header_.nbins;
+    if (x < header_.xmin)
+      bin = 0;
+    else if (!(x < header_.xmax))
+      bin = nbins + 1;
+    else
+      bin = 1 + int(nbins * (x - header_.xmin) /
+		    (header_.xmax - header_.xmin));
+    counts_[bin] += 1.f;
+    if (!sumw2_.empty()) sumw2_[bin] += 1.f;
+
+    if ((bin == 0 || bin > nbins) && !statOverflows_) return;
+    header_.sumw += 1.;
+    header_.sumwx += x;
+    header_.sumwx2 += x * x;
+    if (!sumw2_.empty()) statSumw2_ += 1.;
+  }
+
+  // fill the n values of x with weight w: the bins of the whole array are
+  // computed in one vectorized pass, then the counters are incremented in
+  // a second
+  void fill(const float* x, unsigned int n, double w = 1.);
+
+  // add the contents of other, which must have the same binning; returns
+  // false and leaves this histogram unchanged otherwise
+  bool add(const GlobalHitsHist1D& other);
+
+  // called by the framework when products of several files are merged,
+  // e.g. the luminosity blocks of one run written by separate jobs
+  bool mergeProduct(const GlobalHitsHist1D& other) { return add(other); }
+
+  bool sameBinning(const GlobalHitsHist1D& other) const
+  {
+    return header_.nbins == other.header_.nbins &&
+      header_.xmin == other.header_.xmin &&
+      header_.xmax == other.header_.xmax;
+  }
+
+  void reset();
+
+  // add the contents and statistics into the ROOT histogram h, which has
+  // the same binning
+  void addTo(TH1* h) const;
+
+  // a TH1F with the same name, binning, contents and statistics, not
+  // attached to any directory
+  std::unique_ptr<TH1F> toTH1F() const;
+
+ private:
+
+  // start keeping the squared weights of the unit weight fills so far
+  void weighted();
+
+  std::string name_;
+  std::string title_;
+  std::string xTitle_;
+  std::string yTitle_;
+  Header header_;
+  std::vector<float> counts_;   // nbins+2, including under- and overflow
+
+  // transient
+  std::vector<int> bins_;       // scratch of the bulk fill
+  bool statOverflows_;          // TH1::GetStatOverflows() when created
+  std::vector<float> sumw2_;    // per bin sum of w^2, empty while all w = 1
+  double statSumw2_;            // sum of w^2 of the in range fills, kept
+                                // with sumw2_ (header_.sumw otherwise)
+
+}; // end class declaration
+
+#endif
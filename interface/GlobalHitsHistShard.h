@@ -0,0 +1,52 @@
+#ifndef GlobalHitsHistShard_h
+#define GlobalHitsHistShard_h
+
+/** \class GlobalHitsHistShard
+ *
+ *  GlobalHitsHist1D counters mirroring the fixed binning of one TH1,
+ *  filled in place of the histogram and added into it by flush(). A shard
+ *  belongs to the module of one edm stream, which only ever runs on one
+ *  thread at a time, so filling takes no lock and no atomic. The counters
+ *  keep exactly the bookkeeping of TH1::Fill(x), or TH1::Fill(x, w) for
+ *  sampled hits, and accumulate it in the same order, so a flushed
+ *  histogram is identical to one filled directly.
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsHist1D.h"
+#include "TH1.h"
+#include "TH1F.h"
+
+class GlobalHitsHistShard
+{
+
+ public:
+
+  explicit GlobalHitsHistShard(TH1* target) :
+    target_(target),
+    counts_("", "", target->GetXaxis()->GetNbins(),
+	    target->GetXaxis()->GetXmin(), target->GetXaxis()->GetXmax())
+  {}
+
+  TH1* target() const { return target_; }
+  GlobalHitsHist1D& counts() { return counts_; }
+
+  // add the counters into the target histogram and reset them
+  void flush()
+  {
+    counts_.addTo(target_);
+    counts_.reset();
+  }
+
+ private:
+
+  TH1* target_;
+  GlobalHitsHist1D counts_;
+
+}; // end class declaration
+
+// the ROOT histogram behind a histogram handle
+inline TH1* rootHist(TH1* h) { return h; }
+inline TH1* rootHist(TH1F* h) { return h; }
+template <class ME> TH1* rootHist(ME* me) { return me->getTH1(); }
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef GlobalHitsJobCache_h
+#define GlobalHitsJobCache_h
+
+/** \class GlobalHitsJobCache
+ *
+ *  Job wide state shared by all stream copies of a GlobalHits stream
+ *  module (edm::GlobalCache): the total number of events seen, the
+ *  one-shot provenance dump flags, which must fire once per job rather
+ *  than once per stream, and the stage times the streams hand in at
+ *  endStream when Timing is set.
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "Validation/GlobalHits/interface/GlobalHitsStageTimes.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+struct GlobalHitsJobCache
+{
+
+  explicit GlobalHitsJobCache(const edm::ParameterSet& iPSet) :
+    verbosity(iPSet.getUntrackedParameter<int>("Verbosity") % 10),
+    count(0),
+    getAllProvenances(iPSet.getParameter<edm::ParameterSet>
+		      ("ProvenanceLookup").
+		      getUntrackedParameter<bool>("GetAllProvenances")),
+    printProvenanceInfo(iPSet.getParameter<edm::ParameterSet>
+			("ProvenanceLookup").
+			getUntrackedParameter<bool>("PrintProvenanceInfo")),
+    timingJSON(iPSet.getUntrackedParameter<std::string>("TimingJSON", "")),
+    times(iPSet.getUntrackedParameter<bool>("Timing", false))
+  {
+  }
+
+  const int verbosity;
+
+  // updated from the streams through the const globalCache() pointer
+  mutable std::atomic<unsigned int> count;
+  mutable std::atomic<bool> getAllProvenances;
+  mutable std::atomic<bool> printProvenanceInfo;
+
+  // file the job stage times are written to, none if empty
+  const std::string timingJSON;
+
+  // sum of the stage times of all streams that ended, under timesLock
+  mutable std::mutex timesLock;
+  mutable GlobalHitsStageTimes times;
+
+}; // end class declaration
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef GlobalHitsSampler_h
+#define GlobalHitsSampler_h
+
+/** \class GlobalHitsSampler
+ *
+ *  Seeded random subset of the hits of an event, configured per subsystem
+ *  in the untracked PSet Sampling: of the n input hits of every fill of a
+ *  block of the subsystem, k = ceil(<System>Fraction * n) are kept, and
+ *  at most <System>Reservoir (0 for no limit). The defaults keep every
+ *  hit. The Reservoir cap applies to each input collection, i.e. per
+ *  block, except that the RPC barrel and forward blocks, which are filled
+ *  from one collection, share a single cap; it is not an event or
+ *  subsystem wide budget.
+ *
+ *  The k hits are picked before anything is done with them: a Selection
+ *  hands the fill loop the number of input hits to skip before each kept
+ *  one (Vitter's method D, or method A once k is a large part of the
+ *  remaining hits), so the fill loop only looks at the kept hits. The
+ *  detector checks, the geometry lookups, the transformation, the
+ *  kinematics and the histogram fills of a block then cost O(k), and so
+ *  does the sampling itself, with O(1) random numbers per kept hit,
+ *  whatever the occupancy. Every subset of k hits is equally likely and
+ *  the kept hits stay in their input order. Each kept hit stands for n/k
+ *  hits: this weight is left in the weight of the columns, so weighted
+ *  histograms keep their shape and normalization in expectation.
+ *
+ *  The random numbers of a block only depend on Seed, the event id and
+ *  the block, so the subset is reproducible and does not depend on the
+ *  stream or on the order in which concurrent fill stages run. The G4
+ *  vertices and tracks are never sampled.
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSubsystems.h"
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <string>
+#include <vector>
+
+class GlobalHitsSampler
+{
+
+ public:
+
+  // reads Sampling from iPSet; bad values are reported to category
+  GlobalHitsSampler(const edm::ParameterSet& iPSet,
+		    const std::string& category);
+
+  // false if every hit is kept
+  bool enabled() const { return enabled_; }
+
+  // seeds of the blocks of this event
+  void setEvent(const edm::EventID& id);
+
+  // the hits kept of the n input hits of one fill of block b: kept() of
+  // them, each standing for weight() hits, reached by skipping next()
+  // input hits before each. Without a sampler every hit is kept
+  class Selection
+  {
+
+   public:
+
+    Selection(const GlobalHitsSampler* sampler, GlobalHitsColumns::Block b,
+	      unsigned int n);
+
+    unsigned int kept() const { return kept_; }
+    float weight() const { return weight_; }
+
+    // number of input hits to skip before the next kept one; called
+    // kept() times
+    unsigned int next()
+    { return left_ < records_ ? skip() : (--left_, --records_, 0); }
+
+    // estimate of the input hits that pass the checks of the fill loop,
+    // rejected of the kept ones having failed them; exact without
+    // sampling, or when no kept hit was rejected
+    int passed(unsigned int rejected) const
+    {
+      if (kept_ == 0) return 0;
+      return int(records0_ - double(rejected) * records0_ / kept_ + 0.5);
+    }
+
+   private:
+
+    unsigned int skip();
+    unsigned int skipA();
+    unsigned int skipD();
+
+    // uniform in (0,1)
+    double uniform();
+
+    unsigned int records0_;   // input hits
+    unsigned int kept_;
+    float weight_;
+    unsigned int left_;       // kept hits still to select
+    unsigned int records_;    // input hits still to go through
+    unsigned long long state_;
+
+  }; // end class declaration
+
+  // number of hits of n that a Selection keeps for block b
+  unsigned int kept(GlobalHitsColumns::Block b, unsigned int n) const;
+
+  // subsystem of block b
+  static GlobalHitsSubsystems::System system(GlobalHitsColumns::Block b);
+
+  // sampled subsystems and their settings, for the initialization log
+  std::string summary() const;
+
+ private:
+
+  unsigned int seed_;
+  bool enabled_;
+  double fraction_[GlobalHitsSubsystems::nSystems];
+  unsigned int reservoir_[GlobalHitsSubsystems::nSystems];
+  unsigned long long eventSeed_;
+
+}; // end class declaration
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef GlobalHitsStageTimes_h
+#define GlobalHitsStageTimes_h
+
+/** \class GlobalHitsStageTimes
+ *
+ *  Wall time, CPU time of the running thread and number of hits of every
+ *  fill and store stage of the GlobalHits modules, accumulated over the
+ *  events of one stream. time() runs a stage and adds its times: two
+ *  clock readings on each side, and nothing but the call itself when the
+ *  times are disabled. Each stage only ever updates its own entry, so the
+ *  concurrently running fill tasks of one event need no lock. The stream
+ *  totals are merged into job totals at the end of the stream.
+ *
+ *  The CPU time is the one of the thread that ran the stage, so it stays
+ *  meaningful when the stages of an event run as parallel tasks.
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+
+#include <chrono>
+#include <string>
+#include <time.h>
+
+class GlobalHitsStageTimes
+{
+
+ public:
+
+  enum Stage { FillG4MC = 0, FillTrk, FillMuon, FillECal, FillHCal,
+	       StoreG4MC, StoreTrk, StoreMuon, StoreECal, StoreHCal,
+	       nStages };
+
+  struct Totals {
+    unsigned long long calls;
+    unsigned long long hits;
+    double wall;    // s
+    double cpu;     // s
+  };
+
+  explicit GlobalHitsStageTimes(bool enabled = false) : enabled_(enabled)
+  { reset(); }
+
+  bool enabled() const { return enabled_; }
+  void reset();
+
+  static const char* name(Stage s);
+
+  // run f as stage s
+  template <class F>
+  void time(Stage s, F f)
+  {
+    if (!enabled_) {
+      f();
+      return;
+    }
+    const std::chrono::steady_clock::time_point wall0 =
+      std::chrono::steady_clock::now();
+    const double cpu0 = threadCpu();
+    f();
+    Totals& t = totals_[s];
+    t.cpu += threadCpu() - cpu0;
+    t.wall += std::chrono::duration<double>
+      (std::chrono::steady_clock::now() - wall0).count();
+    ++t.calls;
+  }
+
+  void addHits(Stage s, unsigned long long n)
+  { if (enabled_) totals_[s].hits += n; }
+
+  // number of hits a stage left in the columns of its blocks
+  static unsigned long long columnHits(const GlobalHitsColumns& columns,
+				       Stage s);
+
+  const Totals& totals(Stage s) const { return totals_[s]; }
+  void merge(const GlobalHitsStageTimes& other);
+
+  // table of all stages that ran, with hits per second of wall time
+  std::string summary() const;
+
+  // the same as a JSON object, written to file; false if it cannot be
+  // created
+  bool writeJSON(const std::string& file, const std::string& module) const;
+
+ private:
+
+  static double threadCpu()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + 1.e-9 * ts.tv_nsec;
+  }
+
+  bool enabled_;
+  Totals totals_[nStages];
+
+}; // end class declaration
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef GlobalHitsSubsystems_h
+#define GlobalHitsSubsystems_h
+
+/** \class GlobalHitsSubsystems
+ *
+ *  Set of the subsystems a GlobalHits module looks at, from the untracked
+ *  vstring Subsystems (default: all of G4MC, Tracker, Muon, ECal, HCal;
+ *  ECal includes the preshower). The modules do not consume the
+ *  collections, get the geometry records or book the histograms of a
+ *  subsystem that is not in the set, so muon or calorimeter only jobs pay
+ *  for nothing else. Unknown names are reported and ignored.
+ */
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <string>
+#include <vector>
+
+class GlobalHitsSubsystems
+{
+
+ public:
+
+  enum System { G4MC = 0, Tracker, Muon, ECal, HCal, nSystems };
+
+  // reads Subsystems from iPSet; unknown names are reported to category
+  GlobalHitsSubsystems(const edm::ParameterSet& iPSet,
+		       const std::string& category);
+
+  bool enabled(System s) const { return enabled_[s]; }
+  bool calo() const { return enabled_[ECal] || enabled_[HCal]; }
+
+  static const char* name(System s);
+
+  // enabled subsystems, separated by blanks, for the initialization log
+  std::string names() const;
+
+ private:
+
+  bool enabled_[nSystems];
+
+}; // end class declaration
+
+#endif
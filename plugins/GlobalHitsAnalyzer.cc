@@ -8,15 +8,20 @@
  */
 #include "Geometry/Records/interface/CaloGeometryRecord.h"
 
-#include "Validation/GlobalHits/interface/GlobalHitsAnalyzer.h"
+#include "Validation/GlobalHits/plugins/GlobalHitsAnalyzer.h"
 #include "DQMServices/Core/interface/DQMStore.h"
 
 GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
   fName(""), verbosity(0), frequency(0), vtxunit(0), label(""), 
   getAllProvenances(false), printProvenanceInfo(false),
+  subsystems(iPSet, "GlobalHitsAnalyzer_GlobalHitsAnalyzer"),
+  sampler(iPSet, "GlobalHitsAnalyzer_GlobalHitsAnalyzer"),
   G4VtxSrc_(iPSet.getParameter<edm::InputTag>("G4VtxSrc")),
   G4TrkSrc_(iPSet.getParameter<edm::InputTag>("G4TrkSrc")),
-  count(0)
+  count(0),
+  stageTimes(iPSet.getUntrackedParameter<bool>("Timing", false)),
+  streamTimes(stageTimes.enabled()),
+  meStageWall(0), meStageCpu(0), meStageHits(0)
 {
   std::string MsgLoggerCat = "GlobalHitsAnalyzer_GlobalHitsAnalyzer";
 
@@ -33,6 +38,8 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
     m_Prov.getUntrackedParameter<bool>("PrintProvenanceInfo");
 
   //get Labels to use to extract information
+  HepMCSrc_ = iPSet.getParameter<edm::InputTag>("HepMCSrc");
+
   PxlBrlLowSrc_ = iPSet.getParameter<edm::InputTag>("PxlBrlLowSrc");
   PxlBrlHighSrc_ = iPSet.getParameter<edm::InputTag>("PxlBrlHighSrc");
   PxlFwdLowSrc_ = iPSet.getParameter<edm::InputTag>("PxlFwdLowSrc");
@@ -57,6 +64,40 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
   HCalSrc_ = iPSet.getParameter<edm::InputTag>("HCalSrc");
 
+  // declare the products read in the event loop, for the enabled
+  // subsystems only
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    HepMCSrc_Token_ = consumes<edm::HepMCProduct>(HepMCSrc_);
+    G4VtxSrc_Token_ = consumes<edm::SimVertexContainer>(G4VtxSrc_);
+    G4TrkSrc_Token_ = consumes<edm::SimTrackContainer>(G4TrkSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    PxlBrlLowSrc_Token_ = consumes<edm::PSimHitContainer>(PxlBrlLowSrc_);
+    PxlBrlHighSrc_Token_ = consumes<edm::PSimHitContainer>(PxlBrlHighSrc_);
+    PxlFwdLowSrc_Token_ = consumes<edm::PSimHitContainer>(PxlFwdLowSrc_);
+    PxlFwdHighSrc_Token_ = consumes<edm::PSimHitContainer>(PxlFwdHighSrc_);
+    SiTIBLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIBLowSrc_);
+    SiTIBHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIBHighSrc_);
+    SiTOBLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTOBLowSrc_);
+    SiTOBHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTOBHighSrc_);
+    SiTIDLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIDLowSrc_);
+    SiTIDHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIDHighSrc_);
+    SiTECLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTECLowSrc_);
+    SiTECHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTECHighSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    MuonCscSrc_Token_ = consumes<edm::PSimHitContainer>(MuonCscSrc_);
+    MuonDtSrc_Token_ = consumes<edm::PSimHitContainer>(MuonDtSrc_);
+    MuonRpcSrc_Token_ = consumes<edm::PSimHitContainer>(MuonRpcSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    ECalEBSrc_Token_ = consumes<edm::PCaloHitContainer>(ECalEBSrc_);
+    ECalEESrc_Token_ = consumes<edm::PCaloHitContainer>(ECalEESrc_);
+    ECalESSrc_Token_ = consumes<edm::PCaloHitContainer>(ECalESSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal))
+    HCalSrc_Token_ = consumes<edm::PCaloHitContainer>(HCalSrc_);
+
   // determine whether to process subdetector or not
   validHepMCevt = iPSet.getUntrackedParameter<bool>("validHepMCevt");
   validG4VtxContainer = 
@@ -86,18 +127,31 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
   // use value of first digit to determine default output level (inclusive)
   // 0 is none, 1 is basic, 2 is fill output, 3 is gather output
   verbosity %= 10;
+  diag = GlobalHitsDiagnostics(verbosity);
+  if (verbosity > 0 && !GlobalHitsDiagnostics::compiled)
+    edm::LogInfo(MsgLoggerCat)
+      << "Fill and store output of Verbosity " << verbosity
+      << " needs a build with GLOBALHITS_DEBUG (or EDM_ML_DEBUG) defined";
+
+  // the fill loops sample the staged hits if any subsystem is sampled
+  if (sampler.enabled()) SimHits.setSampler(&sampler);
 
   // print out Parameter Set information being used
   if (verbosity >= 0) {
     edm::LogInfo(MsgLoggerCat) 
       << "\n===============================\n"
-      << "Initialized as EDAnalyzer with parameter values:\n"
+      << "Initialized as stream DQMEDAnalyzer with parameter values:\n"
       << "    Name                  = " << fName << "\n"
       << "    Verbosity             = " << verbosity << "\n"
       << "    Frequency             = " << frequency << "\n"
       << "    VtxUnit               = " << vtxunit << "\n"
+      << "    Timing                = " << stageTimes.enabled() << "\n"
       << "    GetProv               = " << getAllProvenances << "\n"
       << "    PrintProv             = " << printProvenanceInfo << "\n"
+      << "    Subsystems            = " << subsystems.names() << "\n"
+      << "    Sampling              = " << sampler.summary() << "\n"
+      << "    HepMCSrc              = " << HepMCSrc_.label() 
+      << ":" << HepMCSrc_.instance() << "\n"
       << "    PxlBrlLowSrc          = " << PxlBrlLowSrc_.label() 
       << ":" << PxlBrlLowSrc_.instance() << "\n"
       << "    PxlBrlHighSrc         = " << PxlBrlHighSrc_.label() 
@@ -184,21 +238,6 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
       << "===============================\n";
   }
 
-  // get dqm info
-  dbe = 0;
-  dbe = edm::Service<DQMStore>().operator->();
-  if (dbe) {
-    if (verbosity > 0 ) {
-      dbe->setVerbose(1);
-    } else {
-      dbe->setVerbose(0);
-    }
-  }
-
-  if (dbe) {
-    if (verbosity > 0 ) dbe->showDirStructure();
-  }
-
   // initialize monitor elements
   for (Int_t i = 0; i < 2; ++i) {
     meMCRGP[i] = 0;
@@ -254,19 +293,26 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
   meMuonCscZ = 0;
   meMuonRpcBR = 0;
   meMuonRpcFZ = 0;
+}
+
+GlobalHitsAnalyzer::~GlobalHitsAnalyzer() {}
 
-  //create histograms
+void GlobalHitsAnalyzer::bookHistograms(DQMStore::IBooker& iBooker,
+					const edm::Run& iRun,
+					const edm::EventSetup& iSetup)
+{
+  //create histograms of the enabled subsystems
   Char_t hname[200];
   Char_t htitle[200];
-  if (dbe) {
 
-    // MCGeant
-    dbe->setCurrentFolder("GlobalHitsV/MCGeant");
+  // MCGeant
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    iBooker.setCurrentFolder("GlobalHitsV/MCGeant");
     sprintf(hname,"hMCRGP1");
     sprintf(htitle,"RawGenParticles");
-    meMCRGP[0] = dbe->book1D(hname,htitle,100,0.,5000.);
+    meMCRGP[0] = iBooker.book1D(hname,htitle,100,0.,5000.);
     sprintf(hname,"hMCRGP2");
-    meMCRGP[1] = dbe->book1D(hname,htitle,100,0.,500.);  
+    meMCRGP[1] = iBooker.book1D(hname,htitle,100,0.,500.);  
     for (Int_t i = 0; i < 2; ++i) {
       meMCRGP[i]->setAxisTitle("Number of Raw Generated Particles",1);
       meMCRGP[i]->setAxisTitle("Count",2);
@@ -274,9 +320,9 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hMCG4Vtx1");
     sprintf(htitle,"G4 Vertices");
-    meMCG4Vtx[0] = dbe->book1D(hname,htitle,150,0.,15000.);
+    meMCG4Vtx[0] = iBooker.book1D(hname,htitle,150,0.,15000.);
     sprintf(hname,"hMCG4Vtx2");
-    meMCG4Vtx[1] = dbe->book1D(hname,htitle,100,-0.5,99.5); 
+    meMCG4Vtx[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5); 
     for (Int_t i = 0; i < 2; ++i) {
       meMCG4Vtx[i]->setAxisTitle("Number of Vertices",1);
       meMCG4Vtx[i]->setAxisTitle("Count",2);
@@ -284,9 +330,9 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hMCG4Trk1");
     sprintf(htitle,"G4 Tracks");
-    meMCG4Trk[0] = dbe->book1D(hname,htitle,150,0.,15000.);
+    meMCG4Trk[0] = iBooker.book1D(hname,htitle,150,0.,15000.);
     sprintf(hname,"hMCG4Trk2");
-    meMCG4Trk[1] = dbe->book1D(hname,htitle,150,-0.5,99.5);    
+    meMCG4Trk[1] = iBooker.book1D(hname,htitle,150,-0.5,99.5);    
     for (Int_t i = 0; i < 2; ++i) {
       meMCG4Trk[i]->setAxisTitle("Number of Tracks",1);
       meMCG4Trk[i]->setAxisTitle("Count",2);
@@ -294,9 +340,9 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hGeantVtxX1");
     sprintf(htitle,"Geant vertex x/micrometer");
-    meGeantVtxX[0] = dbe->book1D(hname,htitle,100,-8000000.,8000000.);
+    meGeantVtxX[0] = iBooker.book1D(hname,htitle,100,-8000000.,8000000.);
     sprintf(hname,"hGeantVtxX2");
-    meGeantVtxX[1] = dbe->book1D(hname,htitle,100,-50.,50.); 
+    meGeantVtxX[1] = iBooker.book1D(hname,htitle,100,-50.,50.); 
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxX[i]->setAxisTitle("x of Vertex (um)",1);
       meGeantVtxX[i]->setAxisTitle("Count",2);
@@ -304,9 +350,9 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hGeantVtxY1");
     sprintf(htitle,"Geant vertex y/micrometer");
-    meGeantVtxY[0] = dbe->book1D(hname,htitle,100,-8000000,8000000.);
+    meGeantVtxY[0] = iBooker.book1D(hname,htitle,100,-8000000,8000000.);
     sprintf(hname,"hGeantVtxY2");
-    meGeantVtxY[1] = dbe->book1D(hname,htitle,100,-50.,50.); 
+    meGeantVtxY[1] = iBooker.book1D(hname,htitle,100,-50.,50.); 
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxY[i]->setAxisTitle("y of Vertex (um)",1);
       meGeantVtxY[i]->setAxisTitle("Count",2);
@@ -314,10 +360,10 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hGeantVtxZ1");
     sprintf(htitle,"Geant vertex z/millimeter");
-    meGeantVtxZ[0] = dbe->book1D(hname,htitle,100,-11000.,11000.);
+    meGeantVtxZ[0] = iBooker.book1D(hname,htitle,100,-11000.,11000.);
     sprintf(hname,"hGeantVtxZ2");
-    meGeantVtxZ[1] = dbe->book1D(hname,htitle,200,-500.,500.);
-    //meGeantVtxZ[1] = dbe->book1D(hname,htitle,100,-250.,250.);
+    meGeantVtxZ[1] = iBooker.book1D(hname,htitle,200,-500.,500.);
+    //meGeantVtxZ[1] = iBooker.book1D(hname,htitle,100,-250.,250.);
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxZ[i]->setAxisTitle("z of Vertex (mm)",1);
       meGeantVtxZ[i]->setAxisTitle("Count",2);
@@ -325,33 +371,33 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hGeantTrkPt");
     sprintf(htitle,"Log10 Geant track pt/GeV");
-    meGeantTrkPt = dbe->book1D(hname,htitle,80,-4.,4.);
+    meGeantTrkPt = iBooker.book1D(hname,htitle,80,-4.,4.);
     meGeantTrkPt->setAxisTitle("Log10 pT of Track (GeV)",1);
     meGeantTrkPt->setAxisTitle("Count",2);
 
     sprintf(hname,"hGeantTrkE");
     sprintf(htitle,"Log10 Geant track E/GeV");
-    meGeantTrkE = dbe->book1D(hname,htitle,80,-4.,4.);
+    meGeantTrkE = iBooker.book1D(hname,htitle,80,-4.,4.);
     meGeantTrkE->setAxisTitle("Log10 E of Track (GeV)",1);
     meGeantTrkE->setAxisTitle("Count",2);
 
     sprintf(hname,"hGeantVtxEta");
     sprintf(htitle,"Geant vertices eta");
-    meGeantVtxEta = dbe->book1D(hname,htitle,220,-5.5,5.5);
+    meGeantVtxEta = iBooker.book1D(hname,htitle,220,-5.5,5.5);
     meGeantVtxEta->setAxisTitle("eta of SimVertex",1);
     meGeantVtxEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hGeantVtxPhi");
     sprintf(htitle,"Geant vertices phi/rad");
-    meGeantVtxPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meGeantVtxPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meGeantVtxPhi->setAxisTitle("phi of SimVertex (rad)",1);
     meGeantVtxPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hGeantVtxRad1");
     sprintf(htitle,"Geant vertices radius/cm");
-    meGeantVtxRad[0] = dbe->book1D(hname,htitle,130,0.,130.);
+    meGeantVtxRad[0] = iBooker.book1D(hname,htitle,130,0.,130.);
     sprintf(hname,"hGeantVtxRad2");
-    meGeantVtxRad[1] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meGeantVtxRad[1] = iBooker.book1D(hname,htitle,100,0.,1000.);
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxRad[i]->setAxisTitle("radius of SimVertex (cm)",1);
       meGeantVtxRad[i]->setAxisTitle("Count",2);
@@ -359,29 +405,31 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hGeantVtxMulti");
     sprintf(htitle,"Geant vertices outgoing multiplicity");
-    meGeantVtxMulti = dbe->book1D(hname,htitle,20,0.,20);
+    meGeantVtxMulti = iBooker.book1D(hname,htitle,20,0.,20);
     meGeantVtxMulti->setAxisTitle("multiplicity of particles attached to a SimVertex",1);
     meGeantVtxMulti->setAxisTitle("Count",2);
+  }
 
-    // ECal
-    dbe->setCurrentFolder("GlobalHitsV/ECals");
+  // ECal
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    iBooker.setCurrentFolder("GlobalHitsV/ECals");
     sprintf(hname,"hCaloEcal1");
     sprintf(htitle,"Ecal hits");
-    meCaloEcal[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meCaloEcal[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hCaloEcal2");
-    meCaloEcal[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meCaloEcal[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
 
     sprintf(hname,"hCaloEcalE1");
     sprintf(htitle,"Ecal hits, energy/GeV");
-    meCaloEcalE[0] = dbe->book1D(hname,htitle,100,0.,10.);
+    meCaloEcalE[0] = iBooker.book1D(hname,htitle,100,0.,10.);
     sprintf(hname,"hCaloEcalE2");
-    meCaloEcalE[1] = dbe->book1D(hname,htitle,100,0.,0.1);
+    meCaloEcalE[1] = iBooker.book1D(hname,htitle,100,0.,0.1);
     sprintf(hname,"hCaloEcalToF1");
     sprintf(htitle,"Ecal hits, ToF/ns");
-    meCaloEcalToF[0] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meCaloEcalToF[0] = iBooker.book1D(hname,htitle,100,0.,1000.);
     sprintf(hname,"hCaloEcalToF2");
-    meCaloEcalToF[1] = dbe->book1D(hname,htitle,100,0.,100.);
- 
+    meCaloEcalToF[1] = iBooker.book1D(hname,htitle,100,0.,100.);
+
     for (Int_t i = 0; i < 2; ++i) {
       meCaloEcal[i]->setAxisTitle("Number of Hits",1);
       meCaloEcal[i]->setAxisTitle("Count",2);
@@ -393,33 +441,33 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hCaloEcalPhi");
     sprintf(htitle,"Ecal hits, phi/rad");
-    meCaloEcalPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meCaloEcalPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meCaloEcalPhi->setAxisTitle("Phi of Hits (rad)",1);
     meCaloEcalPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloEcalEta");
     sprintf(htitle,"Ecal hits, eta");
-    meCaloEcalEta = dbe->book1D(hname,htitle,100,-5.5,5.5);
+    meCaloEcalEta = iBooker.book1D(hname,htitle,100,-5.5,5.5);
     meCaloEcalEta->setAxisTitle("Eta of Hits",1);
     meCaloEcalEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloPreSh1");
     sprintf(htitle,"PreSh hits");
-    meCaloPreSh[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meCaloPreSh[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hCaloPreSh2");
-    meCaloPreSh[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meCaloPreSh[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
 
     sprintf(hname,"hCaloPreShE1");
     sprintf(htitle,"PreSh hits, energy/GeV");
-    meCaloPreShE[0] = dbe->book1D(hname,htitle,100,0.,10.);
+    meCaloPreShE[0] = iBooker.book1D(hname,htitle,100,0.,10.);
     sprintf(hname,"hCaloPreShE2");
-    meCaloPreShE[1] = dbe->book1D(hname,htitle,100,0.,0.1);
+    meCaloPreShE[1] = iBooker.book1D(hname,htitle,100,0.,0.1);
 
     sprintf(hname,"hCaloPreShToF1");
     sprintf(htitle,"PreSh hits, ToF/ns");
-    meCaloPreShToF[0] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meCaloPreShToF[0] = iBooker.book1D(hname,htitle,100,0.,1000.);
     sprintf(hname,"hCaloPreShToF2");
-    meCaloPreShToF[1] = dbe->book1D(hname,htitle,100,0.,100.);
+    meCaloPreShToF[1] = iBooker.book1D(hname,htitle,100,0.,100.);
 
     for (Int_t i = 0; i < 2; ++i) {
       meCaloPreSh[i]->setAxisTitle("Number of Hits",1);
@@ -432,35 +480,37 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hCaloPreShPhi");
     sprintf(htitle,"PreSh hits, phi/rad");
-    meCaloPreShPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meCaloPreShPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meCaloPreShPhi->setAxisTitle("Phi of Hits (rad)",1);
     meCaloPreShPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloPreShEta");
     sprintf(htitle,"PreSh hits, eta");
-    meCaloPreShEta = dbe->book1D(hname,htitle,100,-5.5,5.5);
+    meCaloPreShEta = iBooker.book1D(hname,htitle,100,-5.5,5.5);
     meCaloPreShEta->setAxisTitle("Eta of Hits",1);
     meCaloPreShEta->setAxisTitle("Count",2);
+  }
 
-    // Hcal
-    dbe->setCurrentFolder("GlobalHitsV/HCals");
+  // Hcal
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal)) {
+    iBooker.setCurrentFolder("GlobalHitsV/HCals");
     sprintf(hname,"hCaloHcal1");
     sprintf(htitle,"Hcal hits");
-    meCaloHcal[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meCaloHcal[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hCaloHcal2");
-    meCaloHcal[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meCaloHcal[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
 
     sprintf(hname,"hCaloHcalE1");
     sprintf(htitle,"Hcal hits, energy/GeV");
-    meCaloHcalE[0] = dbe->book1D(hname,htitle,100,0.,10.);
+    meCaloHcalE[0] = iBooker.book1D(hname,htitle,100,0.,10.);
     sprintf(hname,"hCaloHcalE2");
-    meCaloHcalE[1] = dbe->book1D(hname,htitle,100,0.,0.1);
+    meCaloHcalE[1] = iBooker.book1D(hname,htitle,100,0.,0.1);
 
     sprintf(hname,"hCaloHcalToF1");
     sprintf(htitle,"Hcal hits, ToF/ns");
-    meCaloHcalToF[0] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meCaloHcalToF[0] = iBooker.book1D(hname,htitle,100,0.,1000.);
     sprintf(hname,"hCaloHcalToF2");
-    meCaloHcalToF[1] = dbe->book1D(hname,htitle,100,0.,100.);
+    meCaloHcalToF[1] = iBooker.book1D(hname,htitle,100,0.,100.);
 
     for (Int_t i = 0; i < 2; ++i) {
       meCaloHcal[i]->setAxisTitle("Number of Hits",1);
@@ -473,23 +523,25 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hCaloHcalPhi");
     sprintf(htitle,"Hcal hits, phi/rad");
-    meCaloHcalPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meCaloHcalPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meCaloHcalPhi->setAxisTitle("Phi of Hits (rad)",1);
     meCaloHcalPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloHcalEta");
     sprintf(htitle,"Hcal hits, eta");
-    meCaloHcalEta = dbe->book1D(hname,htitle,100,-5.5,5.5);
+    meCaloHcalEta = iBooker.book1D(hname,htitle,100,-5.5,5.5);
     meCaloHcalEta->setAxisTitle("Eta of Hits",1);
     meCaloHcalEta->setAxisTitle("Count",2);
-    
-    // SiPixels
-    dbe->setCurrentFolder("GlobalHitsV/SiPixels");
+  }
+
+  // SiPixels
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    iBooker.setCurrentFolder("GlobalHitsV/SiPixels");
     sprintf(hname,"hTrackerPx1");
     sprintf(htitle,"Pixel hits");
-    meTrackerPx[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meTrackerPx[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hTrackerPx2");
-    meTrackerPx[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meTrackerPx[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
     for (Int_t i = 0; i < 2; ++i) {
       meTrackerPx[i]->setAxisTitle("Number of Pixel Hits",1);
       meTrackerPx[i]->setAxisTitle("Count",2);
@@ -497,48 +549,48 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hTrackerPxPhi");
     sprintf(htitle,"Pixel hits phi/rad");
-    meTrackerPxPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meTrackerPxPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meTrackerPxPhi->setAxisTitle("Phi of Hits (rad)",1);
     meTrackerPxPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxEta");
     sprintf(htitle,"Pixel hits eta");
-    meTrackerPxEta = dbe->book1D(hname,htitle,100,-3.5,3.5);
+    meTrackerPxEta = iBooker.book1D(hname,htitle,100,-3.5,3.5);
     meTrackerPxEta->setAxisTitle("Eta of Hits",1);
     meTrackerPxEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxBToF");
     sprintf(htitle,"Pixel barrel hits, ToF/ns");
-    meTrackerPxBToF = dbe->book1D(hname,htitle,100,0.,40.);
+    meTrackerPxBToF = iBooker.book1D(hname,htitle,100,0.,40.);
     meTrackerPxBToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerPxBToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxBR");
     sprintf(htitle,"Pixel barrel hits, R/cm");
-    meTrackerPxBR = dbe->book1D(hname,htitle,100,0.,50.);
+    meTrackerPxBR = iBooker.book1D(hname,htitle,100,0.,50.);
     meTrackerPxBR->setAxisTitle("R of Hits (cm)",1);
     meTrackerPxBR->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxFToF");
     sprintf(htitle,"Pixel forward hits, ToF/ns");
-    meTrackerPxFToF = dbe->book1D(hname,htitle,100,0.,50.);
+    meTrackerPxFToF = iBooker.book1D(hname,htitle,100,0.,50.);
     meTrackerPxFToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerPxFToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxFZ");
     sprintf(htitle,"Pixel forward hits, Z/cm");
     meTrackerPxFZ = 
-      dbe->book1D(hname,htitle,200,-100.,100.);
+      iBooker.book1D(hname,htitle,200,-100.,100.);
     meTrackerPxFZ->setAxisTitle("Z of Hits (cm)",1);
     meTrackerPxFZ->setAxisTitle("Count",2);
 
     // SiStrips
-    dbe->setCurrentFolder("GlobalHitsV/SiStrips");
+    iBooker.setCurrentFolder("GlobalHitsV/SiStrips");
     sprintf(hname,"hTrackerSi1");
     sprintf(htitle,"Silicon hits");
-    meTrackerSi[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meTrackerSi[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hTrackerSi2");
-    meTrackerSi[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meTrackerSi[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
     for (Int_t i = 0; i < 2; ++i) { 
       meTrackerSi[i]->setAxisTitle("Number of Silicon Hits",1);
       meTrackerSi[i]->setAxisTitle("Count",2);
@@ -546,47 +598,49 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hTrackerSiPhi");
     sprintf(htitle,"Silicon hits phi/rad");
-    meTrackerSiPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meTrackerSiPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meTrackerSiPhi->setAxisTitle("Phi of Hits (rad)",1);
     meTrackerSiPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiEta");
     sprintf(htitle,"Silicon hits eta");
-    meTrackerSiEta = dbe->book1D(hname,htitle,100,-3.5,3.5);
+    meTrackerSiEta = iBooker.book1D(hname,htitle,100,-3.5,3.5);
     meTrackerSiEta->setAxisTitle("Eta of Hits",1);
     meTrackerSiEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiBToF");
     sprintf(htitle,"Silicon barrel hits, ToF/ns");
-    meTrackerSiBToF = dbe->book1D(hname,htitle,100,0.,50.);
+    meTrackerSiBToF = iBooker.book1D(hname,htitle,100,0.,50.);
     meTrackerSiBToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerSiBToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiBR");
     sprintf(htitle,"Silicon barrel hits, R/cm");
-    meTrackerSiBR = dbe->book1D(hname,htitle,100,0.,200.);
+    meTrackerSiBR = iBooker.book1D(hname,htitle,100,0.,200.);
     meTrackerSiBR->setAxisTitle("R of Hits (cm)",1);
     meTrackerSiBR->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiFToF");
     sprintf(htitle,"Silicon forward hits, ToF/ns");
-    meTrackerSiFToF = dbe->book1D(hname,htitle,100,0.,75.);
+    meTrackerSiFToF = iBooker.book1D(hname,htitle,100,0.,75.);
     meTrackerSiFToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerSiFToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiFZ");
     sprintf(htitle,"Silicon forward hits, Z/cm");
-    meTrackerSiFZ = dbe->book1D(hname,htitle,200,-300.,300.);
+    meTrackerSiFZ = iBooker.book1D(hname,htitle,200,-300.,300.);
     meTrackerSiFZ->setAxisTitle("Z of Hits (cm)",1);
     meTrackerSiFZ->setAxisTitle("Count",2);
+  }
 
-    // Muon
-    dbe->setCurrentFolder("GlobalHitsV/Muons");
+  // Muon
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    iBooker.setCurrentFolder("GlobalHitsV/Muons");
     sprintf(hname,"hMuon1");
     sprintf(htitle,"Muon hits");
-    meMuon[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meMuon[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hMuon2");
-    meMuon[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meMuon[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
     for (Int_t i = 0; i < 2; ++i) { 
       meMuon[i]->setAxisTitle("Number of Muon Hits",1);
       meMuon[i]->setAxisTitle("Count",2);
@@ -594,21 +648,21 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hMuonPhi");
     sprintf(htitle,"Muon hits phi/rad");
-    meMuonPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meMuonPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meMuonPhi->setAxisTitle("Phi of Hits (rad)",1);
     meMuonPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonEta");
     sprintf(htitle,"Muon hits eta");
-    meMuonEta = dbe->book1D(hname,htitle,100,-3.5,3.5);
+    meMuonEta = iBooker.book1D(hname,htitle,100,-3.5,3.5);
     meMuonEta->setAxisTitle("Eta of Hits",1);
     meMuonEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonCscToF1");
     sprintf(htitle,"Muon CSC hits, ToF/ns");
-    meMuonCscToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonCscToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonCscToF2");
-    meMuonCscToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonCscToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonCscToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonCscToF[i]->setAxisTitle("Count",2);
@@ -616,15 +670,15 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hMuonCscZ");
     sprintf(htitle,"Muon CSC hits, Z/cm");
-    meMuonCscZ = dbe->book1D(hname,htitle,200,-1500.,1500.);
+    meMuonCscZ = iBooker.book1D(hname,htitle,200,-1500.,1500.);
     meMuonCscZ->setAxisTitle("Z of Hits (cm)",1);
     meMuonCscZ->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonDtToF1");
     sprintf(htitle,"Muon DT hits, ToF/ns");
-    meMuonDtToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonDtToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonDtToF2");
-    meMuonDtToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonDtToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonDtToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonDtToF[i]->setAxisTitle("Count",2);
@@ -632,30 +686,30 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hMuonDtR");
     sprintf(htitle,"Muon DT hits, R/cm");
-    meMuonDtR = dbe->book1D(hname,htitle,100,0.,1500.); 
+    meMuonDtR = iBooker.book1D(hname,htitle,100,0.,1500.); 
     meMuonDtR->setAxisTitle("R of Hits (cm)",1);
     meMuonDtR->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonRpcFToF1");
     sprintf(htitle,"Muon RPC forward hits, ToF/ns");
-    meMuonRpcFToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonRpcFToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonRpcFToF2");
-    meMuonRpcFToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonRpcFToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonRpcFToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonRpcFToF[i]->setAxisTitle("Count",2);
     }  
     sprintf(hname,"hMuonRpcFZ");
     sprintf(htitle,"Muon RPC forward hits, Z/cm");
-    meMuonRpcFZ = dbe->book1D(hname,htitle,201,-1500.,1500.);
+    meMuonRpcFZ = iBooker.book1D(hname,htitle,201,-1500.,1500.);
     meMuonRpcFZ->setAxisTitle("Z of Hits (cm)",1);
     meMuonRpcFZ->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonRpcBToF1");
     sprintf(htitle,"Muon RPC barrel hits, ToF/ns");
-    meMuonRpcBToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonRpcBToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonRpcBToF2");
-    meMuonRpcBToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonRpcBToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonRpcBToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonRpcBToF[i]->setAxisTitle("Count",2);
@@ -663,25 +717,103 @@ GlobalHitsAnalyzer::GlobalHitsAnalyzer(const edm::ParameterSet& iPSet) :
 
     sprintf(hname,"hMuonRpcBR");
     sprintf(htitle,"Muon RPC barrel hits, R/cm");
-    meMuonRpcBR = dbe->book1D(hname,htitle,100,0.,1500.);
+    meMuonRpcBR = iBooker.book1D(hname,htitle,100,0.,1500.);
     meMuonRpcBR->setAxisTitle("R of Hits (cm)",1);
-    meMuonRpcBR->setAxisTitle("Count",2); 
+    meMuonRpcBR->setAxisTitle("Count",2);
   }
-}
 
-GlobalHitsAnalyzer::~GlobalHitsAnalyzer() {}
+  // stage times, added at the end of the run
+  if (stageTimes.enabled()) {
+    iBooker.setCurrentFolder("GlobalHitsV/Timing");
+    const int nFill = GlobalHitsStageTimes::FillHCal + 1;
+    sprintf(hname,"hStageWall");
+    sprintf(htitle,"Wall time of the fill stages, s");
+    meStageWall = iBooker.book1D(hname,htitle,nFill,-0.5,nFill-0.5);
+    sprintf(hname,"hStageCpu");
+    sprintf(htitle,"CPU time of the fill stages, s");
+    meStageCpu = iBooker.book1D(hname,htitle,nFill,-0.5,nFill-0.5);
+    sprintf(hname,"hStageHits");
+    sprintf(htitle,"Hits of the fill stages");
+    meStageHits = iBooker.book1D(hname,htitle,nFill,-0.5,nFill-0.5);
+    MonitorElement* meStage[3] = { meStageWall, meStageCpu, meStageHits };
+    for (Int_t i = 0; i < 3; ++i) {
+      for (Int_t s = 0; s < nFill; ++s)
+	meStage[i]->setBinLabel(s+1,
+	   GlobalHitsStageTimes::name(GlobalHitsStageTimes::Stage(s)),1);
+    }
+  }
+
+  // histograms filled by the hit engine, per block; drop the shards
+  // of the monitor elements booked for the previous run
+  theSink.clear();
+  theSink.route(GlobalHitsColumns::PxlBrl,
+		0, 0, meTrackerPxBToF, 0, meTrackerPxBR, meTrackerPxPhi,
+		meTrackerPxEta);
+  theSink.route(GlobalHitsColumns::PxlFwd,
+		0, 0, meTrackerPxFToF, 0, meTrackerPxFZ, meTrackerPxPhi,
+		meTrackerPxEta);
+  theSink.route(GlobalHitsColumns::SiBrl,
+		0, 0, meTrackerSiBToF, 0, meTrackerSiBR, meTrackerSiPhi,
+		meTrackerSiEta);
+  theSink.route(GlobalHitsColumns::SiFwd,
+		0, 0, meTrackerSiFToF, 0, meTrackerSiFZ, meTrackerSiPhi,
+		meTrackerSiEta);
+  theSink.route(GlobalHitsColumns::MuonCsc,
+		0, 0, meMuonCscToF[0], meMuonCscToF[1], meMuonCscZ, meMuonPhi,
+		meMuonEta);
+  theSink.route(GlobalHitsColumns::MuonDt,
+		0, 0, meMuonDtToF[0], meMuonDtToF[1], meMuonDtR, meMuonPhi,
+		meMuonEta);
+  theSink.route(GlobalHitsColumns::MuonRpcFwd,
+		0, 0, meMuonRpcFToF[0], meMuonRpcFToF[1], meMuonRpcFZ,
+		meMuonPhi, meMuonEta);
+  theSink.route(GlobalHitsColumns::MuonRpcBrl,
+		0, 0, meMuonRpcBToF[0], meMuonRpcBToF[1], meMuonRpcBR,
+		meMuonPhi, meMuonEta);
+  theSink.route(GlobalHitsColumns::ECal,
+		meCaloEcalE[0], meCaloEcalE[1], meCaloEcalToF[0],
+		meCaloEcalToF[1], 0, meCaloEcalPhi, meCaloEcalEta);
+  theSink.route(GlobalHitsColumns::PreSh,
+		meCaloPreShE[0], meCaloPreShE[1], meCaloPreShToF[0],
+		meCaloPreShToF[1], 0, meCaloPreShPhi, meCaloPreShEta);
+  theSink.route(GlobalHitsColumns::HCal,
+		meCaloHcalE[0], meCaloHcalE[1], meCaloHcalToF[0],
+		meCaloHcalToF[1], 0, meCaloHcalPhi, meCaloHcalEta);
+}
 
-void GlobalHitsAnalyzer::beginJob( void )
+void GlobalHitsAnalyzer::endRun(const edm::Run& iRun,
+				const edm::EventSetup& iSetup)
 {
+  // add the hit shards of this stream into its monitor elements before
+  // the DQMStore merges the streams
+  theSink.flush();
+
+  // the same for the stage times of the run
+  if (meStageWall) {
+    for (int s = GlobalHitsStageTimes::FillG4MC;
+	 s <= GlobalHitsStageTimes::FillHCal; ++s) {
+      const GlobalHitsStageTimes::Totals& t =
+	stageTimes.totals(GlobalHitsStageTimes::Stage(s));
+      meStageWall->Fill((float)s, t.wall);
+      meStageCpu->Fill((float)s, t.cpu);
+      meStageHits->Fill((float)s, (double)t.hits);
+    }
+  }
+  streamTimes.merge(stageTimes);
+  stageTimes.reset();
   return;
 }
 
-void GlobalHitsAnalyzer::endJob()
+void GlobalHitsAnalyzer::endStream()
 {
-  std::string MsgLoggerCat = "GlobalHitsAnalyzer_endJob";
-  if (verbosity >= 0)
+  std::string MsgLoggerCat = "GlobalHitsAnalyzer_endStream";
+  if (verbosity >= 0) {
     edm::LogInfo(MsgLoggerCat) 
-      << "Terminating having processed " << count << " events.";
+      << "Stream terminating having processed " << count << " events.";
+    if (streamTimes.enabled())
+      edm::LogInfo(MsgLoggerCat)
+	<< "Stage times of this stream:" << streamTimes.summary() << "\n";
+  }
   return;
 }
 
@@ -742,17 +874,31 @@ void GlobalHitsAnalyzer::analyze(const edm::Event& iEvent,
     getAllProvenances = false;
   }
 
-  // call fill functions
+  // reset hit columns, keeping their capacity, and seed the hit sampling
+  // of this event
+  SimHits.clear();
+  if (sampler.enabled()) sampler.setEvent(iEvent.id());
+
+  // call fill functions of the enabled subsystems
+  typedef GlobalHitsStageTimes T;
+  typedef GlobalHitsSubsystems S;
   //gather G4MC information from event
-  fillG4MC(iEvent);
+  if (subsystems.enabled(S::G4MC))
+    stageTimes.time(T::FillG4MC, [&] { fillG4MC(iEvent); });
   // gather Tracker information from event
-  fillTrk(iEvent,iSetup);
+  if (subsystems.enabled(S::Tracker))
+    stageTimes.time(T::FillTrk, [&] { fillTrk(iEvent,iSetup); });
   // gather muon information from event
-  fillMuon(iEvent, iSetup);
+  if (subsystems.enabled(S::Muon))
+    stageTimes.time(T::FillMuon, [&] { fillMuon(iEvent, iSetup); });
   // gather Ecal information from event
-  fillECal(iEvent, iSetup);
+  if (subsystems.enabled(S::ECal))
+    stageTimes.time(T::FillECal, [&] { fillECal(iEvent, iSetup); });
   // gather Hcal information from event
-  fillHCal(iEvent, iSetup);
+  if (subsystems.enabled(S::HCal))
+    stageTimes.time(T::FillHCal, [&] { fillHCal(iEvent, iSetup); });
+
+  if (stageTimes.enabled()) countStageHits(iEvent);
 
   if (verbosity > 0)
     edm::LogInfo (MsgLoggerCat)
@@ -761,47 +907,59 @@ void GlobalHitsAnalyzer::analyze(const edm::Event& iEvent,
   return;
 }
 
+void GlobalHitsAnalyzer::countStageHits(const edm::Event& iEvent)
+{
+  typedef GlobalHitsStageTimes T;
+
+  // the G4MC stage reads all vertices and tracks
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    edm::Handle<edm::SimVertexContainer> G4VtxContainer;
+    iEvent.getByToken(G4VtxSrc_Token_,G4VtxContainer);
+    edm::Handle<edm::SimTrackContainer> G4TrkContainer;
+    iEvent.getByToken(G4TrkSrc_Token_,G4TrkContainer);
+    unsigned long long nG4 = 0;
+    if (G4VtxContainer.isValid()) nG4 += G4VtxContainer->size();
+    if (G4TrkContainer.isValid()) nG4 += G4TrkContainer->size();
+    stageTimes.addHits(T::FillG4MC, nG4);
+  }
+
+  // the others left their hits in the columns
+  for (int s = T::FillTrk; s <= T::FillHCal; ++s)
+    stageTimes.addHits(T::Stage(s), T::columnHits(SimHits, T::Stage(s)));
+  return;
+}
+
 //==================fill and store functions================================
 void GlobalHitsAnalyzer::fillG4MC(const edm::Event& iEvent)
 {
 
   std::string MsgLoggerCat = "GlobalHitsAnalyzer_fillG4MC";
  
-  TString eventout;
-  if (verbosity > 0)
-    eventout = "\nGathering info:";
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
 
   //////////////////////
   // get MC information
   /////////////////////
   edm::Handle<edm::HepMCProduct> HepMCEvt;
-  std::vector<edm::Handle<edm::HepMCProduct> > AllHepMCEvt;
-  iEvent.getManyByType(AllHepMCEvt);
-
-  // loop through products and extract VtxSmearing if available. Any of them
-  // should have the information needed
-  for (unsigned int i = 0; i < AllHepMCEvt.size(); ++i) {
-    HepMCEvt = AllHepMCEvt[i];
-    if ((HepMCEvt.provenance()->product()).moduleLabel() == "VtxSmeared")
-      break;
-  }
+  iEvent.getByToken(HepMCSrc_Token_,HepMCEvt);
 
   if (!HepMCEvt.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find HepMCProduct in event!";
     validHepMCevt = false;
-  } else {
-    eventout += "\n          Using HepMCProduct: ";
-    eventout += (HepMCEvt.provenance()->product()).moduleLabel();
+  } else if (diag.gather()) {
+    eventout << "\n          Using HepMCProduct: ";
+    eventout << HepMCSrc_.encode();
   }
   if (validHepMCevt) {
     const HepMC::GenEvent* MCEvt = HepMCEvt->GetEvent();
     nRawGenPart = MCEvt->particles_size();
     
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of Raw Particles collected:......... ";
-      eventout += nRawGenPart;
+    if (diag.counts()) {
+      eventout << "\n          Number of Raw Particles collected:......... ";
+      eventout << nRawGenPart;
     }      
     
     if (meMCRGP[0]) meMCRGP[0]->Fill((float)nRawGenPart);
@@ -818,11 +976,11 @@ void GlobalHitsAnalyzer::fillG4MC(const edm::Event& iEvent)
   if (vtxunit == 1) unit = 10.; // stored in cm, convert to mm
 
   edm::Handle<edm::SimVertexContainer> G4VtxContainer;
-  iEvent.getByLabel(G4VtxSrc_, G4VtxContainer);
+  iEvent.getByToken(G4VtxSrc_Token_,G4VtxContainer);
 
   // needed here by vertex multiplicity
   edm::Handle<edm::SimTrackContainer> G4TrkContainer;
-  iEvent.getByLabel(G4TrkSrc_, G4TrkContainer);
+  iEvent.getByToken(G4TrkSrc_Token_,G4TrkContainer);
 
 
   if (!G4VtxContainer.isValid()) {
@@ -874,9 +1032,9 @@ void GlobalHitsAnalyzer::fillG4MC(const edm::Event& iEvent)
       
     }
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of G4Vertices collected:............ ";
-      eventout += i;
+    if (diag.counts()) {
+      eventout << "\n          Number of G4Vertices collected:............ ";
+      eventout << i;
     }  
     
     if (meMCG4Vtx[0]) meMCG4Vtx[0]->Fill((float)i);
@@ -912,17 +1070,16 @@ void GlobalHitsAnalyzer::fillG4MC(const edm::Event& iEvent)
       if (meGeantTrkE) meGeantTrkE->Fill(std::log10(std::max(G4Trk[3],-9.)));
     } 
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of G4Tracks collected:.............. ";
-      eventout += i;
+    if (diag.counts()) {
+      eventout << "\n          Number of G4Tracks collected:.............. ";
+      eventout << i;
     }  
     
     if (meMCG4Trk[0]) meMCG4Trk[0]->Fill((float)i);
     if (meMCG4Trk[1]) meMCG4Trk[1]->Fill((float)i); 
   }
 
-  if (verbosity > 0)
-    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  eventout.log(MsgLoggerCat);
     
   return;
 }
@@ -934,9 +1091,8 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   nPxlHits = 0;
   std::string MsgLoggerCat = "GlobalHitsAnalyzer_fillTrk";
 
-  TString eventout;
-  if (verbosity > 0)
-    eventout = "\nGathering info:";  
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
   
   // access the tracker geometry
   edm::ESHandle<TrackerGeometry> theTrackerGeometry;
@@ -946,18 +1102,19 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
       << "Unable to find TrackerDigiGeometryRecord in event!";
     return;
   }
-  const TrackerGeometry& theTracker(*theTrackerGeometry);
+  if (theTrkCache.
+      update(iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier(),
+	     *theTrackerGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theTrkCache.size() << " tracker DetUnits";
     
-  // iterator to access containers
-  edm::PSimHitContainer::const_iterator itHit;
-
   ///////////////////////////////
   // get Pixel Barrel information
   ///////////////////////////////
-  edm::PSimHitContainer thePxlBrlHits;
+  GlobalHitsChainedRange<edm::PSimHitContainer> thePxlBrlHits;
   // extract low container
   edm::Handle<edm::PSimHitContainer> PxlBrlLowContainer;
-  iEvent.getByLabel(PxlBrlLowSrc_,PxlBrlLowContainer);
+  iEvent.getByToken(PxlBrlLowSrc_Token_,PxlBrlLowContainer);
   if (!PxlBrlLowContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsPixelBarrelLowTof in event!";
@@ -965,70 +1122,26 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract high container
   edm::Handle<edm::PSimHitContainer> PxlBrlHighContainer;
-  iEvent.getByLabel(PxlBrlHighSrc_,PxlBrlHighContainer);
+  iEvent.getByToken(PxlBrlHighSrc_Token_,PxlBrlHighContainer);
   if (!PxlBrlHighContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsPixelBarrelHighTof in event!";
     validPxlBrlHigh = false;
   }
-  // place both containers into new container
+  // chain the containers without copying them
   if (validPxlBrlLow) 
-    thePxlBrlHits.insert(thePxlBrlHits.end(),PxlBrlLowContainer->begin(),
-			 PxlBrlLowContainer->end());
+    thePxlBrlHits.add(*PxlBrlLowContainer);
   if(validPxlBrlHigh)
-    thePxlBrlHits.insert(thePxlBrlHits.end(),PxlBrlHighContainer->begin(),
-			 PxlBrlHighContainer->end());
+    thePxlBrlHits.add(*PxlBrlHighContainer);
 
-  // cycle through new container
-  int i = 0, j = 0;
-  for (itHit = thePxlBrlHits.begin(); itHit != thePxlBrlHits.end(); ++itHit) {
-    
-    ++i;
-    
-    // create a DetId from the detUnitId
-    DetId theDetUnitId(itHit->detUnitId());
-    int detector = theDetUnitId.det();
-    int subdetector = theDetUnitId.subdetId();
-    
-    // check that expected detector is returned
-    if ((detector == dTrk) && (subdetector == sdPxlBrl)) {
-      
-      // get the GeomDetUnit from the geometry using theDetUnitID
-      const GeomDetUnit *theDet = theTracker.idToDetUnit(theDetUnitId);
-      
-      if (!theDet) {
-	edm::LogWarning(MsgLoggerCat)
-	  << "Unable to get GeomDetUnit from PxlBrlHits for Hit " << i;
-	continue;
-      }
-      
-      ++j;
-      
-      // get the Surface of the hit (knows how to go from local <-> global)
-      const BoundPlane& bSurface = theDet->surface();
-      
-      if(meTrackerPxBToF) meTrackerPxBToF->Fill(itHit->tof());
-      if(meTrackerPxBR) 
-	meTrackerPxBR->Fill(bSurface.toGlobal(itHit->localPosition()).perp());
-      if(meTrackerPxPhi) 
-	meTrackerPxPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-      if(meTrackerPxEta) 
-	meTrackerPxEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-      
-    } else {
-      edm::LogWarning(MsgLoggerCat)
-	<< "PxlBrl PSimHit " << i 
-	<< " is expected to be (det,subdet) = (" 
-	<< dTrk << "," << sdPxlBrl
-	<< "); value returned is: ("
-	<< detector << "," << subdetector << ")";
-      continue;
-    } // end detector type check
-  } // end loop through PxlBrl Hits
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::PxlBrl>
+    (thePxlBrlHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
   
-  if (verbosity > 1) {
-    eventout += "\n          Number of Pixel Barrel Hits collected:..... ";
-    eventout += j;
+  if (diag.counts()) {
+    eventout << "\n          Number of Pixel Barrel Hits collected:..... ";
+    eventout << j;
   }  
   
   nPxlHits += j;
@@ -1036,10 +1149,10 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   /////////////////////////////////
   // get Pixel Forward information
   ////////////////////////////////
-  edm::PSimHitContainer thePxlFwdHits;
+  GlobalHitsChainedRange<edm::PSimHitContainer> thePxlFwdHits;
   // extract low container
   edm::Handle<edm::PSimHitContainer> PxlFwdLowContainer;
-  iEvent.getByLabel(PxlFwdLowSrc_,PxlFwdLowContainer);
+  iEvent.getByToken(PxlFwdLowSrc_Token_,PxlFwdLowContainer);
   if (!PxlFwdLowContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsPixelEndcapLowTof in event!";
@@ -1047,70 +1160,26 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract high container
   edm::Handle<edm::PSimHitContainer> PxlFwdHighContainer;
-  iEvent.getByLabel(PxlFwdHighSrc_,PxlFwdHighContainer);
+  iEvent.getByToken(PxlFwdHighSrc_Token_,PxlFwdHighContainer);
   if (!PxlFwdHighContainer.isValid()) {
     LogDebug("GlobalHitsAnalyzer_fillTrk")
       << "Unable to find TrackerHitsPixelEndcapHighTof in event!";
     validPxlFwdHigh = false;
   }
-  // place both containers into new container
+  // chain the containers without copying them
   if (validPxlFwdLow)
-    thePxlFwdHits.insert(thePxlFwdHits.end(),PxlFwdLowContainer->begin(),
-			 PxlFwdLowContainer->end());
+    thePxlFwdHits.add(*PxlFwdLowContainer);
   if (validPxlFwdHigh)
-    thePxlFwdHits.insert(thePxlFwdHits.end(),PxlFwdHighContainer->begin(),
-			 PxlFwdHighContainer->end());
-
-  // cycle through new container
-  i = 0; j = 0;
-  for (itHit = thePxlFwdHits.begin(); itHit != thePxlFwdHits.end(); ++itHit) {
+    thePxlFwdHits.add(*PxlFwdHighContainer);
 
-    ++i;
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::PxlFwd>
+    (thePxlFwdHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
 
-    // create a DetId from the detUnitId
-    DetId theDetUnitId(itHit->detUnitId());
-    int detector = theDetUnitId.det();
-    int subdetector = theDetUnitId.subdetId();
-
-    // check that expected detector is returned
-    if ((detector == dTrk) && (subdetector == sdPxlFwd)) {
-
-      // get the GeomDetUnit from the geometry using theDetUnitID
-      const GeomDetUnit *theDet = theTracker.idToDetUnit(theDetUnitId);
-
-      if (!theDet) {
-	edm::LogWarning(MsgLoggerCat)
-	  << "Unable to get GeomDetUnit from PxlFwdHits for Hit " << i;;
-	continue;
-      }
-
-      ++j;
-
-      // get the Surface of the hit (knows how to go from local <-> global)
-      const BoundPlane& bSurface = theDet->surface();
-
-      if(meTrackerPxFToF) meTrackerPxFToF->Fill(itHit->tof());
-      if(meTrackerPxFZ) 
-	meTrackerPxFZ->Fill(bSurface.toGlobal(itHit->localPosition()).z());
-      if(meTrackerPxPhi) 
-	meTrackerPxPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-      if(meTrackerPxEta) 
-	meTrackerPxEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-
-    } else {
-      edm::LogWarning(MsgLoggerCat)
-	<< "PxlFwd PSimHit " << i 
-	<< " is expected to be (det,subdet) = (" 
-	<< dTrk << "," << sdPxlFwd
-	<< "); value returned is: ("
-	<< detector << "," << subdetector << ")";
-      continue;
-    } // end detector type check
-  } // end loop through PxlFwd Hits
-
-  if (verbosity > 1) {
-    eventout += "\n          Number of Pixel Forward Hits collected:.... ";
-    eventout += j;
+  if (diag.counts()) {
+    eventout << "\n          Number of Pixel Forward Hits collected:.... ";
+    eventout << j;
   }  
 
   nPxlHits += j;
@@ -1122,10 +1191,10 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   // get Silicon Barrel information
   //////////////////////////////////
   nSiHits = 0;
-  edm::PSimHitContainer theSiBrlHits;
+  GlobalHitsChainedRange<edm::PSimHitContainer> theSiBrlHits;
   // extract TIB low container
   edm::Handle<edm::PSimHitContainer> SiTIBLowContainer;
-  iEvent.getByLabel(SiTIBLowSrc_,SiTIBLowContainer);
+  iEvent.getByToken(SiTIBLowSrc_Token_,SiTIBLowContainer);
   if (!SiTIBLowContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTIBLowTof in event!";
@@ -1133,7 +1202,7 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract TIB high container
   edm::Handle<edm::PSimHitContainer> SiTIBHighContainer;
-  iEvent.getByLabel(SiTIBHighSrc_,SiTIBHighContainer);
+  iEvent.getByToken(SiTIBHighSrc_Token_,SiTIBHighContainer);
   if (!SiTIBHighContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTIBHighTof in event!";
@@ -1141,7 +1210,7 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract TOB low container
   edm::Handle<edm::PSimHitContainer> SiTOBLowContainer;
-  iEvent.getByLabel(SiTOBLowSrc_,SiTOBLowContainer);
+  iEvent.getByToken(SiTOBLowSrc_Token_,SiTOBLowContainer);
   if (!SiTOBLowContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTOBLowTof in event!";
@@ -1149,78 +1218,30 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract TOB high container
   edm::Handle<edm::PSimHitContainer> SiTOBHighContainer;
-  iEvent.getByLabel(SiTOBHighSrc_,SiTOBHighContainer);
+  iEvent.getByToken(SiTOBHighSrc_Token_,SiTOBHighContainer);
   if (!SiTOBHighContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTOBHighTof in event!";
     validSiTOBHigh = false;
   }
-  // place all containers into new container
+  // chain the containers without copying them
   if (validSiTIBLow)
-    theSiBrlHits.insert(theSiBrlHits.end(),SiTIBLowContainer->begin(),
-			SiTIBLowContainer->end());
+    theSiBrlHits.add(*SiTIBLowContainer);
   if (validSiTIBHigh)
-    theSiBrlHits.insert(theSiBrlHits.end(),SiTIBHighContainer->begin(),
-			SiTIBHighContainer->end());
+    theSiBrlHits.add(*SiTIBHighContainer);
   if (validSiTOBLow)
-    theSiBrlHits.insert(theSiBrlHits.end(),SiTOBLowContainer->begin(),
-			SiTOBLowContainer->end());
+    theSiBrlHits.add(*SiTOBLowContainer);
   if (validSiTOBHigh)
-    theSiBrlHits.insert(theSiBrlHits.end(),SiTOBHighContainer->begin(),
-			SiTOBHighContainer->end());
-
-  // cycle through new container
-  i = 0; j = 0;
-  for (itHit = theSiBrlHits.begin(); itHit != theSiBrlHits.end(); ++itHit) {
-
-    ++i;
-
-    // create a DetId from the detUnitId
-    DetId theDetUnitId(itHit->detUnitId());
-    int detector = theDetUnitId.det();
-    int subdetector = theDetUnitId.subdetId();
+    theSiBrlHits.add(*SiTOBHighContainer);
 
-    // check that expected detector is returned
-    if ((detector == dTrk) && 
-	((subdetector == sdSiTIB) ||
-	 (subdetector == sdSiTOB))) {
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::SiBrl>
+    (theSiBrlHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
 
-      // get the GeomDetUnit from the geometry using theDetUnitID
-      const GeomDetUnit *theDet = theTracker.idToDetUnit(theDetUnitId);
-
-      if (!theDet) {
-	edm::LogWarning(MsgLoggerCat)
-	  << "Unable to get GeomDetUnit from SiBrlHits for Hit " << i;
-	continue;
-      }
-
-      ++j;
-
-      // get the Surface of the hit (knows how to go from local <-> global)
-      const BoundPlane& bSurface = theDet->surface();
-
-      if(meTrackerSiBToF) meTrackerSiBToF->Fill(itHit->tof());
-      if(meTrackerSiBR) 
-	meTrackerSiBR->Fill(bSurface.toGlobal(itHit->localPosition()).perp());
-      if(meTrackerSiPhi) 
-	meTrackerSiPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-      if(meTrackerSiEta) 
-	meTrackerSiEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-
-    } else {
-      edm::LogWarning(MsgLoggerCat)
-	<< "SiBrl PSimHit " << i 
-	<< " is expected to be (det,subdet) = (" 
-	<< dTrk << "," << sdSiTIB
-	<< " || " << sdSiTOB << "); value returned is: ("
-	<< detector << "," << subdetector << ")";
-      continue;
-    } // end detector type check
-  } // end loop through SiBrl Hits
-
-  if (verbosity > 1) {
-    eventout += "\n          Number of Silicon Barrel Hits collected:... ";
-    eventout += j;
+  if (diag.counts()) {
+    eventout << "\n          Number of Silicon Barrel Hits collected:... ";
+    eventout << j;
   }  
 
   nSiHits += j;
@@ -1228,10 +1249,10 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   ///////////////////////////////////
   // get Silicon Forward information
   ///////////////////////////////////
-  edm::PSimHitContainer theSiFwdHits;
+  GlobalHitsChainedRange<edm::PSimHitContainer> theSiFwdHits;
   // extract TID low container
   edm::Handle<edm::PSimHitContainer> SiTIDLowContainer;
-  iEvent.getByLabel(SiTIDLowSrc_,SiTIDLowContainer);
+  iEvent.getByToken(SiTIDLowSrc_Token_,SiTIDLowContainer);
   if (!SiTIDLowContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTIDLowTof in event!";
@@ -1239,7 +1260,7 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract TID high container
   edm::Handle<edm::PSimHitContainer> SiTIDHighContainer;
-  iEvent.getByLabel(SiTIDHighSrc_,SiTIDHighContainer);
+  iEvent.getByToken(SiTIDHighSrc_Token_,SiTIDHighContainer);
   if (!SiTIDHighContainer.isValid()) {
     LogDebug("GlobalHitsAnalyzer_fillTrk")
       << "Unable to find TrackerHitsTIDHighTof in event!";
@@ -1247,7 +1268,7 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract TEC low container
   edm::Handle<edm::PSimHitContainer> SiTECLowContainer;
-  iEvent.getByLabel(SiTECLowSrc_,SiTECLowContainer);
+  iEvent.getByToken(SiTECLowSrc_Token_,SiTECLowContainer);
   if (!SiTECLowContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTECLowTof in event!";
@@ -1255,78 +1276,30 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   }
   // extract TEC high container
   edm::Handle<edm::PSimHitContainer> SiTECHighContainer;
-  iEvent.getByLabel(SiTECHighSrc_,SiTECHighContainer);
+  iEvent.getByToken(SiTECHighSrc_Token_,SiTECHighContainer);
   if (!SiTECHighContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find TrackerHitsTECHighTof in event!";
     validSiTECHigh = false;
   }
-  // place all containers into new container
+  // chain the containers without copying them
   if (validSiTIDLow)
-    theSiFwdHits.insert(theSiFwdHits.end(),SiTIDLowContainer->begin(),
-			SiTIDLowContainer->end());
+    theSiFwdHits.add(*SiTIDLowContainer);
   if (validSiTIDHigh)
-    theSiFwdHits.insert(theSiFwdHits.end(),SiTIDHighContainer->begin(),
-			SiTIDHighContainer->end());
+    theSiFwdHits.add(*SiTIDHighContainer);
   if (validSiTECLow)
-    theSiFwdHits.insert(theSiFwdHits.end(),SiTECLowContainer->begin(),
-			SiTECLowContainer->end());
+    theSiFwdHits.add(*SiTECLowContainer);
   if (validSiTECHigh)
-    theSiFwdHits.insert(theSiFwdHits.end(),SiTECHighContainer->begin(),
-			SiTECHighContainer->end());
-
-  // cycle through container
-  i = 0; j = 0;
-  for (itHit = theSiFwdHits.begin(); itHit != theSiFwdHits.end(); ++itHit) {
+    theSiFwdHits.add(*SiTECHighContainer);
 
-    ++i;
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::SiFwd>
+    (theSiFwdHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
 
-    // create a DetId from the detUnitId
-    DetId theDetUnitId(itHit->detUnitId());
-    int detector = theDetUnitId.det();
-    int subdetector = theDetUnitId.subdetId();
-
-    // check that expected detector is returned 
-    if ((detector == dTrk) && 
-	((subdetector == sdSiTID) ||
-	 (subdetector == sdSiTEC))) {
-      
-      // get the GeomDetUnit from the geometry using theDetUnitID
-      const GeomDetUnit *theDet = theTracker.idToDetUnit(theDetUnitId);
-      
-      if (!theDet) {
-	edm::LogWarning(MsgLoggerCat)
-	  << "Unable to get GeomDetUnit from SiFwdHits Hit " << i;
-	return;
-      }
-      
-      ++j;
-
-      // get the Surface of the hit (knows how to go from local <-> global)
-      const BoundPlane& bSurface = theDet->surface();
-      
-      if(meTrackerSiFToF) meTrackerSiFToF->Fill(itHit->tof());
-      if(meTrackerSiFZ) 
-	meTrackerSiFZ->Fill(bSurface.toGlobal(itHit->localPosition()).z());
-      if(meTrackerSiPhi) 
-	meTrackerSiPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-      if(meTrackerSiEta) 
-	meTrackerSiEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-
-    } else {
-      edm::LogWarning(MsgLoggerCat)
-	<< "SiFwd PSimHit " << i 
-	<< " is expected to be (det,subdet) = (" 
-	<< dTrk << "," << sdSiTOB
-	<< " || " << sdSiTEC << "); value returned is: ("
-	<< detector << "," << subdetector << ")";
-      continue;
-    } // end check detector type
-  } // end loop through SiFwd Hits
-
-  if (verbosity > 1) {
-    eventout += "\n          Number of Silicon Forward Hits collected:.. ";
-    eventout += j;
+  if (diag.counts()) {
+    eventout << "\n          Number of Silicon Forward Hits collected:.. ";
+    eventout << j;
   }  
 
   nSiHits +=j;
@@ -1334,8 +1307,7 @@ void GlobalHitsAnalyzer::fillTrk(const edm::Event& iEvent,
   if (meTrackerSi[0]) meTrackerSi[0]->Fill((float)nSiHits);
   if (meTrackerSi[1]) meTrackerSi[1]->Fill((float)nSiHits); 
 
-  if (verbosity > 0)
-    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  eventout.log(MsgLoggerCat);
 
   return;
 }
@@ -1346,12 +1318,8 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
   nMuonHits = 0;
   std::string MsgLoggerCat = "GlobalHitsAnalyzer_fillMuon";
 
-  TString eventout;
-  if (verbosity > 0)
-    eventout = "\nGathering info:";  
-
-  // iterator to access containers
-  edm::PSimHitContainer::const_iterator itHit;
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
 
   ///////////////////////
   // access the CSC Muon
@@ -1364,11 +1332,15 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
       << "Unable to find MuonGeometryRecord for the CSCGeometry in event!";
     return;
   }
-  const CSCGeometry& theCSCMuon(*theCSCGeometry);
+  if (theCSCCache.
+      update(iSetup.get<MuonGeometryRecord>().cacheIdentifier(),
+	     *theCSCGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theCSCCache.size() << " CSC DetUnits";
 
   // get Muon CSC information
   edm::Handle<edm::PSimHitContainer> MuonCSCContainer;
-  iEvent.getByLabel(MuonCscSrc_,MuonCSCContainer);
+  iEvent.getByToken(MuonCscSrc_Token_,MuonCSCContainer);
   if (!MuonCSCContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find MuonCSCHits in event!";
@@ -1376,59 +1348,14 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
   }
 
   if (validMuonCSC) {
-    // cycle through container
-    int i = 0, j = 0;
-    for (itHit = MuonCSCContainer->begin(); itHit != MuonCSCContainer->end(); 
-	 ++itHit) {
-      
-      ++i;
-      
-      // create a DetId from the detUnitId
-      DetId theDetUnitId(itHit->detUnitId());
-      int detector = theDetUnitId.det();
-      int subdetector = theDetUnitId.subdetId();
-      
-      // check that expected detector is returned
-      if ((detector == dMuon) && 
-	  (subdetector == sdMuonCSC)) {
-	
-	// get the GeomDetUnit from the geometry using theDetUnitID
-	const GeomDetUnit *theDet = theCSCMuon.idToDetUnit(theDetUnitId);
-	
-	if (!theDet) {
-	  edm::LogWarning(MsgLoggerCat)
-	    << "Unable to get GeomDetUnit from theCSCMuon for hit " << i;
-	  continue;
-	}
-	
-	++j;
-	
-	// get the Surface of the hit (knows how to go from local <-> global)
-	const BoundPlane& bSurface = theDet->surface();
-	
-	if (meMuonCscToF[0]) meMuonCscToF[0]->Fill(itHit->tof());
-	if (meMuonCscToF[1]) meMuonCscToF[1]->Fill(itHit->tof());
-	if (meMuonCscZ) 
-	  meMuonCscZ->Fill(bSurface.toGlobal(itHit->localPosition()).z());
-	if (meMuonPhi)
-	  meMuonPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-	if (meMuonEta)
-	  meMuonEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-	
-      } else {
-	edm::LogWarning(MsgLoggerCat)
-	  << "MuonCsc PSimHit " << i 
-	  << " is expected to be (det,subdet) = (" 
-	  << dMuon << "," << sdMuonCSC
-	  << "); value returned is: ("
-	  << detector << "," << subdetector << ")";
-	continue;
-      } // end detector type check
-    } // end loop through CSC Hits
+    // stage the hits, transform them to global coordinates grouped by
+    // DetUnit, derive R/Z, phi and eta and fill the histograms
+    int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonCsc>
+      (*MuonCSCContainer, theCSCCache, SimHits, theSink, MsgLoggerCat);
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of CSC muon Hits collected:......... ";
-      eventout += j;
+    if (diag.counts()) {
+      eventout << "\n          Number of CSC muon Hits collected:......... ";
+      eventout << j;
     }  
 
     nMuonHits += j;
@@ -1445,11 +1372,15 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
       << "Unable to find MuonGeometryRecord for the DTGeometry in event!";
     return;
   }
-  const DTGeometry& theDTMuon(*theDTGeometry);
+  if (theDTCache.
+      update(iSetup.get<MuonGeometryRecord>().cacheIdentifier(),
+	     *theDTGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theDTCache.size() << " DT DetUnits";
 
   // get Muon DT information
   edm::Handle<edm::PSimHitContainer> MuonDtContainer;
-  iEvent.getByLabel(MuonDtSrc_,MuonDtContainer);
+  iEvent.getByToken(MuonDtSrc_Token_,MuonDtContainer);
   if (!MuonDtContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find MuonDTHits in event!";
@@ -1457,63 +1388,14 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
   }
 
   if (validMuonDt) {
-    // cycle through container
-    int i = 0, j = 0;
-    for (itHit = MuonDtContainer->begin(); itHit != MuonDtContainer->end(); 
-	 ++itHit) {
-      
-      ++i;
-      
-      // create a DetId from the detUnitId
-      DetId theDetUnitId(itHit->detUnitId());
-      int detector = theDetUnitId.det();
-      int subdetector = theDetUnitId.subdetId();
-      
-      // check that expected detector is returned
-      if ((detector == dMuon) && 
-	  (subdetector == sdMuonDT)) {
-	
-	// CSC uses wires and layers rather than the full detID
-	// get the wireId
-	DTWireId wireId(itHit->detUnitId());
-	
-	// get the DTLayer from the geometry using the wireID
-	const DTLayer *theDet = theDTMuon.layer(wireId.layerId());
-	
-	if (!theDet) {
-	  edm::LogWarning(MsgLoggerCat)
-	    << "Unable to get GeomDetUnit from theDtMuon for hit " << i;
-	  continue;
-	}
-	
-	++j;
-	
-	// get the Surface of the hit (knows how to go from local <-> global)
-	const BoundPlane& bSurface = theDet->surface();
-	
-	if (meMuonDtToF[0]) meMuonDtToF[0]->Fill(itHit->tof());
-	if (meMuonDtToF[1]) meMuonDtToF[1]->Fill(itHit->tof());
-	if (meMuonDtR) 
-	  meMuonDtR->Fill(bSurface.toGlobal(itHit->localPosition()).perp());
-	if (meMuonPhi)
-	  meMuonPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-	if (meMuonEta)
-	  meMuonEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-	
-      } else {
-	edm::LogWarning(MsgLoggerCat)
-	  << "MuonDt PSimHit " << i 
-	  << " is expected to be (det,subdet) = (" 
-	  << dMuon << "," << sdMuonDT
-	  << "); value returned is: ("
-	  << detector << "," << subdetector << ")";
-	continue;
-      } // end detector type check
-    } // end loop through DT Hits
+    // stage the hits, transform them to global coordinates grouped by
+    // DetUnit, derive R/Z, phi and eta and fill the histograms
+    int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonDt>
+      (*MuonDtContainer, theDTCache, SimHits, theSink, MsgLoggerCat);
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of DT muon Hits collected:.......... ";
-      eventout += j;
+    if (diag.counts()) {
+      eventout << "\n          Number of DT muon Hits collected:.......... ";
+      eventout << j;
     } 
     
     nMuonHits += j;
@@ -1531,11 +1413,15 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
       << "Unable to find MuonGeometryRecord for the RPCGeometry in event!";
     return;
   }
-  const RPCGeometry& theRPCMuon(*theRPCGeometry);
+  if (theRPCCache.
+      update(iSetup.get<MuonGeometryRecord>().cacheIdentifier(),
+	     *theRPCGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theRPCCache.size() << " RPC DetUnits";
 
   // get Muon RPC information
   edm::Handle<edm::PSimHitContainer> MuonRPCContainer;
-  iEvent.getByLabel(MuonRpcSrc_,MuonRPCContainer);
+  iEvent.getByToken(MuonRpcSrc_Token_,MuonRPCContainer);
   if (!MuonRPCContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find MuonRPCHits in event!";
@@ -1543,92 +1429,18 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
   }
 
   if (validMuonRPC) {
-    // cycle through container
-    int i = 0, j = 0;
-    int RPCBrl =0, RPCFwd = 0;
-    for (itHit = MuonRPCContainer->begin(); itHit != MuonRPCContainer->end(); 
-	 ++itHit) {
-      
-      ++i;
-      
-      // create a DetID from the detUnitId
-      DetId theDetUnitId(itHit->detUnitId());
-      int detector = theDetUnitId.det();
-      int subdetector = theDetUnitId.subdetId();
-      
-      // check that expected detector is returned
-      if ((detector == dMuon) && 
-	  (subdetector == sdMuonRPC)) {
-	
-	// get an RPCDetID from the detUnitID
-	RPCDetId RPCId(itHit->detUnitId());      
-	
-	// find the region of the RPC hit
-	int region = RPCId.region();
-	
-	// get the GeomDetUnit from the geometry using the RPCDetId
-	const GeomDetUnit *theDet = theRPCMuon.idToDetUnit(theDetUnitId);
-	
-	if (!theDet) {
-	  edm::LogWarning(MsgLoggerCat)
-	    << "Unable to get GeomDetUnit from theRPCMuon for hit " << i;
-	  continue;
-	}
-	
-	++j;
-	
-	// get the Surface of the hit (knows how to go from local <-> global)
-	const BoundPlane& bSurface = theDet->surface();
-	
-	// gather necessary information
-	if ((region == sdMuonRPCRgnFwdp) || (region == sdMuonRPCRgnFwdn)) {
-	  ++RPCFwd;
-	  
-	  if (meMuonRpcFToF[0]) meMuonRpcFToF[0]->Fill(itHit->tof());
-	  if (meMuonRpcFToF[1]) meMuonRpcFToF[1]->Fill(itHit->tof());
-	  if (meMuonRpcFZ) 
-	    meMuonRpcFZ->Fill(bSurface.toGlobal(itHit->localPosition()).z());
-	  if (meMuonPhi)
-	    meMuonPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-	  if (meMuonEta)
-	    meMuonEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-	  
-	} else if (region == sdMuonRPCRgnBrl) {
-	  ++RPCBrl;
-	  
-	  if (meMuonRpcBToF[0]) meMuonRpcBToF[0]->Fill(itHit->tof());
-	  if (meMuonRpcBToF[1]) meMuonRpcBToF[1]->Fill(itHit->tof());
-	  if (meMuonRpcBR) 
-	    meMuonRpcBR->Fill(bSurface.toGlobal(itHit->
-						localPosition()).perp());
-	  if (meMuonPhi)
-	    meMuonPhi->Fill(bSurface.toGlobal(itHit->localPosition()).phi());
-	  if (meMuonEta)
-	    meMuonEta->Fill(bSurface.toGlobal(itHit->localPosition()).eta());
-	  
-	} else {
-	  edm::LogWarning(MsgLoggerCat)
-	    << "Invalid region for RPC Muon hit" << i;
-	  continue;
-	} // end check of region
-      } else {
-	edm::LogWarning(MsgLoggerCat)
-	  << "MuonRpc PSimHit " << i 
-	  << " is expected to be (det,subdet) = (" 
-        << dMuon << "," << sdMuonRPC
-	  << "); value returned is: ("
-	  << detector << "," << subdetector << ")";
-	continue;
-      } // end detector type check
-    } // end loop through RPC Hits
+    // stage the hits, transform them to global coordinates grouped by
+    // DetUnit, derive R/Z, phi and eta and fill the histograms
+    int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonRpc>
+      (*MuonRPCContainer, theRPCCache, SimHits, theSink, MsgLoggerCat);
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of RPC muon Hits collected:......... ";
-      eventout += j;
-      eventout += "\n                    RPC Barrel muon Hits:............ ";
-      eventout += RPCBrl;
-      eventout += "\n                    RPC Forward muon Hits:........... ";
-      eventout += RPCFwd;    
+    if (diag.counts()) {
+      eventout << "\n          Number of RPC muon Hits collected:......... ";
+      eventout << j;
+      eventout << "\n                    RPC Barrel muon Hits:............ ";
+      eventout << SimHits[GlobalHitsColumns::MuonRpcBrl].size();
+      eventout << "\n                    RPC Forward muon Hits:........... ";
+      eventout << SimHits[GlobalHitsColumns::MuonRpcFwd].size();
     }  
     
     nMuonHits += j;
@@ -1637,8 +1449,7 @@ void GlobalHitsAnalyzer::fillMuon(const edm::Event& iEvent,
   if (meMuon[0]) meMuon[0]->Fill((float)nMuonHits);
   if (meMuon[1]) meMuon[1]->Fill((float)nMuonHits); 
   
-  if (verbosity > 0)
-    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  eventout.log(MsgLoggerCat);
   
   return;
 }
@@ -1648,9 +1459,8 @@ void GlobalHitsAnalyzer::fillECal(const edm::Event& iEvent,
 {
   std::string MsgLoggerCat = "GlobalHitsAnalyzer_fillECal";
 
-  TString eventout;
-  if (verbosity > 0)
-    eventout = "\nGathering info:";  
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
   
   // access the calorimeter geometry
   edm::ESHandle<CaloGeometry> theCaloGeometry;
@@ -1660,18 +1470,19 @@ void GlobalHitsAnalyzer::fillECal(const edm::Event& iEvent,
       << "Unable to find CaloGeometryRecord in event!";
     return;
   }
-  const CaloGeometry& theCalo(*theCaloGeometry);
+  if (theCaloCache.
+      update(iSetup.get<CaloGeometryRecord>().cacheIdentifier(),
+	     *theCaloGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached " << theCaloCache.size() << " calorimeter cells";
     
-  // iterator to access containers
-  edm::PCaloHitContainer::const_iterator itHit;
-
   ///////////////////////////////
   // get  ECal information
   ///////////////////////////////
-  edm::PCaloHitContainer theECalHits;
+  GlobalHitsChainedRange<edm::PCaloHitContainer> theECalHits;
   // extract EB container
   edm::Handle<edm::PCaloHitContainer> EBContainer;
-  iEvent.getByLabel(ECalEBSrc_,EBContainer);			     
+  iEvent.getByToken(ECalEBSrc_Token_,EBContainer);			     
   if (!EBContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find EcalHitsEB in event!";
@@ -1679,72 +1490,26 @@ void GlobalHitsAnalyzer::fillECal(const edm::Event& iEvent,
   }
   // extract EE container
   edm::Handle<edm::PCaloHitContainer> EEContainer;
-  iEvent.getByLabel(ECalEESrc_,EEContainer);
+  iEvent.getByToken(ECalEESrc_Token_,EEContainer);
   if (!EEContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find EcalHitsEE in event!";
     validEE = false;
   }
-  // place both containers into new container
+  // chain the containers without copying them
   if (validEB)
-    theECalHits.insert(theECalHits.end(),EBContainer->begin(),
-		       EBContainer->end());
+    theECalHits.add(*EBContainer);
   if (validEE)
-    theECalHits.insert(theECalHits.end(),EEContainer->begin(),
-		       EEContainer->end());
-
-  // cycle through new container
-  int i = 0, j = 0;
-  for (itHit = theECalHits.begin(); itHit != theECalHits.end(); ++itHit) {
-
-    ++i;
-
-    // create a DetId from the detUnitId
-    DetId theDetUnitId(itHit->id());
-    int detector = theDetUnitId.det();
-    int subdetector = theDetUnitId.subdetId();
-
-    // check that expected detector is returned
-    if ((detector == dEcal) && 
-	((subdetector == sdEcalBrl) ||
-	 (subdetector == sdEcalFwd))) {
-
-      // get the Cell geometry
-      const CaloCellGeometry *theDet = theCalo.
-	getSubdetectorGeometry(theDetUnitId)->getGeometry(theDetUnitId);
+    theECalHits.add(*EEContainer);
 
-      if (!theDet) {
-	edm::LogWarning(MsgLoggerCat)
-	  << "Unable to get CaloCellGeometry from ECalHits for Hit " << i;
-	continue;
-      }
+  // stage the hits with the phi and eta of their cells and fill the
+  // histograms
+  int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::ECal>
+    (theECalHits, theCaloCache, SimHits, theSink, MsgLoggerCat);
 
-      ++j;
-
-      // get the global position of the cell
-      const GlobalPoint& globalposition = theDet->getPosition();
-
-      if (meCaloEcalE[0]) meCaloEcalE[0]->Fill(itHit->energy());
-      if (meCaloEcalE[1]) meCaloEcalE[1]->Fill(itHit->energy());
-      if (meCaloEcalToF[0]) meCaloEcalToF[0]->Fill(itHit->time());
-      if (meCaloEcalToF[1]) meCaloEcalToF[1]->Fill(itHit->time());
-      if (meCaloEcalPhi) meCaloEcalPhi->Fill(globalposition.phi());
-      if (meCaloEcalEta) meCaloEcalEta->Fill(globalposition.eta());
-
-    } else {
-      edm::LogWarning(MsgLoggerCat)
-	<< "ECal PCaloHit " << i 
-	<< " is expected to be (det,subdet) = (" 
-	<< dEcal << "," << sdEcalBrl
-	<< " || " << sdEcalFwd << "); value returned is: ("
-	<< detector << "," << subdetector << ")";
-      continue;
-    } // end detector type check
-  } // end loop through ECal Hits
-
-  if (verbosity > 1) {
-    eventout += "\n          Number of ECal Hits collected:............. ";
-    eventout += j;
+  if (diag.counts()) {
+    eventout << "\n          Number of ECal Hits collected:............. ";
+    eventout << j;
   }  
 
   if (meCaloEcal[0]) meCaloEcal[0]->Fill((float)j);
@@ -1755,7 +1520,7 @@ void GlobalHitsAnalyzer::fillECal(const edm::Event& iEvent,
   ////////////////////////////
   // extract PreShower container
   edm::Handle<edm::PCaloHitContainer> PreShContainer;
-  iEvent.getByLabel(ECalESSrc_,PreShContainer);
+  iEvent.getByToken(ECalESSrc_Token_,PreShContainer);
   if (!PreShContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find EcalHitsES in event!";
@@ -1763,67 +1528,24 @@ void GlobalHitsAnalyzer::fillECal(const edm::Event& iEvent,
   }
 
   if (validPresh) {
-    // cycle through container
-    int i = 0, j = 0;
-    for (itHit = PreShContainer->begin(); 
-	 itHit != PreShContainer->end(); ++itHit) {
-      
-      ++i;
-      
-      // create a DetId from the detUnitId
-      DetId theDetUnitId(itHit->id());
-      int detector = theDetUnitId.det();
-      int subdetector = theDetUnitId.subdetId();
-      
-      // check that expected detector is returned
-      if ((detector == dEcal) && 
-	  (subdetector == sdEcalPS)) {
-	
-	// get the Cell geometry
-	const CaloCellGeometry *theDet = theCalo.
-	  getSubdetectorGeometry(theDetUnitId)->getGeometry(theDetUnitId);
-	
-	if (!theDet) {
-	  edm::LogWarning(MsgLoggerCat)
-	    << "Unable to get CaloCellGeometry from PreShContainer for Hit " 
-	    << i;
-	  continue;
-	}
-	
-	++j;
-	
-	// get the global position of the cell
-	const GlobalPoint& globalposition = theDet->getPosition();
-	
-	if (meCaloPreShE[0]) meCaloPreShE[0]->Fill(itHit->energy());
-	if (meCaloPreShE[1]) meCaloPreShE[1]->Fill(itHit->energy());
-	if (meCaloPreShToF[0]) meCaloPreShToF[0]->Fill(itHit->time());
-	if (meCaloPreShToF[1]) meCaloPreShToF[1]->Fill(itHit->time());
-	if (meCaloPreShPhi) meCaloPreShPhi->Fill(globalposition.phi());
-	if (meCaloPreShEta) meCaloPreShEta->Fill(globalposition.eta());
-	
-      } else {
-	edm::LogWarning(MsgLoggerCat)
-	  << "PreSh PCaloHit " << i 
-	  << " is expected to be (det,subdet) = (" 
-	  << dEcal << "," << sdEcalPS
-	  << "); value returned is: ("
-	  << detector << "," << subdetector << ")";
-	continue;
-      } // end detector type check
-    } // end loop through PreShower Hits
+    GlobalHitsChainedRange<edm::PCaloHitContainer> thePreShHits;
+    thePreShHits.add(*PreShContainer);
+
+    // stage the hits with the phi and eta of their cells and fill the
+    // histograms
+    int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::PreSh>
+      (thePreShHits, theCaloCache, SimHits, theSink, MsgLoggerCat);
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of PreSh Hits collected:............ ";
-      eventout += j;
+    if (diag.counts()) {
+      eventout << "\n          Number of PreSh Hits collected:............ ";
+      eventout << j;
     }  
     
     if (meCaloPreSh[0]) meCaloPreSh[0]->Fill((float)j);
     if (meCaloPreSh[1]) meCaloPreSh[1]->Fill((float)j); 
   }
   
-  if (verbosity > 0)
-    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  eventout.log(MsgLoggerCat);
   
   return;
 }
@@ -1833,9 +1555,8 @@ void GlobalHitsAnalyzer::fillHCal(const edm::Event& iEvent,
 {
   std::string MsgLoggerCat = "GlobalHitsAnalyzer_fillHCal";
 
-  TString eventout;
-  if (verbosity > 0)
-    eventout = "\nGathering info:";  
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
   
   // access the calorimeter geometry
   edm::ESHandle<CaloGeometry> theCaloGeometry;
@@ -1845,17 +1566,18 @@ void GlobalHitsAnalyzer::fillHCal(const edm::Event& iEvent,
       << "Unable to find CaloGeometryRecord in event!";
     return;
   }
-  const CaloGeometry& theCalo(*theCaloGeometry);
+  if (theCaloCache.
+      update(iSetup.get<CaloGeometryRecord>().cacheIdentifier(),
+	     *theCaloGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached " << theCaloCache.size() << " calorimeter cells";
     
-  // iterator to access containers
-  edm::PCaloHitContainer::const_iterator itHit;
-
   ///////////////////////////////
   // get  HCal information
   ///////////////////////////////
   // extract HCal container
   edm::Handle<edm::PCaloHitContainer> HCalContainer;
-  iEvent.getByLabel(HCalSrc_,HCalContainer);
+  iEvent.getByToken(HCalSrc_Token_,HCalContainer);
   if (!HCalContainer.isValid()) {
     LogDebug(MsgLoggerCat)
       << "Unable to find HCalHits in event!";
@@ -1863,71 +1585,21 @@ void GlobalHitsAnalyzer::fillHCal(const edm::Event& iEvent,
   }
 
   if (validHcal) {
-    // cycle through container
-    int i = 0, j = 0;
-    for (itHit = HCalContainer->begin(); 
-	 itHit != HCalContainer->end(); ++itHit) {
-      
-      ++i;
-      
-      // create a DetId from the detUnitId
-      DetId theDetUnitId(itHit->id());
-      int detector = theDetUnitId.det();
-      int subdetector = theDetUnitId.subdetId();
-      
-      // check that expected detector is returned
-      if ((detector == dHcal) && 
-	  ((subdetector == sdHcalBrl) ||
-	   (subdetector == sdHcalEC) ||
-	   (subdetector == sdHcalOut) ||
-	   (subdetector == sdHcalFwd))) {
-	
-	// get the Cell geometry
-	const CaloCellGeometry *theDet = theCalo.
-	  getSubdetectorGeometry(theDetUnitId)->getGeometry(theDetUnitId);
-	
-	if (!theDet) {
-	  edm::LogWarning(MsgLoggerCat)
-	    << "Unable to get CaloCellGeometry from HCalContainer for Hit " 
-	    << i;
-	  continue;
-	}
-	
-	++j;
-	
-	// get the global position of the cell
-	const GlobalPoint& globalposition = theDet->getPosition();
-	
-	if (meCaloHcalE[0]) meCaloHcalE[0]->Fill(itHit->energy());
-	if (meCaloHcalE[1]) meCaloHcalE[1]->Fill(itHit->energy());
-	if (meCaloHcalToF[0]) meCaloHcalToF[0]->Fill(itHit->time());
-	if (meCaloHcalToF[1]) meCaloHcalToF[1]->Fill(itHit->time());
-	if (meCaloHcalPhi) meCaloHcalPhi->Fill(globalposition.phi());
-	if (meCaloHcalEta) meCaloHcalEta->Fill(globalposition.eta());
-	
-      } else {
-	edm::LogWarning(MsgLoggerCat)
-	  << "HCal PCaloHit " << i 
-	  << " is expected to be (det,subdet) = (" 
-	  << dHcal << "," << sdHcalBrl
-	  << " || " << sdHcalEC << " || " << sdHcalOut << " || " << sdHcalFwd
-	  << "); value returned is: ("
-	  << detector << "," << subdetector << ")";
-	continue;
-      } // end detector type check
-    } // end loop through HCal Hits
+    // stage the hits with the phi and eta of their cells and fill the
+    // histograms
+    int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::HCal>
+      (*HCalContainer, theCaloCache, SimHits, theSink, MsgLoggerCat);
     
-    if (verbosity > 1) {
-      eventout += "\n          Number of HCal Hits collected:............. ";
-      eventout += j;
+    if (diag.counts()) {
+      eventout << "\n          Number of HCal Hits collected:............. ";
+      eventout << j;
     }  
     
     if (meCaloHcal[0]) meCaloHcal[0]->Fill((float)j);
     if (meCaloHcal[1]) meCaloHcal[1]->Fill((float)j); 
   }
 
-  if (verbosity > 0)
-    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  eventout.log(MsgLoggerCat);
   
   return;
 }
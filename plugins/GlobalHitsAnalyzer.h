@@ -5,15 +5,37 @@
  *  
  *  Class to fill dqm monitor elements from existing EDM file
  *
+ *  Runs as a stream DQMEDAnalyzer: every stream books and fills its own
+ *  monitor elements and the DQM framework merges them at the end of run.
+ *
+ *  The hit loops are the ones of GlobalHitsEngine, shared with the
+ *  GlobalHitsProducer; the histograms of every block are filled from its
+ *  columns by a GlobalHitsHistSink.
+ *
+ *  With Timing = true the wall and CPU time and the hits of every fill
+ *  stage are summed per stream. At the end of each run they are added to
+ *  the GlobalHitsV/Timing monitor elements, which the DQM framework sums
+ *  over the streams (hits/s is the ratio of hStageHits and hStageWall),
+ *  and endStream reports the totals of the stream as hits per second.
+ *
+ *  Only the histograms of the subsystems in Subsystems are booked and
+ *  filled.
+ *
+ *  With Sampling set, the hit histograms are filled from a seeded random
+ *  subset of the hits of each block (see GlobalHitsSampler), weighted to
+ *  the full number of hits; the hit count histograms are estimated from
+ *  the sampled hits and stay exact unless sampled hits are rejected.
+ *
  *  $Date: 2010/01/06 14:24:50 $
  *  $Revision: 1.13 $
  *  \author M. Strang SUNY-Buffalo
  */
 
 // framework & common header files
-#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "DQMServices/Core/interface/DQMEDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "DataFormats/Common/interface/Handle.h"
 #include "FWCore/Framework/interface/ESHandle.h"
@@ -22,8 +44,18 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
 #include "Geometry/CommonDetUnit/interface/GeomDetUnit.h"
 #include "DataFormats/DetId/interface/DetId.h"
+#include "Validation/GlobalHits/interface/GlobalHitsChainedRange.h"
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+#include "Validation/GlobalHits/interface/GlobalHitsGeometryCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCaloCellCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsEngine.h"
+#include "Validation/GlobalHits/interface/GlobalHitsStageTimes.h"
+#include "Validation/GlobalHits/interface/GlobalHitsDiagnostics.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSubsystems.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSampler.h"
 
 //DQM services
 #include "DQMServices/Core/interface/DQMStore.h"
@@ -72,7 +104,7 @@
 #include "TString.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
-class GlobalHitsAnalyzer : public edm::EDAnalyzer
+class GlobalHitsAnalyzer : public DQMEDAnalyzer
 {
   
  public:
@@ -81,9 +113,11 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
 
   explicit GlobalHitsAnalyzer(const edm::ParameterSet&);
   virtual ~GlobalHitsAnalyzer();
-  virtual void beginJob( void );
-  virtual void endJob();  
-  virtual void analyze(const edm::Event&, const edm::EventSetup&);
+  virtual void bookHistograms(DQMStore::IBooker&, const edm::Run&,
+			      const edm::EventSetup&) override;
+  virtual void endRun(const edm::Run&, const edm::EventSetup&) override;
+  virtual void endStream() override;
+  virtual void analyze(const edm::Event&, const edm::EventSetup&) override;
   
  private:
 
@@ -93,18 +127,21 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   void fillMuon(const edm::Event&, const edm::EventSetup&);
   void fillECal(const edm::Event&, const edm::EventSetup&);
   void fillHCal(const edm::Event&, const edm::EventSetup&);
-
+  void countStageHits(const edm::Event&);
 
  private:
 
   //  parameter information
   std::string fName;
   int verbosity;
+  GlobalHitsDiagnostics diag;    // per event output of fill and store
   int frequency;
   int vtxunit;
   std::string label;
   bool getAllProvenances;
   bool printProvenanceInfo;
+  GlobalHitsSubsystems subsystems;
+  GlobalHitsSampler sampler;
 
   bool validHepMCevt;
   bool validG4VtxContainer;
@@ -129,8 +166,6 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   bool validPresh;
   bool validHcal;
 
-  DQMStore *dbe;
-
   // G4MC info
   MonitorElement *meMCRGP[2];
   MonitorElement *meMCG4Vtx[2];
@@ -146,8 +181,12 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meGeantVtxMulti;
   int nRawGenPart;  
 
+  edm::InputTag HepMCSrc_;
+  edm::EDGetTokenT<edm::HepMCProduct> HepMCSrc_Token_;
   edm::InputTag G4VtxSrc_;
+  edm::EDGetTokenT<edm::SimVertexContainer> G4VtxSrc_Token_;
   edm::InputTag G4TrkSrc_;
+  edm::EDGetTokenT<edm::SimTrackContainer> G4TrkSrc_Token_;
 
   // Electromagnetic info
   // ECal info
@@ -157,7 +196,9 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meCaloEcalPhi;
   MonitorElement *meCaloEcalEta;  
   edm::InputTag ECalEBSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalEBSrc_Token_;
   edm::InputTag ECalEESrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalEESrc_Token_;
 
   // Preshower info
   MonitorElement *meCaloPreSh[2];
@@ -166,6 +207,7 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meCaloPreShPhi;
   MonitorElement *meCaloPreShEta;
   edm::InputTag ECalESSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalESSrc_Token_;
 
   // Hadronic info
   // HCal info
@@ -175,6 +217,7 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meCaloHcalPhi;
   MonitorElement *meCaloHcalEta;  
   edm::InputTag HCalSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> HCalSrc_Token_;
 
   // Tracker info
   // Pixel info
@@ -187,9 +230,13 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meTrackerPxFToF;
   MonitorElement *meTrackerPxFZ;
   edm::InputTag PxlBrlLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlBrlLowSrc_Token_;
   edm::InputTag PxlBrlHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlBrlHighSrc_Token_;
   edm::InputTag PxlFwdLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlFwdLowSrc_Token_;
   edm::InputTag PxlFwdHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlFwdHighSrc_Token_;
 
   // Strip info
   int nSiHits;
@@ -201,13 +248,21 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meTrackerSiFToF;
   MonitorElement *meTrackerSiFZ;
   edm::InputTag SiTIBLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIBLowSrc_Token_;
   edm::InputTag SiTIBHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIBHighSrc_Token_;
   edm::InputTag SiTOBLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTOBLowSrc_Token_;
   edm::InputTag SiTOBHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTOBHighSrc_Token_;
   edm::InputTag SiTIDLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIDLowSrc_Token_;
   edm::InputTag SiTIDHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIDHighSrc_Token_;
   edm::InputTag SiTECLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTECLowSrc_Token_;
   edm::InputTag SiTECHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTECHighSrc_Token_;
 
   // Muon info
   MonitorElement *meMuon[2];
@@ -219,20 +274,45 @@ class GlobalHitsAnalyzer : public edm::EDAnalyzer
   MonitorElement *meMuonDtToF[2];
   MonitorElement *meMuonDtR;
   edm::InputTag MuonDtSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonDtSrc_Token_;
   // CSC info
   MonitorElement *meMuonCscToF[2];
   MonitorElement *meMuonCscZ;
   edm::InputTag MuonCscSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonCscSrc_Token_;
   // RPC info
   MonitorElement *meMuonRpcFToF[2];
   MonitorElement *meMuonRpcFZ;
   MonitorElement *meMuonRpcBToF[2];
   MonitorElement *meMuonRpcBR;
   edm::InputTag MuonRpcSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonRpcSrc_Token_;
 
-  // private statistics information
+  // private statistics information, per stream
   unsigned int count;
 
+  // staged hit positions, turned into R/Z, phi and eta per block
+  GlobalHitsColumns SimHits;
+
+  // DetUnit frames, rebuilt when the geometry records change
+  GlobalHitsGeometryCache theTrkCache;
+  GlobalHitsGeometryCache theCSCCache;
+  GlobalHitsGeometryCache theDTCache;
+  GlobalHitsGeometryCache theRPCCache;
+
+  // calorimeter cells, rebuilt when the CaloGeometryRecord changes
+  GlobalHitsCaloCellCache theCaloCache;
+
+  // histograms filled from the columns of every block
+  GlobalHitsHistSink<MonitorElement> theSink;
+
+  // fill stage times of the current run and of all runs of this stream
+  GlobalHitsStageTimes stageTimes;
+  GlobalHitsStageTimes streamTimes;
+  MonitorElement *meStageWall;
+  MonitorElement *meStageCpu;
+  MonitorElement *meStageHits;
+
 }; // end class declaration
   
 #endif
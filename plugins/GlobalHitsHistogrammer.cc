@@ -7,12 +7,26 @@
  *  \author M. Strang SUNY-Buffalo
  */
 
-#include "Validation/GlobalHits/interface/GlobalHitsHistogrammer.h"
+#include "Validation/GlobalHits/plugins/GlobalHitsHistogrammer.h"
 #include "DQMServices/Core/interface/DQMStore.h"
 
+#include <algorithm>
+
+namespace {
+
+  // number of hits of a block before the producer kept n of them with
+  // weight w
+  int unsampled(int n, float w)
+  {
+    return int(n * w + 0.5f);
+  }
+}
+
 GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet) 
   : fName(""), verbosity(0), frequency(0), vtxunit(0), label(""), 
-  getAllProvenances(false), printProvenanceInfo(false), count(0)
+  getAllProvenances(false), printProvenanceInfo(false),
+  subsystems(iPSet, "GlobalHitsHistogrammer_GlobalHitsHistogrammer"),
+  count(0)
 {
   std::string MsgLoggerCat = "GlobalHitsHistogrammer_GlobalHitsHistogrammer";
 
@@ -21,8 +35,6 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
   verbosity = iPSet.getUntrackedParameter<int>("Verbosity");
   frequency = iPSet.getUntrackedParameter<int>("Frequency");
   vtxunit = iPSet.getUntrackedParameter<int>("VtxUnit");
-  outputfile = iPSet.getParameter<std::string>("OutputFile");
-  doOutput = iPSet.getParameter<bool>("DoOutput");
   edm::ParameterSet m_Prov =
     iPSet.getParameter<edm::ParameterSet>("ProvenanceLookup");
   getAllProvenances = 
@@ -32,6 +44,14 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
   //get Labels to use to extract information
   GlobalHitSrc_ = iPSet.getParameter<edm::InputTag>("GlobalHitSrc");
+  GlobalHitSrc_Token_ = consumes<PGlobalSimHit>(GlobalHitSrc_);
+  GlobalHitCompactSrc_Token_ =
+    mayConsume<GlobalHitsCompactHits>(GlobalHitSrc_);
+  GlobalHitWeights_Token_ =
+    mayConsume<std::vector<float> >(edm::InputTag(GlobalHitSrc_.label(),
+						  GlobalHitSrc_.instance() +
+						  "Weights",
+						  GlobalHitSrc_.process()));
 
   // use value of first digit to determine default output level (inclusive)
   // 0 is none, 1 is basic, 2 is fill output, 3 is gather output
@@ -41,35 +61,19 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
   if (verbosity >= 0) {
     edm::LogInfo(MsgLoggerCat) 
       << "\n===============================\n"
-      << "Initialized as EDAnalyzer with parameter values:\n"
+      << "Initialized as stream DQMEDAnalyzer with parameter values:\n"
       << "    Name          = " << fName << "\n"
       << "    Verbosity     = " << verbosity << "\n"
       << "    Frequency     = " << frequency << "\n"
       << "    VtxUnit       = " << vtxunit << "\n"
-      << "    OutputFile    = " << outputfile << "\n"
-      << "    DoOutput      = " << doOutput << "\n"
       << "    GetProv       = " << getAllProvenances << "\n"
       << "    PrintProv     = " << printProvenanceInfo << "\n"
+      << "    Subsystems    = " << subsystems.names() << "\n"
       << "    GlobalHitSrc  = " << GlobalHitSrc_.label() 
       << ":" << GlobalHitSrc_.instance() << "\n"
       << "===============================\n";
   }
 
-  // get dqm info
-  dbe = 0;
-  dbe = edm::Service<DQMStore>().operator->();
-  if (dbe) {
-    if (verbosity > 0 ) {
-      dbe->setVerbose(1);
-    } else {
-      dbe->setVerbose(0);
-    }
-  }
-
-  if (dbe) {
-    if (verbosity > 0 ) dbe->showDirStructure();
-  }
-
   // initialize monitor elements
   for (Int_t i = 0; i < 2; ++i) {
     meMCRGP[i] = 0;
@@ -121,19 +125,28 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
   meMuonCscZ = 0;
   meMuonRpcBR = 0;
   meMuonRpcFZ = 0;
+}
+
+GlobalHitsHistogrammer::~GlobalHitsHistogrammer() 
+{
+}
 
+void GlobalHitsHistogrammer::bookHistograms(DQMStore::IBooker& iBooker,
+					    const edm::Run& iRun,
+					    const edm::EventSetup& iSetup)
+{
   //create histograms
   Char_t hname[200];
   Char_t htitle[200];
-  if (dbe) {
 
-    // MCGeant
-    dbe->setCurrentFolder("GlobalHitsV/MCGeant");
+  // MCGeant
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    iBooker.setCurrentFolder("GlobalHitsV/MCGeant");
     sprintf(hname,"hMCRGP1");
     sprintf(htitle,"RawGenParticles");
-    meMCRGP[0] = dbe->book1D(hname,htitle,100,0.,5000.);
+    meMCRGP[0] = iBooker.book1D(hname,htitle,100,0.,5000.);
     sprintf(hname,"hMCRGP2");
-    meMCRGP[1] = dbe->book1D(hname,htitle,100,0.,500.);  
+    meMCRGP[1] = iBooker.book1D(hname,htitle,100,0.,500.);  
     for (Int_t i = 0; i < 2; ++i) {
       meMCRGP[i]->setAxisTitle("Number of Raw Generated Particles",1);
       meMCRGP[i]->setAxisTitle("Count",2);
@@ -141,9 +154,9 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMCG4Vtx1");
     sprintf(htitle,"G4 Vertices");
-    meMCG4Vtx[0] = dbe->book1D(hname,htitle,100,0.,50000.);
+    meMCG4Vtx[0] = iBooker.book1D(hname,htitle,100,0.,50000.);
     sprintf(hname,"hMCG4Vtx2");
-    meMCG4Vtx[1] = dbe->book1D(hname,htitle,100,-0.5,99.5); 
+    meMCG4Vtx[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5); 
     for (Int_t i = 0; i < 2; ++i) {
       meMCG4Vtx[i]->setAxisTitle("Number of Vertices",1);
       meMCG4Vtx[i]->setAxisTitle("Count",2);
@@ -151,9 +164,9 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMCG4Trk1");
     sprintf(htitle,"G4 Tracks");
-    meMCG4Trk[0] = dbe->book1D(hname,htitle,150,0.,15000.);
+    meMCG4Trk[0] = iBooker.book1D(hname,htitle,150,0.,15000.);
     sprintf(hname,"hMCG4Trk2");
-    meMCG4Trk[1] = dbe->book1D(hname,htitle,150,-0.5,99.5);    
+    meMCG4Trk[1] = iBooker.book1D(hname,htitle,150,-0.5,99.5);    
     for (Int_t i = 0; i < 2; ++i) {
       meMCG4Trk[i]->setAxisTitle("Number of Tracks",1);
       meMCG4Trk[i]->setAxisTitle("Count",2);
@@ -161,9 +174,9 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hGeantVtxX1");
     sprintf(htitle,"Geant vertex x/micrometer");
-    meGeantVtxX[0] = dbe->book1D(hname,htitle,100,-8000000.,8000000.);
+    meGeantVtxX[0] = iBooker.book1D(hname,htitle,100,-8000000.,8000000.);
     sprintf(hname,"hGeantVtxX2");
-    meGeantVtxX[1] = dbe->book1D(hname,htitle,100,-50.,50.); 
+    meGeantVtxX[1] = iBooker.book1D(hname,htitle,100,-50.,50.); 
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxX[i]->setAxisTitle("x of Vertex (um)",1);
       meGeantVtxX[i]->setAxisTitle("Count",2);
@@ -171,9 +184,9 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hGeantVtxY1");
     sprintf(htitle,"Geant vertex y/micrometer");
-    meGeantVtxY[0] = dbe->book1D(hname,htitle,100,-8000000,8000000.);
+    meGeantVtxY[0] = iBooker.book1D(hname,htitle,100,-8000000,8000000.);
     sprintf(hname,"hGeantVtxY2");
-    meGeantVtxY[1] = dbe->book1D(hname,htitle,100,-50.,50.); 
+    meGeantVtxY[1] = iBooker.book1D(hname,htitle,100,-50.,50.); 
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxY[i]->setAxisTitle("y of Vertex (um)",1);
       meGeantVtxY[i]->setAxisTitle("Count",2);
@@ -181,9 +194,9 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hGeantVtxZ1");
     sprintf(htitle,"Geant vertex z/millimeter");
-    meGeantVtxZ[0] = dbe->book1D(hname,htitle,100,-11000.,11000.);
+    meGeantVtxZ[0] = iBooker.book1D(hname,htitle,100,-11000.,11000.);
     sprintf(hname,"hGeantVtxZ2");
-    meGeantVtxZ[1] = dbe->book1D(hname,htitle,100,-250.,250.);
+    meGeantVtxZ[1] = iBooker.book1D(hname,htitle,100,-250.,250.);
     for (Int_t i = 0; i < 2; ++i) {
       meGeantVtxZ[i]->setAxisTitle("z of Vertex (mm)",1);
       meGeantVtxZ[i]->setAxisTitle("Count",2);
@@ -191,36 +204,38 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hGeantTrkPt");
     sprintf(htitle,"Geant track pt/GeV");
-    meGeantTrkPt = dbe->book1D(hname,htitle,100,0.,200.);
+    meGeantTrkPt = iBooker.book1D(hname,htitle,100,0.,200.);
     meGeantTrkPt->setAxisTitle("pT of Track (GeV)",1);
     meGeantTrkPt->setAxisTitle("Count",2);
 
     sprintf(hname,"hGeantTrkE");
     sprintf(htitle,"Geant track E/GeV");
-    meGeantTrkE = dbe->book1D(hname,htitle,100,0.,5000.);
+    meGeantTrkE = iBooker.book1D(hname,htitle,100,0.,5000.);
     meGeantTrkE->setAxisTitle("E of Track (GeV)",1);
     meGeantTrkE->setAxisTitle("Count",2);
+  }
 
-    // ECal
-    dbe->setCurrentFolder("GlobalHitsV/ECals");
+  // ECal
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    iBooker.setCurrentFolder("GlobalHitsV/ECals");
     sprintf(hname,"hCaloEcal1");
     sprintf(htitle,"Ecal hits");
-    meCaloEcal[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meCaloEcal[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hCaloEcal2");
-    meCaloEcal[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meCaloEcal[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
 
     sprintf(hname,"hCaloEcalE1");
     sprintf(htitle,"Ecal hits, energy/GeV");
-    meCaloEcalE[0] = dbe->book1D(hname,htitle,100,0.,10.);
+    meCaloEcalE[0] = iBooker.book1D(hname,htitle,100,0.,10.);
     sprintf(hname,"hCaloEcalE2");
-    meCaloEcalE[1] = dbe->book1D(hname,htitle,100,0.,0.1);
+    meCaloEcalE[1] = iBooker.book1D(hname,htitle,100,0.,0.1);
 
     sprintf(hname,"hCaloEcalToF1");
     sprintf(htitle,"Ecal hits, ToF/ns");
-    meCaloEcalToF[0] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meCaloEcalToF[0] = iBooker.book1D(hname,htitle,100,0.,1000.);
     sprintf(hname,"hCaloEcalToF2");
-    meCaloEcalToF[1] = dbe->book1D(hname,htitle,100,0.,100.);
- 
+    meCaloEcalToF[1] = iBooker.book1D(hname,htitle,100,0.,100.);
+
     for (Int_t i = 0; i < 2; ++i) {
       meCaloEcal[i]->setAxisTitle("Number of Hits",1);
       meCaloEcal[i]->setAxisTitle("Count",2);
@@ -232,33 +247,33 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hCaloEcalPhi");
     sprintf(htitle,"Ecal hits, phi/rad");
-    meCaloEcalPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meCaloEcalPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meCaloEcalPhi->setAxisTitle("Phi of Hits (rad)",1);
     meCaloEcalPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloEcalEta");
     sprintf(htitle,"Ecal hits, eta");
-    meCaloEcalEta = dbe->book1D(hname,htitle,100,-5.5,5.5);
+    meCaloEcalEta = iBooker.book1D(hname,htitle,100,-5.5,5.5);
     meCaloEcalEta->setAxisTitle("Eta of Hits",1);
     meCaloEcalEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloPreSh1");
     sprintf(htitle,"PreSh hits");
-    meCaloPreSh[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meCaloPreSh[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hCaloPreSh2");
-    meCaloPreSh[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meCaloPreSh[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
 
     sprintf(hname,"hCaloPreShE1");
     sprintf(htitle,"PreSh hits, energy/GeV");
-    meCaloPreShE[0] = dbe->book1D(hname,htitle,100,0.,10.);
+    meCaloPreShE[0] = iBooker.book1D(hname,htitle,100,0.,10.);
     sprintf(hname,"hCaloPreShE2");
-    meCaloPreShE[1] = dbe->book1D(hname,htitle,100,0.,0.1);
+    meCaloPreShE[1] = iBooker.book1D(hname,htitle,100,0.,0.1);
 
     sprintf(hname,"hCaloPreShToF1");
     sprintf(htitle,"PreSh hits, ToF/ns");
-    meCaloPreShToF[0] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meCaloPreShToF[0] = iBooker.book1D(hname,htitle,100,0.,1000.);
     sprintf(hname,"hCaloPreShToF2");
-    meCaloPreShToF[1] = dbe->book1D(hname,htitle,100,0.,100.);
+    meCaloPreShToF[1] = iBooker.book1D(hname,htitle,100,0.,100.);
 
     for (Int_t i = 0; i < 2; ++i) {
       meCaloPreSh[i]->setAxisTitle("Number of Hits",1);
@@ -271,35 +286,37 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hCaloPreShPhi");
     sprintf(htitle,"PreSh hits, phi/rad");
-    meCaloPreShPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meCaloPreShPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meCaloPreShPhi->setAxisTitle("Phi of Hits (rad)",1);
     meCaloPreShPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloPreShEta");
     sprintf(htitle,"PreSh hits, eta");
-    meCaloPreShEta = dbe->book1D(hname,htitle,100,-5.5,5.5);
+    meCaloPreShEta = iBooker.book1D(hname,htitle,100,-5.5,5.5);
     meCaloPreShEta->setAxisTitle("Eta of Hits",1);
     meCaloPreShEta->setAxisTitle("Count",2);
+  }
 
-    // Hcal
-    dbe->setCurrentFolder("GlobalHitsV/HCals");
+  // Hcal
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal)) {
+    iBooker.setCurrentFolder("GlobalHitsV/HCals");
     sprintf(hname,"hCaloHcal1");
     sprintf(htitle,"Hcal hits");
-    meCaloHcal[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meCaloHcal[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hCaloHcal2");
-    meCaloHcal[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meCaloHcal[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
 
     sprintf(hname,"hCaloHcalE1");
     sprintf(htitle,"Hcal hits, energy/GeV");
-    meCaloHcalE[0] = dbe->book1D(hname,htitle,100,0.,10.);
+    meCaloHcalE[0] = iBooker.book1D(hname,htitle,100,0.,10.);
     sprintf(hname,"hCaloHcalE2");
-    meCaloHcalE[1] = dbe->book1D(hname,htitle,100,0.,0.1);
+    meCaloHcalE[1] = iBooker.book1D(hname,htitle,100,0.,0.1);
 
     sprintf(hname,"hCaloHcalToF1");
     sprintf(htitle,"Hcal hits, ToF/ns");
-    meCaloHcalToF[0] = dbe->book1D(hname,htitle,100,0.,1000.);
+    meCaloHcalToF[0] = iBooker.book1D(hname,htitle,100,0.,1000.);
     sprintf(hname,"hCaloHcalToF2");
-    meCaloHcalToF[1] = dbe->book1D(hname,htitle,100,0.,100.);
+    meCaloHcalToF[1] = iBooker.book1D(hname,htitle,100,0.,100.);
 
     for (Int_t i = 0; i < 2; ++i) {
       meCaloHcal[i]->setAxisTitle("Number of Hits",1);
@@ -312,23 +329,25 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hCaloHcalPhi");
     sprintf(htitle,"Hcal hits, phi/rad");
-    meCaloHcalPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meCaloHcalPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meCaloHcalPhi->setAxisTitle("Phi of Hits (rad)",1);
     meCaloHcalPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hCaloHcalEta");
     sprintf(htitle,"Hcal hits, eta");
-    meCaloHcalEta = dbe->book1D(hname,htitle,100,-5.5,5.5);
+    meCaloHcalEta = iBooker.book1D(hname,htitle,100,-5.5,5.5);
     meCaloHcalEta->setAxisTitle("Eta of Hits",1);
     meCaloHcalEta->setAxisTitle("Count",2);
-    
-    // SiPixels
-    dbe->setCurrentFolder("GlobalHitsV/SiPixels");
+  }
+
+  // SiPixels
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    iBooker.setCurrentFolder("GlobalHitsV/SiPixels");
     sprintf(hname,"hTrackerPx1");
     sprintf(htitle,"Pixel hits");
-    meTrackerPx[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meTrackerPx[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hTrackerPx2");
-    meTrackerPx[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meTrackerPx[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
     for (Int_t i = 0; i < 2; ++i) {
       meTrackerPx[i]->setAxisTitle("Number of Pixel Hits",1);
       meTrackerPx[i]->setAxisTitle("Count",2);
@@ -336,47 +355,47 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hTrackerPxPhi");
     sprintf(htitle,"Pixel hits phi/rad");
-    meTrackerPxPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meTrackerPxPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meTrackerPxPhi->setAxisTitle("Phi of Hits (rad)",1);
     meTrackerPxPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxEta");
     sprintf(htitle,"Pixel hits eta");
-    meTrackerPxEta = dbe->book1D(hname,htitle,100,-3.5,3.5);
+    meTrackerPxEta = iBooker.book1D(hname,htitle,100,-3.5,3.5);
     meTrackerPxEta->setAxisTitle("Eta of Hits",1);
     meTrackerPxEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxBToF");
     sprintf(htitle,"Pixel barrel hits, ToF/ns");
-    meTrackerPxBToF = dbe->book1D(hname,htitle,100,0.,40.);
+    meTrackerPxBToF = iBooker.book1D(hname,htitle,100,0.,40.);
     meTrackerPxBToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerPxBToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxBR");
     sprintf(htitle,"Pixel barrel hits, R/cm");
-    meTrackerPxBR = dbe->book1D(hname,htitle,100,0.,50.);
+    meTrackerPxBR = iBooker.book1D(hname,htitle,100,0.,50.);
     meTrackerPxBR->setAxisTitle("R of Hits (cm)",1);
     meTrackerPxBR->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxFToF");
     sprintf(htitle,"Pixel forward hits, ToF/ns");
-    meTrackerPxFToF = dbe->book1D(hname,htitle,100,0.,50.);
+    meTrackerPxFToF = iBooker.book1D(hname,htitle,100,0.,50.);
     meTrackerPxFToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerPxFToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerPxFZ");
     sprintf(htitle,"Pixel forward hits, Z/cm");
-    meTrackerPxFZ = dbe->book1D(hname,htitle,200,-100.,100.);
+    meTrackerPxFZ = iBooker.book1D(hname,htitle,200,-100.,100.);
     meTrackerPxFZ->setAxisTitle("Z of Hits (cm)",1);
     meTrackerPxFZ->setAxisTitle("Count",2);
 
     // SiStrips
-    dbe->setCurrentFolder("GlobalHitsV/SiPixels");
+    iBooker.setCurrentFolder("GlobalHitsV/SiPixels");
     sprintf(hname,"hTrackerSi1");
     sprintf(htitle,"Silicon hits");
-    meTrackerSi[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meTrackerSi[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hTrackerSi2");
-    meTrackerSi[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meTrackerSi[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
     for (Int_t i = 0; i < 2; ++i) { 
       meTrackerSi[i]->setAxisTitle("Number of Silicon Hits",1);
       meTrackerSi[i]->setAxisTitle("Count",2);
@@ -384,47 +403,49 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hTrackerSiPhi");
     sprintf(htitle,"Silicon hits phi/rad");
-    meTrackerSiPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meTrackerSiPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meTrackerSiPhi->setAxisTitle("Phi of Hits (rad)",1);
     meTrackerSiPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiEta");
     sprintf(htitle,"Silicon hits eta");
-    meTrackerSiEta = dbe->book1D(hname,htitle,100,-3.5,3.5);
+    meTrackerSiEta = iBooker.book1D(hname,htitle,100,-3.5,3.5);
     meTrackerSiEta->setAxisTitle("Eta of Hits",1);
     meTrackerSiEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiBToF");
     sprintf(htitle,"Silicon barrel hits, ToF/ns");
-    meTrackerSiBToF = dbe->book1D(hname,htitle,100,0.,50.);
+    meTrackerSiBToF = iBooker.book1D(hname,htitle,100,0.,50.);
     meTrackerSiBToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerSiBToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiBR");
     sprintf(htitle,"Silicon barrel hits, R/cm");
-    meTrackerSiBR = dbe->book1D(hname,htitle,100,0.,200.);
+    meTrackerSiBR = iBooker.book1D(hname,htitle,100,0.,200.);
     meTrackerSiBR->setAxisTitle("R of Hits (cm)",1);
     meTrackerSiBR->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiFToF");
     sprintf(htitle,"Silicon forward hits, ToF/ns");
-    meTrackerSiFToF = dbe->book1D(hname,htitle,100,0.,75.);
+    meTrackerSiFToF = iBooker.book1D(hname,htitle,100,0.,75.);
     meTrackerSiFToF->setAxisTitle("Time of Flight of Hits (ns)",1);
     meTrackerSiFToF->setAxisTitle("Count",2);
 
     sprintf(hname,"hTrackerSiFZ");
     sprintf(htitle,"Silicon forward hits, Z/cm");
-    meTrackerSiFZ = dbe->book1D(hname,htitle,200,-300.,300.);
+    meTrackerSiFZ = iBooker.book1D(hname,htitle,200,-300.,300.);
     meTrackerSiFZ->setAxisTitle("Z of Hits (cm)",1);
     meTrackerSiFZ->setAxisTitle("Count",2);
+  }
 
-    // muon
-    dbe->setCurrentFolder("GlobalHitsV/Muons");
+  // muon
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    iBooker.setCurrentFolder("GlobalHitsV/Muons");
     sprintf(hname,"hMuon1");
     sprintf(htitle,"Muon hits");
-    meMuon[0] = dbe->book1D(hname,htitle,100,0.,10000.);
+    meMuon[0] = iBooker.book1D(hname,htitle,100,0.,10000.);
     sprintf(hname,"hMuon2");
-    meMuon[1] = dbe->book1D(hname,htitle,100,-0.5,99.5);
+    meMuon[1] = iBooker.book1D(hname,htitle,100,-0.5,99.5);
     for (Int_t i = 0; i < 2; ++i) { 
       meMuon[i]->setAxisTitle("Number of Muon Hits",1);
       meMuon[i]->setAxisTitle("Count",2);
@@ -432,21 +453,21 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMuonPhi");
     sprintf(htitle,"Muon hits phi/rad");
-    meMuonPhi = dbe->book1D(hname,htitle,100,-3.2,3.2);
+    meMuonPhi = iBooker.book1D(hname,htitle,100,-3.2,3.2);
     meMuonPhi->setAxisTitle("Phi of Hits (rad)",1);
     meMuonPhi->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonEta");
     sprintf(htitle,"Muon hits eta");
-    meMuonEta = dbe->book1D(hname,htitle,100,-3.5,3.5);
+    meMuonEta = iBooker.book1D(hname,htitle,100,-3.5,3.5);
     meMuonEta->setAxisTitle("Eta of Hits",1);
     meMuonEta->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonCscToF1");
     sprintf(htitle,"Muon CSC hits, ToF/ns");
-    meMuonCscToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonCscToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonCscToF2");
-    meMuonCscToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonCscToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonCscToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonCscToF[i]->setAxisTitle("Count",2);
@@ -454,15 +475,15 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMuonCscZ");
     sprintf(htitle,"Muon CSC hits, Z/cm");
-    meMuonCscZ = dbe->book1D(hname,htitle,200,-1500.,1500.);
+    meMuonCscZ = iBooker.book1D(hname,htitle,200,-1500.,1500.);
     meMuonCscZ->setAxisTitle("Z of Hits (cm)",1);
     meMuonCscZ->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonDtToF1");
     sprintf(htitle,"Muon DT hits, ToF/ns");
-    meMuonDtToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonDtToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonDtToF2");
-    meMuonDtToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonDtToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonDtToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonDtToF[i]->setAxisTitle("Count",2);
@@ -470,15 +491,15 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMuonDtR");
     sprintf(htitle,"Muon DT hits, R/cm");
-    meMuonDtR = dbe->book1D(hname,htitle,100,0.,1500.); 
+    meMuonDtR = iBooker.book1D(hname,htitle,100,0.,1500.); 
     meMuonDtR->setAxisTitle("R of Hits (cm)",1);
     meMuonDtR->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonRpcFToF1");
     sprintf(htitle,"Muon RPC forward hits, ToF/ns");
-    meMuonRpcFToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonRpcFToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonRpcFToF2_4305");
-    meMuonRpcFToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonRpcFToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonRpcFToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonRpcFToF[i]->setAxisTitle("Count",2);
@@ -486,15 +507,15 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMuonRpcFZ");
     sprintf(htitle,"Muon RPC forward hits, Z/cm");
-    meMuonRpcFZ = dbe->book1D(hname,htitle,201,-1500.,1500.);
+    meMuonRpcFZ = iBooker.book1D(hname,htitle,201,-1500.,1500.);
     meMuonRpcFZ->setAxisTitle("Z of Hits (cm)",1);
     meMuonRpcFZ->setAxisTitle("Count",2);
 
     sprintf(hname,"hMuonRpcBToF1");
     sprintf(htitle,"Muon RPC barrel hits, ToF/ns");
-    meMuonRpcBToF[0] = dbe->book1D(hname,htitle,100,0.,250.);
+    meMuonRpcBToF[0] = iBooker.book1D(hname,htitle,100,0.,250.);
     sprintf(hname,"hMuonRpcBToF2");
-    meMuonRpcBToF[1] = dbe->book1D(hname,htitle,100,0.,50.);
+    meMuonRpcBToF[1] = iBooker.book1D(hname,htitle,100,0.,50.);
     for (Int_t i = 0; i < 2; ++i) {   
       meMuonRpcBToF[i]->setAxisTitle("Time of Flight of Hits (ns)",1);
       meMuonRpcBToF[i]->setAxisTitle("Count",2);
@@ -502,29 +523,18 @@ GlobalHitsHistogrammer::GlobalHitsHistogrammer(const edm::ParameterSet& iPSet)
 
     sprintf(hname,"hMuonRpcBR");
     sprintf(htitle,"Muon RPC barrel hits, R/cm");
-    meMuonRpcBR = dbe->book1D(hname,htitle,100,0.,1500.);
+    meMuonRpcBR = iBooker.book1D(hname,htitle,100,0.,1500.);
     meMuonRpcBR->setAxisTitle("R of Hits (cm)",1);
-    meMuonRpcBR->setAxisTitle("Count",2); 
+    meMuonRpcBR->setAxisTitle("Count",2);
   }
 }
 
-GlobalHitsHistogrammer::~GlobalHitsHistogrammer() 
-{
-  if (doOutput)
-    if (outputfile.size() != 0 && dbe) dbe->save(outputfile);
-}
-
-void GlobalHitsHistogrammer::beginJob( void )
-{
-  return;
-}
-
-void GlobalHitsHistogrammer::endJob()
+void GlobalHitsHistogrammer::endStream()
 {
-  std::string MsgLoggerCat = "GlobalHitsHistogrammer_endJob";
+  std::string MsgLoggerCat = "GlobalHitsHistogrammer_endStream";
   if (verbosity >= 0)
     edm::LogInfo(MsgLoggerCat) 
-      << "Terminating having processed " << count << " events.";
+      << "Stream terminating having processed " << count << " events.";
   return;
 }
 
@@ -585,180 +595,219 @@ void GlobalHitsHistogrammer::analyze(const edm::Event& iEvent,
     getAllProvenances = false;
   }
 
-  // fill histograms
-  edm::Handle<PGlobalSimHit> srcGlobalHits;
-  iEvent.getByLabel(GlobalHitSrc_,srcGlobalHits);
-  if (!srcGlobalHits.isValid()) {
+  // fill histograms; a compact product is decoded first
+  const PGlobalSimHit *srcGlobalHits = 0;
+  PGlobalSimHit decodedGlobalHits;
+  edm::Handle<PGlobalSimHit> globalHits;
+  iEvent.getByToken(GlobalHitSrc_Token_,globalHits);
+  if (globalHits.isValid()) {
+    srcGlobalHits = globalHits.product();
+  } else {
+    edm::Handle<GlobalHitsCompactHits> compactHits;
+    iEvent.getByToken(GlobalHitCompactSrc_Token_,compactHits);
+    if (compactHits.isValid()) {
+      compactHits->unpack(decodedGlobalHits);
+      srcGlobalHits = &decodedGlobalHits;
+    }
+  }
+  if (!srcGlobalHits) {
     edm::LogWarning(MsgLoggerCat)
-      << "Unable to find PGlobalSimHit in event!";
+      << "Unable to find PGlobalSimHit or GlobalHitsCompactHits in event!";
     return;
   }
 
-  nPxlBrlHits = srcGlobalHits->getnPxlBrlHits();
-  nPxlFwdHits = srcGlobalHits->getnPxlFwdHits();
+  // weight of the hits of every block if the producer sampled them; the
+  // hit counts are scaled back to the ones before the sampling
+  typedef GlobalHitsColumns C;
+  float w[C::nBlocks];
+  std::fill(w, w + C::nBlocks, 1.f);
+  edm::Handle<std::vector<float> > globalHitWeights;
+  iEvent.getByToken(GlobalHitWeights_Token_,globalHitWeights);
+  if (globalHitWeights.isValid() &&
+      globalHitWeights->size() == (unsigned int)C::nBlocks)
+    std::copy(globalHitWeights->begin(), globalHitWeights->end(), w);
+
+  nPxlBrlHits = unsampled(srcGlobalHits->getnPxlBrlHits(), w[C::PxlBrl]);
+  nPxlFwdHits = unsampled(srcGlobalHits->getnPxlFwdHits(), w[C::PxlFwd]);
   nPxlHits = nPxlBrlHits + nPxlFwdHits;
-  nSiBrlHits = srcGlobalHits->getnSiBrlHits();
-  nSiFwdHits = srcGlobalHits->getnSiFwdHits();
+  nSiBrlHits = unsampled(srcGlobalHits->getnSiBrlHits(), w[C::SiBrl]);
+  nSiFwdHits = unsampled(srcGlobalHits->getnSiFwdHits(), w[C::SiFwd]);
   nSiHits = nSiBrlHits + nSiFwdHits;    
-  nMuonDtHits = srcGlobalHits->getnMuonDtHits();
-  nMuonCscHits = srcGlobalHits->getnMuonCscHits();
-  nMuonRpcBrlHits = srcGlobalHits->getnMuonRpcBrlHits();
-  nMuonRpcFwdHits = srcGlobalHits->getnMuonRpcFwdHits();
+  nMuonDtHits = unsampled(srcGlobalHits->getnMuonDtHits(), w[C::MuonDt]);
+  nMuonCscHits = unsampled(srcGlobalHits->getnMuonCscHits(), w[C::MuonCsc]);
+  nMuonRpcBrlHits =
+    unsampled(srcGlobalHits->getnMuonRpcBrlHits(), w[C::MuonRpcBrl]);
+  nMuonRpcFwdHits =
+    unsampled(srcGlobalHits->getnMuonRpcFwdHits(), w[C::MuonRpcFwd]);
   nMuonHits = nMuonDtHits + nMuonCscHits + nMuonRpcBrlHits + nMuonRpcFwdHits;
+  const int nECalHits = unsampled(srcGlobalHits->getnECalHits(), w[C::ECal]);
+  const int nPreShHits =
+    unsampled(srcGlobalHits->getnPreShHits(), w[C::PreSh]);
+  const int nHCalHits = unsampled(srcGlobalHits->getnHCalHits(), w[C::HCal]);
 
   for (Int_t i = 0; i < 2; ++i) {
-    meMCRGP[i]->Fill((float)srcGlobalHits->getnRawGenPart());
-    meMCG4Vtx[i]->Fill((float)srcGlobalHits->getnG4Vtx());
-    meMCG4Trk[i]->Fill((float)srcGlobalHits->getnG4Trk());
-    meCaloEcal[i]->Fill((float)srcGlobalHits->getnECalHits());
-    meCaloPreSh[i]->Fill((float)srcGlobalHits->getnPreShHits());
-    meCaloHcal[i]->Fill((float)srcGlobalHits->getnHCalHits());
-    meTrackerPx[i]->Fill((float)nPxlHits);
-    meTrackerSi[i]->Fill((float)nSiHits);
-    meMuon[i]->Fill((float)nMuonHits);
+    if (meMCRGP[i]) meMCRGP[i]->Fill((float)srcGlobalHits->getnRawGenPart());
+    if (meMCG4Vtx[i]) meMCG4Vtx[i]->Fill((float)srcGlobalHits->getnG4Vtx());
+    if (meMCG4Trk[i]) meMCG4Trk[i]->Fill((float)srcGlobalHits->getnG4Trk());
+    if (meCaloEcal[i]) meCaloEcal[i]->Fill((float)nECalHits);
+    if (meCaloPreSh[i]) meCaloPreSh[i]->Fill((float)nPreShHits);
+    if (meCaloHcal[i]) meCaloHcal[i]->Fill((float)nHCalHits);
+    if (meTrackerPx[i]) meTrackerPx[i]->Fill((float)nPxlHits);
+    if (meTrackerSi[i]) meTrackerSi[i]->Fill((float)nSiHits);
+    if (meMuon[i]) meMuon[i]->Fill((float)nMuonHits);
   }
 
   // get G4Vertex info
-  std::vector<PGlobalSimHit::Vtx> G4Vtx = srcGlobalHits->getG4Vtx();
-  for (unsigned int i = 0; i < G4Vtx.size(); ++i) {
-    for (int j = 0; j < 2; ++j) {
-      meGeantVtxX[j]->Fill(G4Vtx[i].x);
-      meGeantVtxY[j]->Fill(G4Vtx[i].y);
-      meGeantVtxZ[j]->Fill(G4Vtx[i].z);
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    std::vector<PGlobalSimHit::Vtx> G4Vtx = srcGlobalHits->getG4Vtx();
+    for (unsigned int i = 0; i < G4Vtx.size(); ++i) {
+      for (int j = 0; j < 2; ++j) {
+	meGeantVtxX[j]->Fill(G4Vtx[i].x);
+	meGeantVtxY[j]->Fill(G4Vtx[i].y);
+	meGeantVtxZ[j]->Fill(G4Vtx[i].z);
+      }
+    }
+
+    // get G4Track info
+    std::vector<PGlobalSimHit::Trk> G4Trk = srcGlobalHits->getG4Trk();
+    for (unsigned int i = 0; i < G4Trk.size(); ++i) {
+      meGeantTrkPt->Fill(G4Trk[i].pt);
+      meGeantTrkE->Fill(G4Trk[i].e);
     }
   }
-  
-  // get G4Track info
-  std::vector<PGlobalSimHit::Trk> G4Trk = srcGlobalHits->getG4Trk();
-  for (unsigned int i = 0; i < G4Trk.size(); ++i) {
-    meGeantTrkPt->Fill(G4Trk[i].pt);
-    meGeantTrkE->Fill(G4Trk[i].e);
-  }
-  
+
   // get Ecal info
-  std::vector<PGlobalSimHit::CalHit> ECalHits = 
-    srcGlobalHits->getECalHits();
-  for (unsigned int i = 0; i < ECalHits.size(); ++i) {
-    for (Int_t j = 0; j < 2; ++j) {
-	meCaloEcalE[j]->Fill(ECalHits[i].e);
-	meCaloEcalToF[j]->Fill(ECalHits[i].tof);
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    std::vector<PGlobalSimHit::CalHit> ECalHits = 
+      srcGlobalHits->getECalHits();
+    for (unsigned int i = 0; i < ECalHits.size(); ++i) {
+      for (Int_t j = 0; j < 2; ++j) {
+	  meCaloEcalE[j]->Fill(ECalHits[i].e, w[C::ECal]);
+	  meCaloEcalToF[j]->Fill(ECalHits[i].tof, w[C::ECal]);
+      }
+      meCaloEcalPhi->Fill(ECalHits[i].phi, w[C::ECal]);
+      meCaloEcalEta->Fill(ECalHits[i].eta, w[C::ECal]);
     }
-    meCaloEcalPhi->Fill(ECalHits[i].phi);
-    meCaloEcalEta->Fill(ECalHits[i].eta);
-  }
-  
-  // get PreShower info
-  std::vector<PGlobalSimHit::CalHit> PreShHits = 
-    srcGlobalHits->getPreShHits();
-  for (unsigned int i = 0; i < PreShHits.size(); ++i) {
-    for (Int_t j = 0; j < 2; ++j) {
-      meCaloPreShE[j]->Fill(PreShHits[i].e);
-      meCaloPreShToF[j]->Fill(PreShHits[i].tof);
+
+    // get PreShower info
+    std::vector<PGlobalSimHit::CalHit> PreShHits = 
+      srcGlobalHits->getPreShHits();
+    for (unsigned int i = 0; i < PreShHits.size(); ++i) {
+      for (Int_t j = 0; j < 2; ++j) {
+	meCaloPreShE[j]->Fill(PreShHits[i].e, w[C::PreSh]);
+	meCaloPreShToF[j]->Fill(PreShHits[i].tof, w[C::PreSh]);
+      }
+      meCaloPreShPhi->Fill(PreShHits[i].phi, w[C::PreSh]);
+      meCaloPreShEta->Fill(PreShHits[i].eta, w[C::PreSh]);
     }
-    meCaloPreShPhi->Fill(PreShHits[i].phi);
-    meCaloPreShEta->Fill(PreShHits[i].eta);
   }
-  
+
   // get Hcal info
-  std::vector<PGlobalSimHit::CalHit> HCalHits = 
-    srcGlobalHits->getHCalHits();
-  for (unsigned int i = 0; i < HCalHits.size(); ++i) {
-    for (Int_t j = 0; j < 2; ++j) {
-      meCaloHcalE[j]->Fill(HCalHits[i].e);
-      meCaloHcalToF[j]->Fill(HCalHits[i].tof);
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal)) {
+    std::vector<PGlobalSimHit::CalHit> HCalHits = 
+      srcGlobalHits->getHCalHits();
+    for (unsigned int i = 0; i < HCalHits.size(); ++i) {
+      for (Int_t j = 0; j < 2; ++j) {
+	meCaloHcalE[j]->Fill(HCalHits[i].e, w[C::HCal]);
+	meCaloHcalToF[j]->Fill(HCalHits[i].tof, w[C::HCal]);
+      }
+      meCaloHcalPhi->Fill(HCalHits[i].phi, w[C::HCal]);
+      meCaloHcalEta->Fill(HCalHits[i].eta, w[C::HCal]);
     }
-    meCaloHcalPhi->Fill(HCalHits[i].phi);
-    meCaloHcalEta->Fill(HCalHits[i].eta);
   }
-  
+
   // get Pixel Barrel info
-  std::vector<PGlobalSimHit::BrlHit> PxlBrlHits = 
-    srcGlobalHits->getPxlBrlHits();
-  for (unsigned int i = 0; i < PxlBrlHits.size(); ++i) {
-    meTrackerPxPhi->Fill(PxlBrlHits[i].phi);
-    meTrackerPxEta->Fill(PxlBrlHits[i].eta);
-    meTrackerPxBToF->Fill(PxlBrlHits[i].tof);
-    meTrackerPxBR->Fill(PxlBrlHits[i].r);
-  }
-  
-  // get Pixel Forward info
-  std::vector<PGlobalSimHit::FwdHit> PxlFwdHits = 
-    srcGlobalHits->getPxlFwdHits();
-  for (unsigned int i = 0; i < PxlFwdHits.size(); ++i) {
-    meTrackerPxPhi->Fill(PxlFwdHits[i].phi);
-    meTrackerPxEta->Fill(PxlFwdHits[i].eta);
-    meTrackerPxFToF->Fill(PxlFwdHits[i].tof);
-    meTrackerPxFZ->Fill(PxlFwdHits[i].z);
-  }
-  
-  // get Strip Barrel info
-  std::vector<PGlobalSimHit::BrlHit> SiBrlHits = 
-    srcGlobalHits->getSiBrlHits();
-  for (unsigned int i = 0; i < SiBrlHits.size(); ++i) {
-    meTrackerSiPhi->Fill(SiBrlHits[i].phi);
-    meTrackerSiEta->Fill(SiBrlHits[i].eta);
-    meTrackerSiBToF->Fill(SiBrlHits[i].tof);
-    meTrackerSiBR->Fill(SiBrlHits[i].r);
-  }
-  
-  // get Strip Forward info
-  std::vector<PGlobalSimHit::FwdHit> SiFwdHits = 
-    srcGlobalHits->getSiFwdHits();
-  for (unsigned int i = 0; i < SiFwdHits.size(); ++i) {
-    meTrackerSiPhi->Fill(SiFwdHits[i].phi);
-    meTrackerSiEta->Fill(SiFwdHits[i].eta);
-    meTrackerSiFToF->Fill(SiFwdHits[i].tof);
-    meTrackerSiFZ->Fill(SiFwdHits[i].z);
-  }
-  
-  // get Muon CSC info
-  std::vector<PGlobalSimHit::FwdHit> MuonCscHits = 
-    srcGlobalHits->getMuonCscHits();
-  for (unsigned int i = 0; i < MuonCscHits.size(); ++i) {
-    meMuonPhi->Fill(MuonCscHits[i].phi);
-    meMuonEta->Fill(MuonCscHits[i].eta);
-    for (Int_t j = 0; j < 2; ++j) {
-      meMuonCscToF[j]->Fill(MuonCscHits[i].tof);
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    std::vector<PGlobalSimHit::BrlHit> PxlBrlHits = 
+      srcGlobalHits->getPxlBrlHits();
+    for (unsigned int i = 0; i < PxlBrlHits.size(); ++i) {
+      meTrackerPxPhi->Fill(PxlBrlHits[i].phi, w[C::PxlBrl]);
+      meTrackerPxEta->Fill(PxlBrlHits[i].eta, w[C::PxlBrl]);
+      meTrackerPxBToF->Fill(PxlBrlHits[i].tof, w[C::PxlBrl]);
+      meTrackerPxBR->Fill(PxlBrlHits[i].r, w[C::PxlBrl]);
     }
-    meMuonCscZ->Fill(MuonCscHits[i].z);
-  }    
-  
-  // get Muon DT info
-  std::vector<PGlobalSimHit::BrlHit> MuonDtHits = 
-    srcGlobalHits->getMuonDtHits();
-  for (unsigned int i = 0; i < MuonDtHits.size(); ++i) {
-    meMuonPhi->Fill(MuonDtHits[i].phi);
-    meMuonEta->Fill(MuonDtHits[i].eta);
-    for (Int_t j = 0; j < 2; ++j) {
-      meMuonDtToF[j]->Fill(MuonDtHits[i].tof);
+
+    // get Pixel Forward info
+    std::vector<PGlobalSimHit::FwdHit> PxlFwdHits = 
+      srcGlobalHits->getPxlFwdHits();
+    for (unsigned int i = 0; i < PxlFwdHits.size(); ++i) {
+      meTrackerPxPhi->Fill(PxlFwdHits[i].phi, w[C::PxlFwd]);
+      meTrackerPxEta->Fill(PxlFwdHits[i].eta, w[C::PxlFwd]);
+      meTrackerPxFToF->Fill(PxlFwdHits[i].tof, w[C::PxlFwd]);
+      meTrackerPxFZ->Fill(PxlFwdHits[i].z, w[C::PxlFwd]);
     }
-    meMuonDtR->Fill(MuonDtHits[i].r);
-  }
-  
-  // get Muon RPC forward info
-  std::vector<PGlobalSimHit::FwdHit> MuonRpcFwdHits = 
-    srcGlobalHits->getMuonRpcFwdHits();
-  for (unsigned int i = 0; i < MuonRpcFwdHits.size(); ++i) {
-    meMuonPhi->Fill(MuonRpcFwdHits[i].phi);
-    meMuonEta->Fill(MuonRpcFwdHits[i].eta);
-    for (Int_t j = 0; j < 2; ++j) {
-      meMuonRpcFToF[j]->Fill(MuonRpcFwdHits[i].tof);
+
+    // get Strip Barrel info
+    std::vector<PGlobalSimHit::BrlHit> SiBrlHits = 
+      srcGlobalHits->getSiBrlHits();
+    for (unsigned int i = 0; i < SiBrlHits.size(); ++i) {
+      meTrackerSiPhi->Fill(SiBrlHits[i].phi, w[C::SiBrl]);
+      meTrackerSiEta->Fill(SiBrlHits[i].eta, w[C::SiBrl]);
+      meTrackerSiBToF->Fill(SiBrlHits[i].tof, w[C::SiBrl]);
+      meTrackerSiBR->Fill(SiBrlHits[i].r, w[C::SiBrl]);
     }
-    meMuonRpcFZ->Fill(MuonRpcFwdHits[i].z);
-  }    
-  
-  // get Muon RPC barrel info
-  std::vector<PGlobalSimHit::BrlHit> MuonRpcBrlHits = 
-    srcGlobalHits->getMuonRpcBrlHits();
-  for (unsigned int i = 0; i < MuonRpcBrlHits.size(); ++i) {
-    meMuonPhi->Fill(MuonRpcBrlHits[i].phi);
-    meMuonEta->Fill(MuonRpcBrlHits[i].eta);
-    for (Int_t j = 0; j < 2; ++j) {
-      meMuonRpcBToF[j]->Fill(MuonRpcBrlHits[i].tof);
+
+    // get Strip Forward info
+    std::vector<PGlobalSimHit::FwdHit> SiFwdHits = 
+      srcGlobalHits->getSiFwdHits();
+    for (unsigned int i = 0; i < SiFwdHits.size(); ++i) {
+      meTrackerSiPhi->Fill(SiFwdHits[i].phi, w[C::SiFwd]);
+      meTrackerSiEta->Fill(SiFwdHits[i].eta, w[C::SiFwd]);
+      meTrackerSiFToF->Fill(SiFwdHits[i].tof, w[C::SiFwd]);
+      meTrackerSiFZ->Fill(SiFwdHits[i].z, w[C::SiFwd]);
+    }
+  }
+
+  // get Muon CSC info
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    std::vector<PGlobalSimHit::FwdHit> MuonCscHits = 
+      srcGlobalHits->getMuonCscHits();
+    for (unsigned int i = 0; i < MuonCscHits.size(); ++i) {
+      meMuonPhi->Fill(MuonCscHits[i].phi, w[C::MuonCsc]);
+      meMuonEta->Fill(MuonCscHits[i].eta, w[C::MuonCsc]);
+      for (Int_t j = 0; j < 2; ++j) {
+	meMuonCscToF[j]->Fill(MuonCscHits[i].tof, w[C::MuonCsc]);
+      }
+      meMuonCscZ->Fill(MuonCscHits[i].z, w[C::MuonCsc]);
+    }    
+
+    // get Muon DT info
+    std::vector<PGlobalSimHit::BrlHit> MuonDtHits = 
+      srcGlobalHits->getMuonDtHits();
+    for (unsigned int i = 0; i < MuonDtHits.size(); ++i) {
+      meMuonPhi->Fill(MuonDtHits[i].phi, w[C::MuonDt]);
+      meMuonEta->Fill(MuonDtHits[i].eta, w[C::MuonDt]);
+      for (Int_t j = 0; j < 2; ++j) {
+	meMuonDtToF[j]->Fill(MuonDtHits[i].tof, w[C::MuonDt]);
+      }
+      meMuonDtR->Fill(MuonDtHits[i].r, w[C::MuonDt]);
     }
-    meMuonRpcBR->Fill(MuonRpcBrlHits[i].r);
-  }   
-  
+
+    // get Muon RPC forward info
+    std::vector<PGlobalSimHit::FwdHit> MuonRpcFwdHits = 
+      srcGlobalHits->getMuonRpcFwdHits();
+    for (unsigned int i = 0; i < MuonRpcFwdHits.size(); ++i) {
+      meMuonPhi->Fill(MuonRpcFwdHits[i].phi, w[C::MuonRpcFwd]);
+      meMuonEta->Fill(MuonRpcFwdHits[i].eta, w[C::MuonRpcFwd]);
+      for (Int_t j = 0; j < 2; ++j) {
+	meMuonRpcFToF[j]->Fill(MuonRpcFwdHits[i].tof, w[C::MuonRpcFwd]);
+      }
+      meMuonRpcFZ->Fill(MuonRpcFwdHits[i].z, w[C::MuonRpcFwd]);
+    }    
+
+    // get Muon RPC barrel info
+    std::vector<PGlobalSimHit::BrlHit> MuonRpcBrlHits = 
+      srcGlobalHits->getMuonRpcBrlHits();
+    for (unsigned int i = 0; i < MuonRpcBrlHits.size(); ++i) {
+      meMuonPhi->Fill(MuonRpcBrlHits[i].phi, w[C::MuonRpcBrl]);
+      meMuonEta->Fill(MuonRpcBrlHits[i].eta, w[C::MuonRpcBrl]);
+      for (Int_t j = 0; j < 2; ++j) {
+	meMuonRpcBToF[j]->Fill(MuonRpcBrlHits[i].tof, w[C::MuonRpcBrl]);
+      }
+      meMuonRpcBR->Fill(MuonRpcBrlHits[i].r, w[C::MuonRpcBrl]);
+    }   
+  }
+
   return;
 }
 
@@ -5,13 +5,29 @@
  *  
  *  Class to fill dqm monitor elements from existing EDM file
  *
+ *  Runs as a stream DQMEDAnalyzer: every stream books and fills its own
+ *  monitor elements and the DQM framework merges them at the end of run.
+ *  The module writes no file itself; the merged monitor elements are
+ *  saved by the dqmSaver of globalhits_histogram_cff.
+ *
+ *  Only the histograms of the subsystems in Subsystems are booked and
+ *  filled.
+ *
+ *  If GlobalHitSrc holds a GlobalHitsCompactHits instead of a
+ *  PGlobalSimHit (GlobalHitsProducer with CompactOutput = true) it is
+ *  decoded and filled the same way.
+ *
+ *  If GlobalHitsProducer sampled the hits, the hits of every block are
+ *  filled with the weights it put next to the product and the hit counts
+ *  are scaled back to the ones before the sampling.
+ *
  *  $Date: 2009/05/25 15:08:35 $
  *  $Revision: 1.7 $
  *  \author M. Strang SUNY-Buffalo
  */
 
 // framework & common header files
-#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "DQMServices/Core/interface/DQMEDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -21,6 +37,10 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSubsystems.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCompactHits.h"
 //#include "Geometry/CommonDetUnit/interface/GeomDetUnit.h"
 //#include "DataFormats/DetId/interface/DetId.h"
 
@@ -73,7 +93,7 @@
 #include "TString.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
-class GlobalHitsHistogrammer : public edm::EDAnalyzer
+class GlobalHitsHistogrammer : public DQMEDAnalyzer
 {
   
  public:
@@ -82,9 +102,10 @@ class GlobalHitsHistogrammer : public edm::EDAnalyzer
 
   explicit GlobalHitsHistogrammer(const edm::ParameterSet&);
   virtual ~GlobalHitsHistogrammer();
-  virtual void beginJob( void );
-  virtual void endJob();  
-  virtual void analyze(const edm::Event&, const edm::EventSetup&);
+  virtual void bookHistograms(DQMStore::IBooker&, const edm::Run&,
+			      const edm::EventSetup&) override;
+  virtual void endStream() override;
+  virtual void analyze(const edm::Event&, const edm::EventSetup&) override;
   
  private:
 
@@ -96,12 +117,12 @@ class GlobalHitsHistogrammer : public edm::EDAnalyzer
   std::string label;
   bool getAllProvenances;
   bool printProvenanceInfo;
-
-  DQMStore *dbe;
-  std::string outputfile;
-  bool doOutput;
+  GlobalHitsSubsystems subsystems;
 
   edm::InputTag GlobalHitSrc_;
+  edm::EDGetTokenT<PGlobalSimHit> GlobalHitSrc_Token_;
+  edm::EDGetTokenT<GlobalHitsCompactHits> GlobalHitCompactSrc_Token_;
+  edm::EDGetTokenT<std::vector<float> > GlobalHitWeights_Token_;
 
   // G4MC info
   MonitorElement *meMCRGP[2];
@@ -185,7 +206,7 @@ class GlobalHitsHistogrammer : public edm::EDAnalyzer
   MonitorElement *meMuonRpcBToF[2];
   MonitorElement *meMuonRpcBR;
 
-  // private statistics information
+  // private statistics information, per stream
   unsigned int count;
 
 }; // end class declaration
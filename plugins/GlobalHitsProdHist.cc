@@ -0,0 +1,1738 @@
+/** \file GlobalHitsProdHist.cc
+ *  
+ *  See header file for description of class
+ *
+ *  $Date: 2012/09/04 20:38:34 $
+ *  $Revision: 1.6 $
+ *  \author M. Strang SUNY-Buffalo
+ */
+
+#include "Validation/GlobalHits/plugins/GlobalHitsProdHist.h"
+#include "Geometry/Records/interface/CaloGeometryRecord.h"
+
+GlobalHitsProdHist::GlobalHitsProdHist(const edm::ParameterSet& iPSet,
+				       const GlobalHitsJobCache*) :
+  fName(""), verbosity(0), frequency(0), vtxunit(0), 
+  getAllProvenances(false), printProvenanceInfo(false),
+  subsystems(iPSet, "GlobalHitsProdHist_GlobalHitsProdHist"),
+  G4VtxSrc_(iPSet.getParameter<edm::InputTag>("G4VtxSrc")),
+  G4TrkSrc_(iPSet.getParameter<edm::InputTag>("G4TrkSrc")),
+  stageTimes(iPSet.getUntrackedParameter<bool>("Timing", false))
+{
+  std::string MsgLoggerCat = "GlobalHitsProdHist_GlobalHitsProdHist";
+
+  // get information from parameter set
+  fName = iPSet.getUntrackedParameter<std::string>("Name");
+  verbosity = iPSet.getUntrackedParameter<int>("Verbosity");
+  frequency = iPSet.getUntrackedParameter<int>("Frequency");
+  vtxunit = iPSet.getUntrackedParameter<int>("VtxUnit");
+  edm::ParameterSet m_Prov =
+    iPSet.getParameter<edm::ParameterSet>("ProvenanceLookup");
+  getAllProvenances = 
+    m_Prov.getUntrackedParameter<bool>("GetAllProvenances");
+  printProvenanceInfo = 
+    m_Prov.getUntrackedParameter<bool>("PrintProvenanceInfo");
+  lumiProducts = 
+    iPSet.getUntrackedParameter<bool>("LumiProducts", false);
+
+  //get Labels to use to extract information
+  HepMCSrc_ = iPSet.getParameter<edm::InputTag>("HepMCSrc");
+
+  PxlBrlLowSrc_ = iPSet.getParameter<edm::InputTag>("PxlBrlLowSrc");
+  PxlBrlHighSrc_ = iPSet.getParameter<edm::InputTag>("PxlBrlHighSrc");
+  PxlFwdLowSrc_ = iPSet.getParameter<edm::InputTag>("PxlFwdLowSrc");
+  PxlFwdHighSrc_ = iPSet.getParameter<edm::InputTag>("PxlFwdHighSrc");
+
+  SiTIBLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTIBLowSrc");
+  SiTIBHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTIBHighSrc");
+  SiTOBLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTOBLowSrc");
+  SiTOBHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTOBHighSrc");
+  SiTIDLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTIDLowSrc");
+  SiTIDHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTIDHighSrc");
+  SiTECLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTECLowSrc");
+  SiTECHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTECHighSrc");
+
+  MuonCscSrc_ = iPSet.getParameter<edm::InputTag>("MuonCscSrc");
+  MuonDtSrc_ = iPSet.getParameter<edm::InputTag>("MuonDtSrc");
+  MuonRpcSrc_ = iPSet.getParameter<edm::InputTag>("MuonRpcSrc");
+
+  ECalEBSrc_ = iPSet.getParameter<edm::InputTag>("ECalEBSrc");
+  ECalEESrc_ = iPSet.getParameter<edm::InputTag>("ECalEESrc");
+  ECalESSrc_ = iPSet.getParameter<edm::InputTag>("ECalESSrc");
+
+  HCalSrc_ = iPSet.getParameter<edm::InputTag>("HCalSrc");
+
+  // declare the products read in the event loop, for the enabled
+  // subsystems only
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    HepMCSrc_Token_ = consumes<edm::HepMCProduct>(HepMCSrc_);
+    G4VtxSrc_Token_ = consumes<edm::SimVertexContainer>(G4VtxSrc_);
+    G4TrkSrc_Token_ = consumes<edm::SimTrackContainer>(G4TrkSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    PxlBrlLowSrc_Token_ = consumes<edm::PSimHitContainer>(PxlBrlLowSrc_);
+    PxlBrlHighSrc_Token_ = consumes<edm::PSimHitContainer>(PxlBrlHighSrc_);
+    PxlFwdLowSrc_Token_ = consumes<edm::PSimHitContainer>(PxlFwdLowSrc_);
+    PxlFwdHighSrc_Token_ = consumes<edm::PSimHitContainer>(PxlFwdHighSrc_);
+    SiTIBLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIBLowSrc_);
+    SiTIBHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIBHighSrc_);
+    SiTOBLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTOBLowSrc_);
+    SiTOBHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTOBHighSrc_);
+    SiTIDLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIDLowSrc_);
+    SiTIDHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIDHighSrc_);
+    SiTECLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTECLowSrc_);
+    SiTECHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTECHighSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    MuonCscSrc_Token_ = consumes<edm::PSimHitContainer>(MuonCscSrc_);
+    MuonDtSrc_Token_ = consumes<edm::PSimHitContainer>(MuonDtSrc_);
+    MuonRpcSrc_Token_ = consumes<edm::PSimHitContainer>(MuonRpcSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    ECalEBSrc_Token_ = consumes<edm::PCaloHitContainer>(ECalEBSrc_);
+    ECalEESrc_Token_ = consumes<edm::PCaloHitContainer>(ECalEESrc_);
+    ECalESSrc_Token_ = consumes<edm::PCaloHitContainer>(ECalESSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal))
+    HCalSrc_Token_ = consumes<edm::PCaloHitContainer>(HCalSrc_);
+
+  // use value of first digit to determine default output level (inclusive)
+  // 0 is none, 1 is basic, 2 is fill output, 3 is gather output
+  verbosity %= 10;
+  diag = GlobalHitsDiagnostics(verbosity);
+  if (verbosity > 0 && !GlobalHitsDiagnostics::compiled)
+    edm::LogInfo(MsgLoggerCat)
+      << "Fill and store output of Verbosity " << verbosity
+      << " needs a build with GLOBALHITS_DEBUG (or EDM_ML_DEBUG) defined";
+
+  // print out Parameter Set information being used
+  if (verbosity >= 0) {
+    edm::LogInfo(MsgLoggerCat) 
+      << "\n===============================\n"
+      << "Initialized as stream EDProducer with parameter values:\n"
+      << "    Name          = " << fName << "\n"
+      << "    Verbosity     = " << verbosity << "\n"
+      << "    Frequency     = " << frequency << "\n"
+      << "    VtxUnit       = " << vtxunit << "\n"
+      << "    GetProv       = " << getAllProvenances << "\n"
+      << "    PrintProv     = " << printProvenanceInfo << "\n"
+      << "    Subsystems    = " << subsystems.names() << "\n"
+      << "    Timing        = " << stageTimes.enabled() << "\n"
+      << "    HepMCSrc      = " << HepMCSrc_.label() 
+      << ":" << HepMCSrc_.instance() << "\n"
+      << "    PxlBrlLowSrc  = " << PxlBrlLowSrc_.label() 
+      << ":" << PxlBrlLowSrc_.instance() << "\n"
+      << "    PxlBrlHighSrc = " << PxlBrlHighSrc_.label() 
+      << ":" << PxlBrlHighSrc_.instance() << "\n"
+      << "    PxlFwdLowSrc  = " << PxlFwdLowSrc_.label() 
+      << ":" << PxlBrlLowSrc_.instance() << "\n"
+      << "    PxlFwdHighSrc = " << PxlFwdHighSrc_.label() 
+      << ":" << PxlBrlHighSrc_.instance() << "\n"
+      << "    SiTIBLowSrc   = " << SiTIBLowSrc_.label() 
+      << ":" << SiTIBLowSrc_.instance() << "\n"
+      << "    SiTIBHighSrc  = " << SiTIBHighSrc_.label() 
+      << ":" << SiTIBHighSrc_.instance() << "\n"
+      << "    SiTOBLowSrc   = " << SiTOBLowSrc_.label() 
+      << ":" << SiTOBLowSrc_.instance() << "\n"
+      << "    SiTOBHighSrc  = " << SiTOBHighSrc_.label() 
+      << ":" << SiTOBHighSrc_.instance() << "\n"
+      << "    SiTIDLowSrc   = " << SiTIDLowSrc_.label() 
+      << ":" << SiTIDLowSrc_.instance() << "\n"
+      << "    SiTIDHighSrc  = " << SiTIDHighSrc_.label() 
+      << ":" << SiTIDHighSrc_.instance() << "\n"
+      << "    SiTECLowSrc   = " << SiTECLowSrc_.label() 
+      << ":" << SiTECLowSrc_.instance() << "\n"
+      << "    SiTECHighSrc  = " << SiTECHighSrc_.label() 
+      << ":" << SiTECHighSrc_.instance() << "\n"
+      << "    MuonCscSrc    = " << MuonCscSrc_.label() 
+      << ":" << MuonCscSrc_.instance() << "\n"
+      << "    MuonDtSrc     = " << MuonDtSrc_.label() 
+      << ":" << MuonDtSrc_.instance() << "\n"
+      << "    MuonRpcSrc    = " << MuonRpcSrc_.label() 
+      << ":" << MuonRpcSrc_.instance() << "\n"
+      << "    ECalEBSrc     = " << ECalEBSrc_.label() 
+      << ":" << ECalEBSrc_.instance() << "\n"
+      << "    ECalEESrc     = " << ECalEESrc_.label() 
+      << ":" << ECalEESrc_.instance() << "\n"
+      << "    ECalESSrc     = " << ECalESSrc_.label() 
+      << ":" << ECalESSrc_.instance() << "\n"
+      << "    HCalSrc       = " << HCalSrc_.label() 
+      << ":" << HCalSrc_.instance() << "\n"
+      << "===============================\n";
+  }
+
+  // histograms of disabled subsystems are never booked
+  for (Int_t i = 0; i < 2; ++i) {
+    hMCRGP[i] = 0;
+    hMCG4Vtx[i] = 0;
+    hGeantVtxX[i] = 0;
+    hGeantVtxY[i] = 0;
+    hGeantVtxZ[i] = 0;
+    hMCG4Trk[i] = 0;
+    hCaloEcal[i] = 0;
+    hCaloEcalE[i] = 0;
+    hCaloEcalToF[i] = 0;
+    hCaloPreSh[i] = 0;
+    hCaloPreShE[i] = 0;
+    hCaloPreShToF[i] = 0;
+    hCaloHcal[i] = 0;
+    hCaloHcalE[i] = 0;
+    hCaloHcalToF[i] = 0;
+    hTrackerPx[i] = 0;
+    hTrackerSi[i] = 0;
+    hMuon[i] = 0;
+    hMuonDtToF[i] = 0;
+    hMuonCscToF[i] = 0;
+    hMuonRpcFToF[i] = 0;
+    hMuonRpcBToF[i] = 0;
+  }
+  hGeantTrkPt = 0;
+  hGeantTrkE = 0;
+  hCaloEcalPhi = 0;
+  hCaloEcalEta = 0;
+  hCaloPreShPhi = 0;
+  hCaloPreShEta = 0;
+  hCaloHcalPhi = 0;
+  hCaloHcalEta = 0;
+  hTrackerPxPhi = 0;
+  hTrackerPxEta = 0;
+  hTrackerPxBToF = 0;
+  hTrackerPxBR = 0;
+  hTrackerPxFToF = 0;
+  hTrackerPxFZ = 0;
+  hTrackerSiPhi = 0;
+  hTrackerSiEta = 0;
+  hTrackerSiBToF = 0;
+  hTrackerSiBR = 0;
+  hTrackerSiFToF = 0;
+  hTrackerSiFZ = 0;
+  hMuonPhi = 0;
+  hMuonEta = 0;
+  hMuonDtR = 0;
+  hMuonCscZ = 0;
+  hMuonRpcFZ = 0;
+  hMuonRpcBR = 0;
+
+  //create histograms of the enabled subsystems
+  Char_t hname[200];
+  Char_t htitle[200];
+ 
+  // MCGeant
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    sprintf(hname,"hMCRGP1");
+    histName_.push_back(hname);
+    sprintf(htitle,"RawGenParticles");
+    hMCRGP[0] = new GlobalHitsHist1D(hname,htitle,100,0.,5000.);
+    sprintf(hname,"hMCRGP2");
+    histName_.push_back(hname);
+    hMCRGP[1] = new GlobalHitsHist1D(hname,htitle,100,0.,500.);  
+    for (Int_t i = 0; i < 2; ++i) {
+      hMCRGP[i]->setXTitle("Number of Raw Generated Particles");
+      hMCRGP[i]->setYTitle("Count");
+      histMap_[hMCRGP[i]->name()] = hMCRGP[i];
+    }
+
+    sprintf(hname,"hMCG4Vtx1");
+    histName_.push_back(hname);
+    sprintf(htitle,"G4 Vertices");
+    hMCG4Vtx[0] = new GlobalHitsHist1D(hname,htitle,100,0.,50000.);
+    sprintf(hname,"hMCG4Vtx2");
+    histName_.push_back(hname);
+    hMCG4Vtx[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5); 
+    for (Int_t i = 0; i < 2; ++i) {
+      hMCG4Vtx[i]->setXTitle("Number of Vertices");
+      hMCG4Vtx[i]->setYTitle("Count");
+      histMap_[hMCG4Vtx[i]->name()] = hMCG4Vtx[i];
+    }
+
+    sprintf(hname,"hMCG4Trk1");
+    histName_.push_back(hname);
+    sprintf(htitle,"G4 Tracks");
+    hMCG4Trk[0] = new GlobalHitsHist1D(hname,htitle,150,0.,15000.);
+    sprintf(hname,"hMCG4Trk2");
+    histName_.push_back(hname);
+    hMCG4Trk[1] = new GlobalHitsHist1D(hname,htitle,150,-0.5,99.5);    
+    for (Int_t i = 0; i < 2; ++i) {
+      hMCG4Trk[i]->setXTitle("Number of Tracks");
+      hMCG4Trk[i]->setYTitle("Count");
+      histMap_[hMCG4Trk[i]->name()] = hMCG4Trk[i];
+    }
+
+    sprintf(hname,"hGeantVtxX1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Geant vertex x/micrometer");
+    hGeantVtxX[0] = new GlobalHitsHist1D(hname,htitle,100,-8000000.,8000000.);
+    sprintf(hname,"hGeantVtxX2");
+    histName_.push_back(hname);
+    hGeantVtxX[1] = new GlobalHitsHist1D(hname,htitle,100,-50.,50.); 
+    for (Int_t i = 0; i < 2; ++i) {
+      hGeantVtxX[i]->setXTitle("x of Vertex (um)");
+      hGeantVtxX[i]->setYTitle("Count");
+      histMap_[hGeantVtxX[i]->name()] = hGeantVtxX[i];
+    }
+
+    sprintf(hname,"hGeantVtxY1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Geant vertex y/micrometer");
+    hGeantVtxY[0] = new GlobalHitsHist1D(hname,htitle,100,-8000000,8000000.);
+    sprintf(hname,"hGeantVtxY2");
+    histName_.push_back(hname);
+    hGeantVtxY[1] = new GlobalHitsHist1D(hname,htitle,100,-50.,50.); 
+    for (Int_t i = 0; i < 2; ++i) {
+      hGeantVtxY[i]->setXTitle("y of Vertex (um)");
+      hGeantVtxY[i]->setYTitle("Count");
+      histMap_[hGeantVtxY[i]->name()] = hGeantVtxY[i];
+    }
+
+    sprintf(hname,"hGeantVtxZ1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Geant vertex z/millimeter");
+    hGeantVtxZ[0] = new GlobalHitsHist1D(hname,htitle,100,-11000.,11000.);
+    sprintf(hname,"hGeantVtxZ2");
+    histName_.push_back(hname);
+    hGeantVtxZ[1] = new GlobalHitsHist1D(hname,htitle,100,-250.,250.);
+    for (Int_t i = 0; i < 2; ++i) {
+      hGeantVtxZ[i]->setXTitle("z of Vertex (mm)");
+      hGeantVtxZ[i]->setYTitle("Count");
+      histMap_[hGeantVtxZ[i]->name()] = hGeantVtxZ[i];
+    }
+
+    sprintf(hname,"hGeantTrkPt");
+    histName_.push_back(hname);
+    sprintf(htitle,"Geant track pt/GeV");
+    hGeantTrkPt = new GlobalHitsHist1D(hname,htitle,100,0.,200.);
+    hGeantTrkPt->setXTitle("pT of Track (GeV)");
+    hGeantTrkPt->setYTitle("Count");
+    histMap_[hGeantTrkPt->name()] = hGeantTrkPt;
+
+    sprintf(hname,"hGeantTrkE");
+    histName_.push_back(hname);
+    sprintf(htitle,"Geant track E/GeV");
+    hGeantTrkE = new GlobalHitsHist1D(hname,htitle,100,0.,5000.);
+    hGeantTrkE->setXTitle("E of Track (GeV)");
+    hGeantTrkE->setYTitle("Count");
+    histMap_[hGeantTrkE->name()] = hGeantTrkE;
+  }
+
+  // ECal
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    sprintf(hname,"hCaloEcal1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Ecal hits");
+    hCaloEcal[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10000.);
+    sprintf(hname,"hCaloEcal2");
+    histName_.push_back(hname);
+    hCaloEcal[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5);
+
+    sprintf(hname,"hCaloEcalE1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Ecal hits, energy/GeV");
+    hCaloEcalE[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10.);
+    sprintf(hname,"hCaloEcalE2");
+    histName_.push_back(hname);
+    hCaloEcalE[1] = new GlobalHitsHist1D(hname,htitle,100,0.,0.1);
+
+    sprintf(hname,"hCaloEcalToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Ecal hits, ToF/ns");
+    hCaloEcalToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,1000.);
+    sprintf(hname,"hCaloEcalToF2");
+    histName_.push_back(hname);
+    hCaloEcalToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,100.);
+
+    for (Int_t i = 0; i < 2; ++i) {
+      hCaloEcal[i]->setXTitle("Number of Hits");
+      hCaloEcal[i]->setYTitle("Count");
+      histMap_[hCaloEcal[i]->name()] = hCaloEcal[i];
+      hCaloEcalE[i]->setXTitle("Energy of Hits (GeV)");
+      hCaloEcalE[i]->setYTitle("Count");
+      histMap_[hCaloEcalE[i]->name()] = hCaloEcalE[i];
+      hCaloEcalToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hCaloEcalToF[i]->setYTitle("Count");
+      histMap_[hCaloEcalToF[i]->name()] = hCaloEcalToF[i];
+    }
+
+    sprintf(hname,"hCaloEcalPhi");
+    histName_.push_back(hname);
+    sprintf(htitle,"Ecal hits, phi/rad");
+    hCaloEcalPhi = new GlobalHitsHist1D(hname,htitle,100,-3.2,3.2);
+    hCaloEcalPhi->setXTitle("Phi of Hits (rad)");
+    hCaloEcalPhi->setYTitle("Count");
+    histMap_[hCaloEcalPhi->name()] = hCaloEcalPhi;
+
+    sprintf(hname,"hCaloEcalEta");
+    histName_.push_back(hname);
+    sprintf(htitle,"Ecal hits, eta");
+    hCaloEcalEta = new GlobalHitsHist1D(hname,htitle,100,-5.5,5.5);
+    hCaloEcalEta->setXTitle("Eta of Hits");
+    hCaloEcalEta->setYTitle("Count");
+    histMap_[hCaloEcalEta->name()] = hCaloEcalEta;
+
+    sprintf(hname,"hCaloPreSh1");
+    histName_.push_back(hname);
+    sprintf(htitle,"PreSh hits");
+    hCaloPreSh[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10000.);
+    sprintf(hname,"hCaloPreSh2");
+    histName_.push_back(hname);
+    hCaloPreSh[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5);
+
+    sprintf(hname,"hCaloPreShE1");
+    histName_.push_back(hname);
+    sprintf(htitle,"PreSh hits, energy/GeV");
+    hCaloPreShE[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10.);
+    sprintf(hname,"hCaloPreShE2");
+    histName_.push_back(hname);
+    hCaloPreShE[1] = new GlobalHitsHist1D(hname,htitle,100,0.,0.1);
+
+    sprintf(hname,"hCaloPreShToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"PreSh hits, ToF/ns");
+    hCaloPreShToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,1000.);
+    sprintf(hname,"hCaloPreShToF2");
+    histName_.push_back(hname);
+    hCaloPreShToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,100.);
+
+    for (Int_t i = 0; i < 2; ++i) {
+      hCaloPreSh[i]->setXTitle("Number of Hits");
+      hCaloPreSh[i]->setYTitle("Count");
+      histMap_[hCaloPreSh[i]->name()] = hCaloPreSh[i];
+      hCaloPreShE[i]->setXTitle("Energy of Hits (GeV)");
+      hCaloPreShE[i]->setYTitle("Count");
+      histMap_[hCaloPreShE[i]->name()] = hCaloPreShE[i];
+      hCaloPreShToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hCaloPreShToF[i]->setYTitle("Count");
+      histMap_[hCaloPreShToF[i]->name()] = hCaloPreShToF[i];
+    }
+
+    sprintf(hname,"hCaloPreShPhi");
+    histName_.push_back(hname);
+    sprintf(htitle,"PreSh hits, phi/rad");
+    hCaloPreShPhi = new GlobalHitsHist1D(hname,htitle,100,-3.2,3.2);
+    hCaloPreShPhi->setXTitle("Phi of Hits (rad)");
+    hCaloPreShPhi->setYTitle("Count");
+    histMap_[hCaloPreShPhi->name()] = hCaloPreShPhi;
+
+    sprintf(hname,"hCaloPreShEta");
+    histName_.push_back(hname);
+    sprintf(htitle,"PreSh hits, eta");
+    hCaloPreShEta = new GlobalHitsHist1D(hname,htitle,100,-5.5,5.5);
+    hCaloPreShEta->setXTitle("Eta of Hits");
+    hCaloPreShEta->setYTitle("Count");
+    histMap_[hCaloPreShEta->name()] = hCaloPreShEta;  
+  }
+
+  // Hcal
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal)) {
+    sprintf(hname,"hCaloHcal1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Hcal hits");
+    hCaloHcal[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10000.);
+    sprintf(hname,"hCaloHcal2");
+    histName_.push_back(hname);
+    hCaloHcal[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5);
+
+    sprintf(hname,"hCaloHcalE1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Hcal hits, energy/GeV");
+    hCaloHcalE[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10.);
+    sprintf(hname,"hCaloHcalE2");
+    histName_.push_back(hname);
+    hCaloHcalE[1] = new GlobalHitsHist1D(hname,htitle,100,0.,0.1);
+
+    sprintf(hname,"hCaloHcalToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Hcal hits, ToF/ns");
+    hCaloHcalToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,1000.);
+    sprintf(hname,"hCaloHcalToF2");
+    histName_.push_back(hname);
+    hCaloHcalToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,100.);
+
+    for (Int_t i = 0; i < 2; ++i) {
+      hCaloHcal[i]->setXTitle("Number of Hits");
+      hCaloHcal[i]->setYTitle("Count");
+      histMap_[hCaloHcal[i]->name()] = hCaloHcal[i];
+      hCaloHcalE[i]->setXTitle("Energy of Hits (GeV)");
+      hCaloHcalE[i]->setYTitle("Count");
+      histMap_[hCaloHcalE[i]->name()] = hCaloHcalE[i];
+      hCaloHcalToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hCaloHcalToF[i]->setYTitle("Count");
+      histMap_[hCaloHcalToF[i]->name()] = hCaloHcalToF[i];
+    }
+
+    sprintf(hname,"hCaloHcalPhi");
+    histName_.push_back(hname);
+    sprintf(htitle,"Hcal hits, phi/rad");
+    hCaloHcalPhi = new GlobalHitsHist1D(hname,htitle,100,-3.2,3.2);
+    hCaloHcalPhi->setXTitle("Phi of Hits (rad)");
+    hCaloHcalPhi->setYTitle("Count");
+    histMap_[hCaloHcalPhi->name()] = hCaloHcalPhi;
+
+    sprintf(hname,"hCaloHcalEta");
+    histName_.push_back(hname);
+    sprintf(htitle,"Hcal hits, eta");
+    hCaloHcalEta = new GlobalHitsHist1D(hname,htitle,100,-5.5,5.5);
+    hCaloHcalEta->setXTitle("Eta of Hits");
+    hCaloHcalEta->setYTitle("Count");
+    histMap_[hCaloHcalEta->name()] = hCaloHcalEta;
+  }
+
+  // tracker
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    sprintf(hname,"hTrackerPx1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel hits");
+    hTrackerPx[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10000.);
+    sprintf(hname,"hTrackerPx2");
+    histName_.push_back(hname);
+    hTrackerPx[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5);
+    for (Int_t i = 0; i < 2; ++i) {
+      hTrackerPx[i]->setXTitle("Number of Pixel Hits");
+      hTrackerPx[i]->setYTitle("Count");
+      histMap_[hTrackerPx[i]->name()] = hTrackerPx[i];
+    }
+
+    sprintf(hname,"hTrackerPxPhi");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel hits phi/rad");
+    hTrackerPxPhi = new GlobalHitsHist1D(hname,htitle,100,-3.2,3.2);
+    hTrackerPxPhi->setXTitle("Phi of Hits (rad)");
+    hTrackerPxPhi->setYTitle("Count");
+    histMap_[hTrackerPxPhi->name()] = hTrackerPxPhi;
+
+    sprintf(hname,"hTrackerPxEta");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel hits eta");
+    hTrackerPxEta = new GlobalHitsHist1D(hname,htitle,100,-3.5,3.5);
+    hTrackerPxEta->setXTitle("Eta of Hits");
+    hTrackerPxEta->setYTitle("Count");
+    histMap_[hTrackerPxEta->name()] = hTrackerPxEta;
+
+    sprintf(hname,"hTrackerPxBToF");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel barrel hits, ToF/ns");
+    hTrackerPxBToF = new GlobalHitsHist1D(hname,htitle,100,0.,40.);
+    hTrackerPxBToF->setXTitle("Time of Flight of Hits (ns)");
+    hTrackerPxBToF->setYTitle("Count");
+    histMap_[hTrackerPxBToF->name()] = hTrackerPxBToF;
+
+    sprintf(hname,"hTrackerPxBR");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel barrel hits, R/cm");
+    hTrackerPxBR = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    hTrackerPxBR->setXTitle("R of Hits (cm)");
+    hTrackerPxBR->setYTitle("Count");
+    histMap_[hTrackerPxBR->name()] = hTrackerPxBR;
+
+    sprintf(hname,"hTrackerPxFToF");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel forward hits, ToF/ns");
+    hTrackerPxFToF = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    hTrackerPxFToF->setXTitle("Time of Flight of Hits (ns)");
+    hTrackerPxFToF->setYTitle("Count");
+    histMap_[hTrackerPxFToF->name()] = hTrackerPxFToF;
+
+    sprintf(hname,"hTrackerPxFZ");
+    histName_.push_back(hname);
+    sprintf(htitle,"Pixel forward hits, Z/cm");
+    hTrackerPxFZ = new GlobalHitsHist1D(hname,htitle,200,-100.,100.);
+    hTrackerPxFZ->setXTitle("Z of Hits (cm)");
+    hTrackerPxFZ->setYTitle("Count");
+    histMap_[hTrackerPxFZ->name()] = hTrackerPxFZ;
+
+    sprintf(hname,"hTrackerSi1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon hits");
+    hTrackerSi[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10000.);
+    sprintf(hname,"hTrackerSi2");
+    histName_.push_back(hname);
+    hTrackerSi[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5);
+    for (Int_t i = 0; i < 2; ++i) { 
+      hTrackerSi[i]->setXTitle("Number of Silicon Hits");
+      hTrackerSi[i]->setYTitle("Count");
+      histMap_[hTrackerSi[i]->name()] = hTrackerSi[i];
+    }
+
+    sprintf(hname,"hTrackerSiPhi");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon hits phi/rad");
+    hTrackerSiPhi = new GlobalHitsHist1D(hname,htitle,100,-3.2,3.2);
+    hTrackerSiPhi->setXTitle("Phi of Hits (rad)");
+    hTrackerSiPhi->setYTitle("Count");
+    histMap_[hTrackerSiPhi->name()] = hTrackerSiPhi;
+
+    sprintf(hname,"hTrackerSiEta");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon hits eta");
+    hTrackerSiEta = new GlobalHitsHist1D(hname,htitle,100,-3.5,3.5);
+    hTrackerSiEta->setXTitle("Eta of Hits");
+    hTrackerSiEta->setYTitle("Count");
+    histMap_[hTrackerSiEta->name()] = hTrackerSiEta;
+
+    sprintf(hname,"hTrackerSiBToF");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon barrel hits, ToF/ns");
+    hTrackerSiBToF = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    hTrackerSiBToF->setXTitle("Time of Flight of Hits (ns)");
+    hTrackerSiBToF->setYTitle("Count");
+    histMap_[hTrackerSiBToF->name()] = hTrackerSiBToF;
+
+    sprintf(hname,"hTrackerSiBR");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon barrel hits, R/cm");
+    hTrackerSiBR = new GlobalHitsHist1D(hname,htitle,100,0.,200.);
+    hTrackerSiBR->setXTitle("R of Hits (cm)");
+    hTrackerSiBR->setYTitle("Count");
+    histMap_[hTrackerSiBR->name()] = hTrackerSiBR;
+
+    sprintf(hname,"hTrackerSiFToF");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon forward hits, ToF/ns");
+    hTrackerSiFToF = new GlobalHitsHist1D(hname,htitle,100,0.,75.);
+    hTrackerSiFToF->setXTitle("Time of Flight of Hits (ns)");
+    hTrackerSiFToF->setYTitle("Count");
+    histMap_[hTrackerSiFToF->name()] = hTrackerSiFToF;
+
+    sprintf(hname,"hTrackerSiFZ");
+    histName_.push_back(hname);
+    sprintf(htitle,"Silicon forward hits, Z/cm");
+    hTrackerSiFZ = new GlobalHitsHist1D(hname,htitle,200,-300.,300.);
+    hTrackerSiFZ->setXTitle("Z of Hits (cm)");
+    hTrackerSiFZ->setYTitle("Count");
+    histMap_[hTrackerSiFZ->name()] = hTrackerSiFZ;  
+  }
+
+  // muon
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    sprintf(hname,"hMuon1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon hits");
+    hMuon[0] = new GlobalHitsHist1D(hname,htitle,100,0.,10000.);
+    sprintf(hname,"hMuon2");
+    histName_.push_back(hname);
+    hMuon[1] = new GlobalHitsHist1D(hname,htitle,100,-0.5,99.5);
+    for (Int_t i = 0; i < 2; ++i) { 
+      hMuon[i]->setXTitle("Number of Muon Hits");
+      hMuon[i]->setYTitle("Count");
+      histMap_[hMuon[i]->name()] = hMuon[i];
+    }  
+
+    sprintf(hname,"hMuonPhi");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon hits phi/rad");
+    hMuonPhi = new GlobalHitsHist1D(hname,htitle,100,-3.2,3.2);
+    hMuonPhi->setXTitle("Phi of Hits (rad)");
+    hMuonPhi->setYTitle("Count");
+    histMap_[hMuonPhi->name()] = hMuonPhi;
+
+    sprintf(hname,"hMuonEta");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon hits eta");
+    hMuonEta = new GlobalHitsHist1D(hname,htitle,100,-3.5,3.5);
+    hMuonEta->setXTitle("Eta of Hits");
+    hMuonEta->setYTitle("Count");
+    histMap_[hMuonEta->name()] = hMuonEta;
+
+    sprintf(hname,"hMuonCscToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon CSC hits, ToF/ns");
+    hMuonCscToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,250.);
+    sprintf(hname,"hMuonCscToF2");
+    histName_.push_back(hname);
+    hMuonCscToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    for (Int_t i = 0; i < 2; ++i) {   
+      hMuonCscToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hMuonCscToF[i]->setYTitle("Count");
+      histMap_[hMuonCscToF[i]->name()] = hMuonCscToF[i];
+    }  
+
+    sprintf(hname,"hMuonCscZ");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon CSC hits, Z/cm");
+    hMuonCscZ = new GlobalHitsHist1D(hname,htitle,200,-1500.,1500.);
+    hMuonCscZ->setXTitle("Z of Hits (cm)");
+    hMuonCscZ->setYTitle("Count");
+    histMap_[hMuonCscZ->name()] = hMuonCscZ;
+
+    sprintf(hname,"hMuonDtToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon DT hits, ToF/ns");
+    hMuonDtToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,250.);
+    sprintf(hname,"hMuonDtToF2");
+    histName_.push_back(hname);
+    hMuonDtToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    for (Int_t i = 0; i < 2; ++i) {   
+      hMuonDtToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hMuonDtToF[i]->setYTitle("Count");
+      histMap_[hMuonDtToF[i]->name()] = hMuonDtToF[i];
+    } 
+
+    sprintf(hname,"hMuonDtR");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon DT hits, R/cm");
+    hMuonDtR = new GlobalHitsHist1D(hname,htitle,100,0.,1500.); 
+    hMuonDtR->setXTitle("R of Hits (cm)");
+    hMuonDtR->setYTitle("Count");
+    histMap_[hMuonDtR->name()] = hMuonDtR;
+
+    sprintf(hname,"hMuonRpcFToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon RPC forward hits, ToF/ns");
+    hMuonRpcFToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,250.);
+    sprintf(hname,"hMuonRpcFToF2");
+    histName_.push_back(hname);
+    hMuonRpcFToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    for (Int_t i = 0; i < 2; ++i) {   
+      hMuonRpcFToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hMuonRpcFToF[i]->setYTitle("Count");
+      histMap_[hMuonRpcFToF[i]->name()] = hMuonRpcFToF[i];
+    }  
+
+    sprintf(hname,"hMuonRpcFZ");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon RPC forward hits, Z/cm");
+    hMuonRpcFZ = new GlobalHitsHist1D(hname,htitle,201,-1500.,1500.);
+    hMuonRpcFZ->setXTitle("Z of Hits (cm)");
+    hMuonRpcFZ->setYTitle("Count");
+    histMap_[hMuonRpcFZ->name()] = hMuonRpcFZ;
+
+    sprintf(hname,"hMuonRpcBToF1");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon RPC barrel hits, ToF/ns");
+    hMuonRpcBToF[0] = new GlobalHitsHist1D(hname,htitle,100,0.,250.);
+    sprintf(hname,"hMuonRpcBToF2");
+    histName_.push_back(hname);
+    hMuonRpcBToF[1] = new GlobalHitsHist1D(hname,htitle,100,0.,50.);
+    for (Int_t i = 0; i < 2; ++i) {   
+      hMuonRpcBToF[i]->setXTitle("Time of Flight of Hits (ns)");
+      hMuonRpcBToF[i]->setYTitle("Count");
+      histMap_[hMuonRpcBToF[i]->name()] = hMuonRpcBToF[i];
+    }
+
+    sprintf(hname,"hMuonRpcBR");
+    histName_.push_back(hname);
+    sprintf(htitle,"Muon RPC barrel hits, R/cm");
+    hMuonRpcBR = new GlobalHitsHist1D(hname,htitle,100,0.,1500.);
+    hMuonRpcBR->setXTitle("R of Hits (cm)");
+    hMuonRpcBR->setYTitle("Count"); 
+    histMap_[hMuonRpcBR->name()] = hMuonRpcBR;
+  }
+
+  // histograms filled by the hit engine, per block
+  theSink.route(GlobalHitsColumns::PxlBrl,
+		0, 0, hTrackerPxBToF, 0, hTrackerPxBR, hTrackerPxPhi,
+		hTrackerPxEta);
+  theSink.route(GlobalHitsColumns::PxlFwd,
+		0, 0, hTrackerPxFToF, 0, hTrackerPxFZ, hTrackerPxPhi,
+		hTrackerPxEta);
+  theSink.route(GlobalHitsColumns::SiBrl,
+		0, 0, hTrackerSiBToF, 0, hTrackerSiBR, hTrackerSiPhi,
+		hTrackerSiEta);
+  theSink.route(GlobalHitsColumns::SiFwd,
+		0, 0, hTrackerSiFToF, 0, hTrackerSiFZ, hTrackerSiPhi,
+		hTrackerSiEta);
+  theSink.route(GlobalHitsColumns::MuonCsc,
+		0, 0, hMuonCscToF[0], hMuonCscToF[1], hMuonCscZ, hMuonPhi,
+		hMuonEta);
+  theSink.route(GlobalHitsColumns::MuonDt,
+		0, 0, hMuonDtToF[0], hMuonDtToF[1], hMuonDtR, hMuonPhi,
+		hMuonEta);
+  theSink.route(GlobalHitsColumns::MuonRpcFwd,
+		0, 0, hMuonRpcFToF[0], hMuonRpcFToF[1], hMuonRpcFZ, hMuonPhi,
+		hMuonEta);
+  theSink.route(GlobalHitsColumns::MuonRpcBrl,
+		0, 0, hMuonRpcBToF[0], hMuonRpcBToF[1], hMuonRpcBR, hMuonPhi,
+		hMuonEta);
+  theSink.route(GlobalHitsColumns::ECal,
+		hCaloEcalE[0], hCaloEcalE[1], hCaloEcalToF[0],
+		hCaloEcalToF[1], 0, hCaloEcalPhi, hCaloEcalEta);
+  theSink.route(GlobalHitsColumns::PreSh,
+		hCaloPreShE[0], hCaloPreShE[1], hCaloPreShToF[0],
+		hCaloPreShToF[1], 0, hCaloPreShPhi, hCaloPreShEta);
+  theSink.route(GlobalHitsColumns::HCal,
+		hCaloHcalE[0], hCaloHcalE[1], hCaloHcalToF[0],
+		hCaloHcalToF[1], 0, hCaloHcalPhi, hCaloHcalEta);
+
+  // create persistent objects
+  for (std::size_t i = 0; i < histName_.size(); ++i) {
+    produces<GlobalHitsHist1D, edm::InRun>(histName_[i]).setBranchAlias(histName_[i]);
+  }
+
+  // with per lumi products the histograms above only hold the current
+  // luminosity block and the run is accumulated in a second set
+  if (lumiProducts) {
+    runHist_.reserve(histName_.size());
+    for (std::size_t i = 0; i < histName_.size(); ++i) {
+      GlobalHitsHist1D* hist1D = histMap_[histName_[i]];
+      runHist_.push_back(*hist1D);
+      produces<GlobalHitsHist1D, edm::InLumi>(histName_[i]);
+    }
+    for (std::size_t i = 0; i < histName_.size(); ++i)
+      runMap_[histName_[i]] = &runHist_[i];
+  }
+}
+
+GlobalHitsProdHist::~GlobalHitsProdHist() 
+{
+  std::map<std::string, GlobalHitsHist1D*>::iterator iter;
+  for (iter = histMap_.begin(); iter != histMap_.end(); ++iter)
+    delete iter->second;
+}
+
+std::unique_ptr<GlobalHitsJobCache> 
+GlobalHitsProdHist::initializeGlobalCache(const edm::ParameterSet& iPSet)
+{
+  return std::unique_ptr<GlobalHitsJobCache>(new GlobalHitsJobCache(iPSet));
+}
+
+void GlobalHitsProdHist::globalEndJob(const GlobalHitsJobCache* iCache)
+{
+  std::string MsgLoggerCat = "GlobalHitsProdHist_endJob";
+  if (iCache->verbosity >= 0)
+    edm::LogInfo(MsgLoggerCat) 
+      << "Terminating having processed " << iCache->count << " events.";
+
+  if (iCache->times.enabled()) {
+    if (iCache->verbosity >= 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Stage times of all streams:" << iCache->times.summary() << "\n";
+    if (!iCache->timingJSON.empty() &&
+	!iCache->times.writeJSON(iCache->timingJSON, "GlobalHitsProdHist"))
+      edm::LogWarning(MsgLoggerCat)
+	<< "Unable to write stage times to " << iCache->timingJSON;
+  }
+  return;
+}
+
+void GlobalHitsProdHist::endStream()
+{
+  if (stageTimes.enabled()) {
+    std::lock_guard<std::mutex> guard(globalCache()->timesLock);
+    globalCache()->times.merge(stageTimes);
+  }
+  return;
+}
+
+void GlobalHitsProdHist::beginRun(const edm::Run& iRun, 
+				  const edm::EventSetup& iSetup)
+{
+  // the histograms are stored per run, so start each run empty
+  std::map<std::string, GlobalHitsHist1D*>::iterator iter;
+  for (iter = histMap_.begin(); iter != histMap_.end(); ++iter)
+    iter->second->reset();
+  for (std::size_t i = 0; i < runHist_.size(); ++i)
+    runHist_[i].reset();
+  return;
+}
+
+void GlobalHitsProdHist::beginLuminosityBlock(const edm::LuminosityBlock& 
+					      iLumi,
+					      const edm::EventSetup& iSetup)
+{
+  // with per lumi products each luminosity block starts empty
+  if (!lumiProducts) return;
+  std::map<std::string, GlobalHitsHist1D*>::iterator iter;
+  for (iter = histMap_.begin(); iter != histMap_.end(); ++iter)
+    iter->second->reset();
+  return;
+}
+
+void GlobalHitsProdHist::endLuminosityBlock(const edm::LuminosityBlock& 
+					    iLumi,
+					    const edm::EventSetup& iSetup)
+{
+  // keep the run total of this stream; the framework only calls
+  // endLuminosityBlockSummary afterwards, which still sees the lumi
+  if (!lumiProducts) return;
+  for (std::size_t i = 0; i < histName_.size(); ++i)
+    runHist_[i].add(*(histMap_[histName_[i]]));
+  return;
+}
+
+void GlobalHitsProdHist::produce(edm::Event& iEvent, 
+				 const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsProdHist_produce";
+
+  // keep track of number of events processed by all streams
+  unsigned int count = ++(globalCache()->count);
+
+  // get event id information
+  int nrun = iEvent.id().run();
+  int nevt = iEvent.id().event();
+
+  if (verbosity > 0) {
+    edm::LogInfo(MsgLoggerCat)
+      << "Processing run " << nrun << ", event " << nevt
+      << " (" << count << " events total)";
+  } else if (verbosity == 0) {
+    if (nevt%frequency == 0 || nevt == 1) {
+      edm::LogInfo(MsgLoggerCat)
+	<< "Processing run " << nrun << ", event " << nevt
+	<< " (" << count << " events total)";
+    }
+  }
+
+  // look at information available in the event, once per job
+  if (globalCache()->getAllProvenances.exchange(false)) {
+
+    std::vector<const edm::Provenance*> AllProv;
+    iEvent.getAllProvenance(AllProv);
+
+    if (verbosity >= 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Number of Provenances = " << AllProv.size();
+
+    if (globalCache()->printProvenanceInfo.exchange(false) && 
+	(verbosity >= 0)) {
+      TString eventout("\nProvenance info:\n");      
+
+      for (unsigned int i = 0; i < AllProv.size(); ++i) {
+	eventout += "\n       ******************************";
+	eventout += "\n       Module       : ";
+	eventout += AllProv[i]->moduleLabel();
+	eventout += "\n       ProductID    : ";
+	eventout += AllProv[i]->productID().id();
+	eventout += "\n       ClassName    : ";
+	eventout += AllProv[i]->className();
+	eventout += "\n       InstanceName : ";
+	eventout += AllProv[i]->productInstanceName();
+	eventout += "\n       BranchName   : ";
+	eventout += AllProv[i]->branchName();
+      }
+      eventout += "\n       ******************************\n";
+      edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+    }
+  }
+
+  // reset hit columns, keeping their capacity
+  SimHits.clear();
+
+  // call fill functions of the enabled subsystems
+  typedef GlobalHitsStageTimes T;
+  typedef GlobalHitsSubsystems S;
+  //gather G4MC information from event
+  if (subsystems.enabled(S::G4MC))
+    stageTimes.time(T::FillG4MC, [&] { fillG4MC(iEvent); });
+  // gather Tracker information from event
+  if (subsystems.enabled(S::Tracker))
+    stageTimes.time(T::FillTrk, [&] { fillTrk(iEvent,iSetup); });
+  // gather muon information from event
+  if (subsystems.enabled(S::Muon))
+    stageTimes.time(T::FillMuon, [&] { fillMuon(iEvent, iSetup); });
+  // gather Ecal information from event
+  if (subsystems.enabled(S::ECal))
+    stageTimes.time(T::FillECal, [&] { fillECal(iEvent, iSetup); });
+  // gather Hcal information from event
+  if (subsystems.enabled(S::HCal))
+    stageTimes.time(T::FillHCal, [&] { fillHCal(iEvent, iSetup); });
+
+  if (stageTimes.enabled()) countStageHits(iEvent);
+
+  if (verbosity > 0)
+    edm::LogInfo (MsgLoggerCat)
+      << "Done gathering data from event.";
+
+  return;
+}
+
+void GlobalHitsProdHist::endRunSummary(const edm::Run& iRun, 
+				       const edm::EventSetup& iSetup,
+				       GlobalHitsRunHistos* iSummary) const
+{
+  addToSummary(lumiProducts ? runMap_ : histMap_, iSummary,
+	       "GlobalHitsProdHist_endRunSummary");
+  return;
+}
+
+void GlobalHitsProdHist::endLuminosityBlockSummary(const edm::LuminosityBlock&
+						   iLumi,
+						   const edm::EventSetup& 
+						   iSetup,
+						   GlobalHitsRunHistos* 
+						   iSummary) const
+{
+  if (lumiProducts)
+    addToSummary(histMap_, iSummary,
+		 "GlobalHitsProdHist_endLuminosityBlockSummary");
+  return;
+}
+
+void GlobalHitsProdHist::addToSummary(const std::map<std::string,
+				      GlobalHitsHist1D*>& hists,
+				      GlobalHitsRunHistos* iSummary,
+				      const std::string& MsgLoggerCat) const
+{
+  // the framework serializes these calls, so the summary needs no lock
+  std::map<std::string, GlobalHitsHist1D*>::const_iterator iter;
+  if (iSummary->hists.empty()) {
+
+    // first stream to finish seeds the summary with copies
+    TString eventoutw;
+    bool warning = false;
+    for (std::size_t i = 0; i < histName_.size(); ++i) {
+      iter = hists.find(histName_[i]);
+      if (iter != hists.end()) {
+	iSummary->names.push_back(histName_[i]);
+	iSummary->hists.push_back(*(iter->second));
+      } else {
+	warning = true;
+	eventoutw += "\n Unable to find histogram with name " + histName_[i];
+      }
+    }
+    if (verbosity > 0 && warning)
+      edm::LogWarning(MsgLoggerCat) << eventoutw << "\n";
+
+  } else {
+
+    // later streams add their contents bin by bin
+    for (std::size_t i = 0; i < iSummary->names.size(); ++i) {
+      iter = hists.find(iSummary->names[i]);
+      if (iter != hists.end())
+	iSummary->hists[i].add(*(iter->second));
+    }
+  }
+
+  return;
+}
+
+std::shared_ptr<GlobalHitsRunHistos> 
+GlobalHitsProdHist::globalBeginRunSummary(const edm::Run& iRun,
+					  const edm::EventSetup& iSetup,
+					  const RunContext* iContext)
+{
+  return std::shared_ptr<GlobalHitsRunHistos>(new GlobalHitsRunHistos);
+}
+
+void GlobalHitsProdHist::globalEndRunSummary(const edm::Run& iRun,
+					     const edm::EventSetup& iSetup,
+					     const RunContext* iContext,
+					     GlobalHitsRunHistos* iSummary)
+{
+  return;
+}
+
+void GlobalHitsProdHist::globalEndRunProduce(edm::Run& iRun, 
+					     const edm::EventSetup& iSetup,
+					     const RunContext* iContext,
+					     const GlobalHitsRunHistos* 
+					     iSummary)
+{
+  putHistos(iRun, iSummary, iContext->global()->verbosity,
+	    "GlobalHitsProdHist_endRun");
+  return;
+}
+
+std::shared_ptr<GlobalHitsRunHistos> 
+GlobalHitsProdHist::globalBeginLuminosityBlockSummary(const 
+						      edm::LuminosityBlock&
+						      iLumi,
+						      const edm::EventSetup&
+						      iSetup,
+						      const 
+						      LuminosityBlockContext*
+						      iContext)
+{
+  return std::shared_ptr<GlobalHitsRunHistos>(new GlobalHitsRunHistos);
+}
+
+void GlobalHitsProdHist::globalEndLuminosityBlockSummary(const 
+							 edm::LuminosityBlock&
+							 iLumi,
+							 const 
+							 edm::EventSetup& 
+							 iSetup,
+							 const 
+							 LuminosityBlockContext*
+							 iContext,
+							 GlobalHitsRunHistos*
+							 iSummary)
+{
+  return;
+}
+
+void GlobalHitsProdHist::globalEndLuminosityBlockProduce(edm::LuminosityBlock&
+							 iLumi,
+							 const 
+							 edm::EventSetup& 
+							 iSetup,
+							 const 
+							 LuminosityBlockContext*
+							 iContext,
+							 const 
+							 GlobalHitsRunHistos*
+							 iSummary)
+{
+  // the summary stays empty unless LumiProducts is set
+  putHistos(iLumi, iSummary, iContext->global()->verbosity,
+	    "GlobalHitsProdHist_endLuminosityBlock");
+  return;
+}
+
+template <class P>
+void GlobalHitsProdHist::putHistos(P& iPrincipal,
+				   const GlobalHitsRunHistos* iSummary,
+				   int verbosity,
+				   const std::string& MsgLoggerCat)
+{
+  TString eventout;
+
+  if (verbosity > 0)
+    edm::LogInfo (MsgLoggerCat)
+      << "\nStoring histograms.";
+
+  // store persistent objects
+  for (std::size_t i = 0; i < iSummary->names.size(); ++i) {
+    std::auto_ptr<GlobalHitsHist1D> 
+      hist1D(new GlobalHitsHist1D(iSummary->hists[i]));
+    eventout += "\n Storing histogram " + iSummary->names[i];
+    iPrincipal.put(hist1D, iSummary->names[i]);
+  }
+
+  if (verbosity > 0)
+    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+
+  return;
+}
+
+void GlobalHitsProdHist::countStageHits(const edm::Event& iEvent)
+{
+  typedef GlobalHitsStageTimes T;
+
+  // the G4MC stage reads all vertices and tracks
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    edm::Handle<edm::SimVertexContainer> G4VtxContainer;
+    iEvent.getByToken(G4VtxSrc_Token_,G4VtxContainer);
+    edm::Handle<edm::SimTrackContainer> G4TrkContainer;
+    iEvent.getByToken(G4TrkSrc_Token_,G4TrkContainer);
+    unsigned long long nG4 = 0;
+    if (G4VtxContainer.isValid()) nG4 += G4VtxContainer->size();
+    if (G4TrkContainer.isValid()) nG4 += G4TrkContainer->size();
+    stageTimes.addHits(T::FillG4MC, nG4);
+  }
+
+  // the others left their hits in the columns
+  for (int s = T::FillTrk; s <= T::FillHCal; ++s)
+    stageTimes.addHits(T::Stage(s), T::columnHits(SimHits, T::Stage(s)));
+  return;
+}
+
+//==================fill and store functions================================
+void GlobalHitsProdHist::fillG4MC(edm::Event& iEvent)
+{
+
+  std::string MsgLoggerCat = "GlobalHitsProdHist_fillG4MC";
+ 
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+
+  //////////////////////
+  // get MC information
+  /////////////////////
+  edm::Handle<edm::HepMCProduct> HepMCEvt;
+  iEvent.getByToken(HepMCSrc_Token_,HepMCEvt);
+
+  if (!HepMCEvt.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find HepMCProduct in event!";
+    return;
+  } else if (diag.gather()) {
+    eventout << "\n          Using HepMCProduct: ";
+    eventout << HepMCSrc_.encode();
+  }
+  const HepMC::GenEvent* MCEvt = HepMCEvt->GetEvent();
+  nRawGenPart = MCEvt->particles_size();
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Raw Particles collected:......... ";
+    eventout << nRawGenPart;
+  }  
+
+  if (hMCRGP[0]) hMCRGP[0]->fill((float)nRawGenPart);
+  if (hMCRGP[1]) hMCRGP[1]->fill((float)nRawGenPart);  
+
+  ////////////////////////////
+  // get G4Vertex information
+  ////////////////////////////
+  // convert unit stored in SimVertex to mm
+  float unit = 0.;
+  if (vtxunit == 0) unit = 1.;  // already in mm
+  if (vtxunit == 1) unit = 10.; // stored in cm, convert to mm
+
+  edm::Handle<edm::SimVertexContainer> G4VtxContainer;
+  iEvent.getByToken(G4VtxSrc_Token_,G4VtxContainer);
+  if (!G4VtxContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find SimVertex in event!";
+    return;
+  }
+  int i = 0;
+  edm::SimVertexContainer::const_iterator itVtx;
+  for (itVtx = G4VtxContainer->begin(); itVtx != G4VtxContainer->end(); 
+       ++itVtx) {
+    
+    ++i;
+
+    const math::XYZTLorentzVector G4Vtx1(itVtx->position().x(),
+					 itVtx->position().y(),
+					 itVtx->position().z(),
+					 itVtx->position().e());
+
+    double G4Vtx[4];
+    G4Vtx1.GetCoordinates(G4Vtx);
+
+    if (hGeantVtxX[0]) hGeantVtxX[0]->fill((G4Vtx[0]*unit)/micrometer);
+    if (hGeantVtxX[1]) hGeantVtxX[1]->fill((G4Vtx[0]*unit)/micrometer);
+    
+    if (hGeantVtxY[0]) hGeantVtxY[0]->fill((G4Vtx[1]*unit)/micrometer);
+    if (hGeantVtxY[1]) hGeantVtxY[1]->fill((G4Vtx[1]*unit)/micrometer);
+    
+    if (hGeantVtxZ[0]) hGeantVtxZ[0]->fill((G4Vtx[2]*unit)/millimeter);
+    if (hGeantVtxZ[1]) hGeantVtxZ[1]->fill((G4Vtx[2]*unit)/millimeter); 
+    
+  }
+
+  if (diag.counts()) {
+    eventout << "\n          Number of G4Vertices collected:............ ";
+    eventout << i;
+  }  
+
+  if (hMCG4Vtx[0]) hMCG4Vtx[0]->fill((float)i);
+  if (hMCG4Vtx[1]) hMCG4Vtx[1]->fill((float)i);  
+
+  ///////////////////////////
+  // get G4Track information
+  ///////////////////////////
+  edm::Handle<edm::SimTrackContainer> G4TrkContainer;
+  iEvent.getByToken(G4TrkSrc_Token_,G4TrkContainer);
+  if (!G4TrkContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find SimTrack in event!";
+    return;
+  }
+  i = 0;
+  edm::SimTrackContainer::const_iterator itTrk;
+  for (itTrk = G4TrkContainer->begin(); itTrk != G4TrkContainer->end(); 
+       ++itTrk) {
+
+    ++i;
+
+    const math::XYZTLorentzVector G4Trk1(itTrk->momentum().x(),
+					 itTrk->momentum().y(),
+					 itTrk->momentum().z(),
+					 itTrk->momentum().e());
+    double G4Trk[4];
+    G4Trk1.GetCoordinates(G4Trk);
+
+    if (hGeantTrkPt) hGeantTrkPt->
+			fill(sqrt(G4Trk[0]*G4Trk[0]+G4Trk[1]*G4Trk[1]));
+    if (hGeantTrkE) hGeantTrkE->fill(G4Trk[3]);
+  } 
+
+  if (diag.counts()) {
+    eventout << "\n          Number of G4Tracks collected:.............. ";
+    eventout << i;
+  }  
+
+  if (hMCG4Trk[0]) hMCG4Trk[0]->fill((float)i);
+  if (hMCG4Trk[1]) hMCG4Trk[1]->fill((float)i); 
+
+  eventout.log(MsgLoggerCat);
+    
+  return;
+}
+
+void GlobalHitsProdHist::fillTrk(edm::Event& iEvent, 
+				 const edm::EventSetup& iSetup)
+{
+
+  nPxlHits = 0;
+  std::string MsgLoggerCat = "GlobalHitsProdHist_fillTrk";
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+  
+  // access the tracker geometry
+  edm::ESHandle<TrackerGeometry> theTrackerGeometry;
+  iSetup.get<TrackerDigiGeometryRecord>().get(theTrackerGeometry);
+  if (!theTrackerGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerDigiGeometryRecord in event!";
+    return;
+  }
+  if (theTrkCache.
+      update(iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier(),
+	     *theTrackerGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theTrkCache.size() << " tracker DetUnits";
+    
+  ///////////////////////////////
+  // get Pixel Barrel information
+  ///////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> thePxlBrlHits;
+  // extract low container
+  edm::Handle<edm::PSimHitContainer> PxlBrlLowContainer;
+  iEvent.getByToken(PxlBrlLowSrc_Token_,PxlBrlLowContainer);
+  if (!PxlBrlLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsPixelBarrelLowTof in event!";
+    return;
+  }
+  // extract high container
+  edm::Handle<edm::PSimHitContainer> PxlBrlHighContainer;
+  iEvent.getByToken(PxlBrlHighSrc_Token_,PxlBrlHighContainer);
+  if (!PxlBrlHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsPixelBarrelHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  thePxlBrlHits.add(*PxlBrlLowContainer);
+  thePxlBrlHits.add(*PxlBrlHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::PxlBrl>
+    (thePxlBrlHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Pixel Barrel Hits collected:..... ";
+    eventout << j;
+  }  
+  
+  nPxlHits += j;
+
+  /////////////////////////////////
+  // get Pixel Forward information
+  ////////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> thePxlFwdHits;
+  // extract low container
+  edm::Handle<edm::PSimHitContainer> PxlFwdLowContainer;
+  iEvent.getByToken(PxlFwdLowSrc_Token_,PxlFwdLowContainer);
+  if (!PxlFwdLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsPixelEndcapLowTof in event!";
+    return;
+  }
+  // extract high container
+  edm::Handle<edm::PSimHitContainer> PxlFwdHighContainer;
+  iEvent.getByToken(PxlFwdHighSrc_Token_,PxlFwdHighContainer);
+  if (!PxlFwdHighContainer.isValid()) {
+    edm::LogWarning("GlobalHitsProdHist_fillTrk")
+      << "Unable to find TrackerHitsPixelEndcapHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  thePxlFwdHits.add(*PxlFwdLowContainer);
+  thePxlFwdHits.add(*PxlFwdHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::PxlFwd>
+    (thePxlFwdHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Pixel Forward Hits collected:.... ";
+    eventout << j;
+  }  
+
+  nPxlHits += j;
+
+  if (hTrackerPx[0]) hTrackerPx[0]->fill((float)nPxlHits);
+  if (hTrackerPx[1]) hTrackerPx[1]->fill((float)nPxlHits); 
+
+  ///////////////////////////////////
+  // get Silicon Barrel information
+  //////////////////////////////////
+  nSiHits = 0;
+  GlobalHitsChainedRange<edm::PSimHitContainer> theSiBrlHits;
+  // extract TIB low container
+  edm::Handle<edm::PSimHitContainer> SiTIBLowContainer;
+  iEvent.getByToken(SiTIBLowSrc_Token_,SiTIBLowContainer);
+  if (!SiTIBLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTIBLowTof in event!";
+    return;
+  }
+  // extract TIB high container
+  edm::Handle<edm::PSimHitContainer> SiTIBHighContainer;
+  iEvent.getByToken(SiTIBHighSrc_Token_,SiTIBHighContainer);
+  if (!SiTIBHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTIBHighTof in event!";
+    return;
+  }
+  // extract TOB low container
+  edm::Handle<edm::PSimHitContainer> SiTOBLowContainer;
+  iEvent.getByToken(SiTOBLowSrc_Token_,SiTOBLowContainer);
+  if (!SiTOBLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTOBLowTof in event!";
+    return;
+  }
+  // extract TOB high container
+  edm::Handle<edm::PSimHitContainer> SiTOBHighContainer;
+  iEvent.getByToken(SiTOBHighSrc_Token_,SiTOBHighContainer);
+  if (!SiTOBHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTOBHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  theSiBrlHits.add(*SiTIBLowContainer);
+  theSiBrlHits.add(*SiTIBHighContainer);
+  theSiBrlHits.add(*SiTOBLowContainer);
+  theSiBrlHits.add(*SiTOBHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::SiBrl>
+    (theSiBrlHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Silicon Barrel Hits collected:... ";
+    eventout << j;
+  }  
+
+  nSiHits += j;
+
+  ///////////////////////////////////
+  // get Silicon Forward information
+  ///////////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> theSiFwdHits;
+  // extract TID low container
+  edm::Handle<edm::PSimHitContainer> SiTIDLowContainer;
+  iEvent.getByToken(SiTIDLowSrc_Token_,SiTIDLowContainer);
+  if (!SiTIDLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTIDLowTof in event!";
+    return;
+  }
+  // extract TID high container
+  edm::Handle<edm::PSimHitContainer> SiTIDHighContainer;
+  iEvent.getByToken(SiTIDHighSrc_Token_,SiTIDHighContainer);
+  if (!SiTIDHighContainer.isValid()) {
+    edm::LogWarning("GlobalHitsProdHist_fillTrk")
+      << "Unable to find TrackerHitsTIDHighTof in event!";
+    return;
+  }
+  // extract TEC low container
+  edm::Handle<edm::PSimHitContainer> SiTECLowContainer;
+  iEvent.getByToken(SiTECLowSrc_Token_,SiTECLowContainer);
+  if (!SiTECLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTECLowTof in event!";
+    return;
+  }
+  // extract TEC high container
+  edm::Handle<edm::PSimHitContainer> SiTECHighContainer;
+  iEvent.getByToken(SiTECHighSrc_Token_,SiTECHighContainer);
+  if (!SiTECHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTECHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  theSiFwdHits.add(*SiTIDLowContainer);
+  theSiFwdHits.add(*SiTIDHighContainer);
+  theSiFwdHits.add(*SiTECLowContainer);
+  theSiFwdHits.add(*SiTECHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::SiFwd>
+    (theSiFwdHits, theTrkCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Silicon Forward Hits collected:.. ";
+    eventout << j;
+  }  
+
+  nSiHits +=j;
+
+  if (hTrackerSi[0]) hTrackerSi[0]->fill((float)nSiHits);
+  if (hTrackerSi[1]) hTrackerSi[1]->fill((float)nSiHits); 
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+void GlobalHitsProdHist::fillMuon(edm::Event& iEvent, 
+				  const edm::EventSetup& iSetup)
+{
+  nMuonHits = 0;
+  std::string MsgLoggerCat = "GlobalHitsProdHist_fillMuon";
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+
+  ///////////////////////
+  // access the CSC Muon
+  ///////////////////////
+  // access the CSC Muon geometry
+  edm::ESHandle<CSCGeometry> theCSCGeometry;
+  iSetup.get<MuonGeometryRecord>().get(theCSCGeometry);
+  if (!theCSCGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonGeometryRecord for the CSCGeometry in event!";
+    return;
+  }
+  if (theCSCCache.
+      update(iSetup.get<MuonGeometryRecord>().cacheIdentifier(),
+	     *theCSCGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theCSCCache.size() << " CSC DetUnits";
+
+  // get Muon CSC information
+  edm::Handle<edm::PSimHitContainer> MuonCSCContainer;
+  iEvent.getByToken(MuonCscSrc_Token_,MuonCSCContainer);
+  if (!MuonCSCContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonCSCHits in event!";
+    return;
+  }
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonCsc>
+    (*MuonCSCContainer, theCSCCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of CSC muon Hits collected:......... ";
+    eventout << j;
+  }  
+
+  nMuonHits += j;
+
+  /////////////////////
+  // access the DT Muon
+  /////////////////////
+  // access the DT Muon geometry
+  edm::ESHandle<DTGeometry> theDTGeometry;
+  iSetup.get<MuonGeometryRecord>().get(theDTGeometry);
+  if (!theDTGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonGeometryRecord for the DTGeometry in event!";
+    return;
+  }
+  if (theDTCache.
+      update(iSetup.get<MuonGeometryRecord>().cacheIdentifier(),
+	     *theDTGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theDTCache.size() << " DT DetUnits";
+
+  // get Muon DT information
+  edm::Handle<edm::PSimHitContainer> MuonDtContainer;
+  iEvent.getByToken(MuonDtSrc_Token_,MuonDtContainer);
+  if (!MuonDtContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonDTHits in event!";
+    return;
+  }
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonDt>
+    (*MuonDtContainer, theDTCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of DT muon Hits collected:.......... ";
+    eventout << j;
+  } 
+
+  nMuonHits += j;
+
+  //int RPCBrl = 0, RPCFwd = 0;
+  ///////////////////////
+  // access the RPC Muon
+  ///////////////////////
+  // access the RPC Muon geometry
+  edm::ESHandle<RPCGeometry> theRPCGeometry;
+  iSetup.get<MuonGeometryRecord>().get(theRPCGeometry);
+  if (!theRPCGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonGeometryRecord for the RPCGeometry in event!";
+    return;
+  }
+  if (theRPCCache.
+      update(iSetup.get<MuonGeometryRecord>().cacheIdentifier(),
+	     *theRPCGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached frames of " << theRPCCache.size() << " RPC DetUnits";
+
+  // get Muon RPC information
+  edm::Handle<edm::PSimHitContainer> MuonRPCContainer;
+  iEvent.getByToken(MuonRpcSrc_Token_,MuonRPCContainer);
+  if (!MuonRPCContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonRPCHits in event!";
+    return;
+  }
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit, derive R/Z, phi and eta and fill the histograms
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonRpc>
+    (*MuonRPCContainer, theRPCCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of RPC muon Hits collected:......... ";
+    eventout << j;
+    eventout << "\n                    RPC Barrel muon Hits:............ ";
+    eventout << SimHits[GlobalHitsColumns::MuonRpcBrl].size();
+    eventout << "\n                    RPC Forward muon Hits:........... ";
+    eventout << SimHits[GlobalHitsColumns::MuonRpcFwd].size();
+  }  
+
+  nMuonHits += j;
+
+  if (hMuon[0]) hMuon[0]->fill((float)nMuonHits);
+  if (hMuon[1]) hMuon[1]->fill((float)nMuonHits); 
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+void GlobalHitsProdHist::fillECal(edm::Event& iEvent, 
+				  const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsProdHist_fillECal";
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+  
+  // access the calorimeter geometry
+  edm::ESHandle<CaloGeometry> theCaloGeometry;
+  iSetup.get<CaloGeometryRecord>().get(theCaloGeometry);
+  if (!theCaloGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find CaloGeometryRecord in event!";
+    return;
+  }
+  if (theCaloCache.
+      update(iSetup.get<CaloGeometryRecord>().cacheIdentifier(),
+	     *theCaloGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached " << theCaloCache.size() << " calorimeter cells";
+    
+  ///////////////////////////////
+  // get  ECal information
+  ///////////////////////////////
+  GlobalHitsChainedRange<edm::PCaloHitContainer> theECalHits;
+  // extract EB container
+  edm::Handle<edm::PCaloHitContainer> EBContainer;
+  iEvent.getByToken(ECalEBSrc_Token_,EBContainer);
+  if (!EBContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find EcalHitsEB in event!";
+    return;
+  }
+  // extract EE container
+  edm::Handle<edm::PCaloHitContainer> EEContainer;
+  iEvent.getByToken(ECalEESrc_Token_,EEContainer);
+  if (!EEContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find EcalHitsEE in event!";
+    return;
+  }
+  // chain the containers without copying them
+  theECalHits.add(*EBContainer);
+  theECalHits.add(*EEContainer);
+
+  // stage the hits with the phi and eta of their cells and fill the
+  // histograms
+  int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::ECal>
+    (theECalHits, theCaloCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of ECal Hits collected:............. ";
+    eventout << j;
+  }  
+
+  if (hCaloEcal[0]) hCaloEcal[0]->fill((float)j);
+  if (hCaloEcal[1]) hCaloEcal[1]->fill((float)j); 
+
+  ////////////////////////////
+  // Get Preshower information
+  ////////////////////////////
+  // extract PreShower container
+  edm::Handle<edm::PCaloHitContainer> PreShContainer;
+  iEvent.getByToken(ECalESSrc_Token_,PreShContainer);
+  if (!PreShContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find EcalHitsES in event!";
+    return;
+  }
+
+  GlobalHitsChainedRange<edm::PCaloHitContainer> thePreShHits;
+  thePreShHits.add(*PreShContainer);
+
+  // stage the hits with the phi and eta of their cells and fill the
+  // histograms
+  j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::PreSh>
+    (thePreShHits, theCaloCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of PreSh Hits collected:............ ";
+    eventout << j;
+  }  
+
+  if (hCaloPreSh[0]) hCaloPreSh[0]->fill((float)j);
+  if (hCaloPreSh[1]) hCaloPreSh[1]->fill((float)j); 
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+void GlobalHitsProdHist::fillHCal(edm::Event& iEvent, 
+				  const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsProdHist_fillHCal";
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+  
+  // access the calorimeter geometry
+  edm::ESHandle<CaloGeometry> theCaloGeometry;
+  iSetup.get<CaloGeometryRecord>().get(theCaloGeometry);
+  if (!theCaloGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find CaloGeometryRecord in event!";
+    return;
+  }
+  if (theCaloCache.
+      update(iSetup.get<CaloGeometryRecord>().cacheIdentifier(),
+	     *theCaloGeometry) && verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Cached " << theCaloCache.size() << " calorimeter cells";
+    
+  ///////////////////////////////
+  // get  HCal information
+  ///////////////////////////////
+  // extract HCal container
+  edm::Handle<edm::PCaloHitContainer> HCalContainer;
+  iEvent.getByToken(HCalSrc_Token_,HCalContainer);
+  if (!HCalContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find HCalHits in event!";
+    return;
+  }
+
+  // stage the hits with the phi and eta of their cells and fill the
+  // histograms
+  int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::HCal>
+    (*HCalContainer, theCaloCache, SimHits, theSink, MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of HCal Hits collected:............. ";
+    eventout << j;
+  }  
+
+  if (hCaloHcal[0]) hCaloHcal[0]->fill((float)j);
+  if (hCaloHcal[1]) hCaloHcal[1]->fill((float)j); 
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
@@ -0,0 +1,386 @@
+#ifndef GlobalHitsProdHist_h
+#define GlobalHitsProdHist_h
+
+/** \class GlobalHitsProdHist
+ *  
+ *  Class to fill dqm monitor elements from existing EDM file
+ *
+ *  Runs as an edm::stream module: each stream fills its own set of
+ *  histograms, which are summed into a GlobalHitsRunHistos run summary at
+ *  the end of the run and stored in the edm::Run from there.
+ *
+ *  With LumiProducts set the histograms of every luminosity block are
+ *  summed the same way and stored in the edm::LuminosityBlock as well;
+ *  each stream then keeps a second set with its run total.
+ *
+ *  The histograms are GlobalHitsHist1D, fixed binning counters that are
+ *  stored as they are; GlobalHitsProdHistStripper turns them into
+ *  MonitorElements.
+ *
+ *  The hit loops are the ones of GlobalHitsEngine, shared with the
+ *  GlobalHitsProducer; the histograms of every block are filled from its
+ *  columns by a GlobalHitsHistSink.
+ *
+ *  With Timing = true the wall and CPU time and the hits of every fill
+ *  stage are summed per stream, merged at endStream and reported at
+ *  endJob as hits per second, and written to TimingJSON if it is set.
+ *
+ *  Only the histograms of the subsystems in Subsystems are booked,
+ *  filled and put into the run.
+ *
+ *  $Date: 2013/02/27 13:28:59 $
+ *  $Revision: 1.9 $
+ *  \author M. Strang SUNY-Buffalo
+ */
+
+// framework & common header files
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "DataFormats/Provenance/interface/Provenance.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "Geometry/CommonDetUnit/interface/GeomDetUnit.h"
+#include "DataFormats/DetId/interface/DetId.h"
+#include "Validation/GlobalHits/interface/GlobalHitsChainedRange.h"
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+#include "Validation/GlobalHits/interface/GlobalHitsGeometryCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCaloCellCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsEngine.h"
+#include "Validation/GlobalHits/interface/GlobalHitsStageTimes.h"
+#include "Validation/GlobalHits/interface/GlobalHitsDiagnostics.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSubsystems.h"
+#include "Validation/GlobalHits/interface/GlobalHitsJobCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsHist1D.h"
+
+//DQM services
+//#include "DQMServices/Core/interface/DQMStore.h"
+//#include "FWCore/ServiceRegistry/interface/Service.h"
+
+// tracker info
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
+#include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
+
+// muon info
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+#include "Geometry/DTGeometry/interface/DTGeometry.h"
+#include "Geometry/RPCGeometry/interface/RPCGeometry.h"
+#include "DataFormats/MuonDetId/interface/MuonSubdetId.h"
+#include "DataFormats/MuonDetId/interface/RPCDetId.h"
+#include "DataFormats/MuonDetId/interface/DTWireId.h"
+
+// calorimeter info
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "DataFormats/HcalDetId/interface/HcalSubdetector.h"
+
+// data in edm::event
+#include "SimDataFormats/GeneratorProducts/interface/HepMCProduct.h"
+#include "SimDataFormats/Vertex/interface/SimVertexContainer.h"
+#include "SimDataFormats/Track/interface/SimTrackContainer.h"
+#include "SimDataFormats/TrackingHit/interface/PSimHitContainer.h"
+#include "SimDataFormats/CaloHit/interface/PCaloHitContainer.h"
+
+// helper files
+//#include <CLHEP/Vector/LorentzVector.h>
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "CLHEP/Units/GlobalSystemOfUnits.h"
+
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "TString.h"
+
+// sum over all streams of the histograms filled during one run or one
+// luminosity block
+struct GlobalHitsRunHistos
+{
+  std::vector<std::string> names;
+  std::vector<GlobalHitsHist1D> hists;
+};
+
+class GlobalHitsProdHist : 
+  public edm::stream::EDProducer<edm::GlobalCache<GlobalHitsJobCache>,
+				 edm::RunSummaryCache<GlobalHitsRunHistos>,
+				 edm::LuminosityBlockSummaryCache<GlobalHitsRunHistos>,
+				 edm::EndRunProducer,
+				 edm::EndLuminosityBlockProducer>
+{
+  
+ public:
+
+  //typedef std::vector<float> FloatVector;
+
+  explicit GlobalHitsProdHist(const edm::ParameterSet&,
+			      const GlobalHitsJobCache*);
+  virtual ~GlobalHitsProdHist();
+  virtual void beginRun(const edm::Run&, const edm::EventSetup&) override;
+  virtual void produce(edm::Event&, const edm::EventSetup&) override;
+  virtual void endRunSummary(const edm::Run&, const edm::EventSetup&,
+			     GlobalHitsRunHistos*) const override;
+  virtual void beginLuminosityBlock(const edm::LuminosityBlock&,
+				    const edm::EventSetup&) override;
+  virtual void endLuminosityBlock(const edm::LuminosityBlock&,
+				  const edm::EventSetup&) override;
+  virtual void endLuminosityBlockSummary(const edm::LuminosityBlock&,
+					 const edm::EventSetup&,
+					 GlobalHitsRunHistos*) const override;
+  virtual void endStream() override;
+
+  static std::unique_ptr<GlobalHitsJobCache> 
+    initializeGlobalCache(const edm::ParameterSet&);
+  static void globalEndJob(const GlobalHitsJobCache*);
+  static std::shared_ptr<GlobalHitsRunHistos> 
+    globalBeginRunSummary(const edm::Run&, const edm::EventSetup&,
+			  const RunContext*);
+  static void globalEndRunSummary(const edm::Run&, const edm::EventSetup&,
+				  const RunContext*, GlobalHitsRunHistos*);
+  static void globalEndRunProduce(edm::Run&, const edm::EventSetup&,
+				  const RunContext*, 
+				  const GlobalHitsRunHistos*);
+  static std::shared_ptr<GlobalHitsRunHistos> 
+    globalBeginLuminosityBlockSummary(const edm::LuminosityBlock&,
+				      const edm::EventSetup&,
+				      const LuminosityBlockContext*);
+  static void globalEndLuminosityBlockSummary(const edm::LuminosityBlock&,
+					      const edm::EventSetup&,
+					      const LuminosityBlockContext*,
+					      GlobalHitsRunHistos*);
+  static void globalEndLuminosityBlockProduce(edm::LuminosityBlock&,
+					      const edm::EventSetup&,
+					      const LuminosityBlockContext*,
+					      const GlobalHitsRunHistos*);
+  
+ private:
+
+  // summing of the stream histograms and storing of the sums
+  void addToSummary(const std::map<std::string, GlobalHitsHist1D*>&,
+		    GlobalHitsRunHistos*, const std::string&) const;
+  template <class P>
+    static void putHistos(P&, const GlobalHitsRunHistos*, int,
+			  const std::string&);
+
+  // production related methods
+  void fillG4MC(edm::Event&);
+  void fillTrk(edm::Event&, const edm::EventSetup&);
+  void fillMuon(edm::Event&, const edm::EventSetup&);
+  void fillECal(edm::Event&, const edm::EventSetup&);
+  void fillHCal(edm::Event&, const edm::EventSetup&);
+  void countStageHits(const edm::Event&);
+
+ private:
+
+  //  parameter information
+  std::string fName;
+  int verbosity;
+  GlobalHitsDiagnostics diag;    // per event output of fill and store
+  int frequency;
+  int vtxunit;
+  bool getAllProvenances;
+  bool printProvenanceInfo;
+  GlobalHitsSubsystems subsystems;
+  bool lumiProducts;
+
+  //DQMStore *dbe;
+  //std::string outputfile;
+
+  std::vector<std::string> histName_;
+  std::map<std::string, GlobalHitsHist1D*> histMap_;
+
+  // run totals of the stream when histMap_ holds one luminosity block
+  std::vector<GlobalHitsHist1D> runHist_;
+  std::map<std::string, GlobalHitsHist1D*> runMap_;
+
+  // G4MC info
+  GlobalHitsHist1D *hMCRGP[2];
+  GlobalHitsHist1D *hMCG4Vtx[2];
+  GlobalHitsHist1D *hGeantVtxX[2];
+  GlobalHitsHist1D *hGeantVtxY[2];  
+  GlobalHitsHist1D *hGeantVtxZ[2];  
+  GlobalHitsHist1D *hMCG4Trk[2];
+  GlobalHitsHist1D *hGeantTrkPt;
+  GlobalHitsHist1D *hGeantTrkE;
+  int nRawGenPart;  
+
+  edm::InputTag HepMCSrc_;
+  edm::EDGetTokenT<edm::HepMCProduct> HepMCSrc_Token_;
+  edm::InputTag G4VtxSrc_;
+  edm::EDGetTokenT<edm::SimVertexContainer> G4VtxSrc_Token_;
+  edm::InputTag G4TrkSrc_;
+  edm::EDGetTokenT<edm::SimTrackContainer> G4TrkSrc_Token_;
+
+  // Electromagnetic info
+  // ECal info
+  GlobalHitsHist1D *hCaloEcal[2];
+  GlobalHitsHist1D *hCaloEcalE[2];
+  GlobalHitsHist1D *hCaloEcalToF[2];
+  GlobalHitsHist1D *hCaloEcalPhi;
+  GlobalHitsHist1D *hCaloEcalEta;  
+  edm::InputTag ECalEBSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalEBSrc_Token_;
+  edm::InputTag ECalEESrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalEESrc_Token_;
+
+  // Preshower info
+  GlobalHitsHist1D *hCaloPreSh[2];
+  GlobalHitsHist1D *hCaloPreShE[2];
+  GlobalHitsHist1D *hCaloPreShToF[2];
+  GlobalHitsHist1D *hCaloPreShPhi;
+  GlobalHitsHist1D *hCaloPreShEta;
+  edm::InputTag ECalESSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalESSrc_Token_;
+
+  // Hadronic info
+  // HCal info
+  GlobalHitsHist1D *hCaloHcal[2];
+  GlobalHitsHist1D *hCaloHcalE[2];
+  GlobalHitsHist1D *hCaloHcalToF[2];
+  GlobalHitsHist1D *hCaloHcalPhi;
+  GlobalHitsHist1D *hCaloHcalEta;  
+  edm::InputTag HCalSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> HCalSrc_Token_;
+
+  // Tracker info
+  // Pixel info
+  int nPxlHits;
+  GlobalHitsHist1D *hTrackerPx[2];
+  GlobalHitsHist1D *hTrackerPxPhi;
+  GlobalHitsHist1D *hTrackerPxEta;
+  GlobalHitsHist1D *hTrackerPxBToF;
+  GlobalHitsHist1D *hTrackerPxBR;
+  GlobalHitsHist1D *hTrackerPxFToF;
+  GlobalHitsHist1D *hTrackerPxFZ;
+  edm::InputTag PxlBrlLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlBrlLowSrc_Token_;
+  edm::InputTag PxlBrlHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlBrlHighSrc_Token_;
+  edm::InputTag PxlFwdLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlFwdLowSrc_Token_;
+  edm::InputTag PxlFwdHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlFwdHighSrc_Token_;
+
+  // Strip info
+  int nSiHits;
+  GlobalHitsHist1D *hTrackerSi[2];
+  GlobalHitsHist1D *hTrackerSiPhi;
+  GlobalHitsHist1D *hTrackerSiEta;
+  GlobalHitsHist1D *hTrackerSiBToF;
+  GlobalHitsHist1D *hTrackerSiBR;
+  GlobalHitsHist1D *hTrackerSiFToF;
+  GlobalHitsHist1D *hTrackerSiFZ;
+  edm::InputTag SiTIBLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIBLowSrc_Token_;
+  edm::InputTag SiTIBHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIBHighSrc_Token_;
+  edm::InputTag SiTOBLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTOBLowSrc_Token_;
+  edm::InputTag SiTOBHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTOBHighSrc_Token_;
+  edm::InputTag SiTIDLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIDLowSrc_Token_;
+  edm::InputTag SiTIDHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIDHighSrc_Token_;
+  edm::InputTag SiTECLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTECLowSrc_Token_;
+  edm::InputTag SiTECHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTECHighSrc_Token_;
+
+  // Muon info
+  GlobalHitsHist1D *hMuon[2];
+  GlobalHitsHist1D *hMuonPhi;
+  GlobalHitsHist1D *hMuonEta;
+  int nMuonHits;
+
+  // DT info
+  GlobalHitsHist1D *hMuonDtToF[2];
+  GlobalHitsHist1D *hMuonDtR;
+  edm::InputTag MuonDtSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonDtSrc_Token_;
+  // CSC info
+  GlobalHitsHist1D *hMuonCscToF[2];
+  GlobalHitsHist1D *hMuonCscZ;
+  edm::InputTag MuonCscSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonCscSrc_Token_;
+  // RPC info
+  GlobalHitsHist1D *hMuonRpcFToF[2];
+  GlobalHitsHist1D *hMuonRpcFZ;
+  GlobalHitsHist1D *hMuonRpcBToF[2];
+  GlobalHitsHist1D *hMuonRpcBR;
+  edm::InputTag MuonRpcSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonRpcSrc_Token_;
+
+  // staged hit positions, turned into R/Z, phi and eta per block
+  GlobalHitsColumns SimHits;
+
+  // DetUnit frames, rebuilt when the geometry records change
+  GlobalHitsGeometryCache theTrkCache;
+  GlobalHitsGeometryCache theCSCCache;
+  GlobalHitsGeometryCache theDTCache;
+  GlobalHitsGeometryCache theRPCCache;
+
+  // calorimeter cells, rebuilt when the CaloGeometryRecord changes
+  GlobalHitsCaloCellCache theCaloCache;
+
+  // histograms filled from the columns of every block
+  GlobalHitsHistSink<GlobalHitsHist1D> theSink;
+
+  // fill stage times of this stream
+  GlobalHitsStageTimes stageTimes;
+
+}; // end class declaration
+  
+#endif
+
+#ifndef GlobalHitMap
+#define GlobalHitMap
+// geometry mapping
+static const int dTrk             = 1;
+static const int sdPxlBrl         = 1;
+static const int sdPxlFwd         = 2;
+static const int sdSiTIB          = 3;
+static const int sdSiTID          = 4;
+static const int sdSiTOB          = 5;
+static const int sdSiTEC          = 6;
+
+static const int dMuon            = 2;
+static const int sdMuonDT         = 1;
+static const int sdMuonCSC        = 2;
+static const int sdMuonRPC        = 3;
+static const int sdMuonRPCRgnBrl  = 0;
+static const int sdMuonRPCRgnFwdp = 1;
+static const int sdMuonRPCRgnFwdn = -1;
+
+static const int dEcal            = 3;
+static const int sdEcalBrl        = 1;
+static const int sdEcalFwd        = 2;
+static const int sdEcalPS         = 3;
+static const int sdEcalTT         = 4;
+static const int sdEcalLPnD       = 5;
+
+static const int dHcal            = 4;
+static const int sdHcalEmpty      = 0;
+static const int sdHcalBrl        = 1;
+static const int sdHcalEC         = 2;
+static const int sdHcalOut        = 3;
+static const int sdHcalFwd        = 4;
+static const int sdHcalTT         = 5;
+static const int sdHcalCalib      = 6;
+static const int sdHcalCompst     = 7;
+
+#endif
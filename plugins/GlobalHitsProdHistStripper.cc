@@ -7,7 +7,7 @@
  *  \author M. Strang SUNY-Buffalo
  */
 
-#include "Validation/GlobalHits/interface/GlobalHitsProdHistStripper.h"
+#include "Validation/GlobalHits/plugins/GlobalHitsProdHistStripper.h"
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
@@ -28,6 +28,10 @@ GlobalHitsProdHistStripper::GlobalHitsProdHistStripper(const
   vtxunit = iPSet.getUntrackedParameter<int>("VtxUnit");
   outputfile = iPSet.getParameter<std::string>("OutputFile");
   doOutput = iPSet.getParameter<bool>("DoOutput");
+  prodHistLabel = 
+    iPSet.getUntrackedParameter<std::string>("ProdHistLabel",
+					     "globalhitsprodhist");
+  accumulateRuns = iPSet.getUntrackedParameter<bool>("AccumulateRuns", false);
   edm::ParameterSet m_Prov =
     iPSet.getParameter<edm::ParameterSet>("ProvenanceLookup");
   getAllProvenances = 
@@ -40,6 +44,12 @@ GlobalHitsProdHistStripper::GlobalHitsProdHistStripper(const
   // 0 is none, 1 is basic, 2 is fill output, 3 is gather output
   verbosity %= 10;
 
+  // the histograms are collected from every producer in the run
+  consumesMany<GlobalHitsHist1D, edm::InRun>();
+
+  // the DQMStore is not thread safe
+  usesResource("DQMStore");
+
   // get dqm info
   dbe = 0;
   dbe = edm::Service<DQMStore>().operator->();
@@ -66,6 +76,8 @@ GlobalHitsProdHistStripper::GlobalHitsProdHistStripper(const
       << "    VtxUnit        = " << vtxunit << "\n"
       << "    OutputFile     = " << outputfile << "\n"
       << "    DoOutput      = " << doOutput << "\n"
+      << "    ProdHistLabel  = " << prodHistLabel << "\n"
+      << "    AccumulateRuns = " << accumulateRuns << "\n"
       << "    GetProv        = " << getAllProvenances << "\n"
       << "    PrintProv      = " << printProvenanceInfo << "\n"
       << "===============================\n";
@@ -75,8 +87,6 @@ GlobalHitsProdHistStripper::GlobalHitsProdHistStripper(const
 
 GlobalHitsProdHistStripper::~GlobalHitsProdHistStripper() 
 {
-  if (doOutput)
-    if (outputfile.size() != 0 && dbe) dbe->save(outputfile);
 }
 
 void GlobalHitsProdHistStripper::beginJob( void )
@@ -152,12 +162,10 @@ void GlobalHitsProdHistStripper::endRun(const edm::Run& iRun,
 {
   std::string MsgLoggerCat = "GlobalHitsProdHistStripper_endRun";
 
-  edm::Handle<TH1F> histogram1D;
-  std::vector<edm::Handle<TH1F> > allhistogram1D;
+  edm::Handle<GlobalHitsHist1D> histogram1D;
+  std::vector<edm::Handle<GlobalHitsHist1D> > allhistogram1D;
   iRun.getManyByType(allhistogram1D);
 
-  me.resize(allhistogram1D.size());
-
   for (uint i = 0; i < allhistogram1D.size(); ++i) {
     histogram1D = allhistogram1D[i];
     if(!histogram1D.isValid()) {
@@ -166,36 +174,22 @@ void GlobalHitsProdHistStripper::endRun(const edm::Run& iRun,
       continue;      
     }
 
-    me[i] = 0;
-
-    /*
-    std::cout << "Extracting histogram: " << std::endl
-	      << "       Module       : "
-	      << (histogram1D.provenance()->product()).moduleLabel()
-	      << std::endl
-	      << "       ProductID    : "
-	      << (histogram1D.provenance()->product()).productID().id()
-	      << std::endl
-	      << "       ClassName    : "
-	      << (histogram1D.provenance()->product()).className()
-	      << std::endl
-	      << "       InstanceName : "
-	      << (histogram1D.provenance()->product()).productInstanceName()
-	      << std::endl
-	      << "       BranchName   : "
-	      << (histogram1D.provenance()->product()).branchName()
-	      << std::endl;
-    */
-
     if ((histogram1D.provenance()->product()).moduleLabel()
-	!= "globalhitsprodhist") continue;
+	!= prodHistLabel) continue;
    
-    std::string histname = histogram1D->GetName();
-    
-    std::string subhist1 = histname.substr(1,5);
-    std::string subhist2 = histname.substr(1,4);
+    std::string histname = histogram1D->name();
+
+    // the MonitorElement is booked for the first run and reused after
+    MonitorElement* element = 0;
+    std::map<std::string,MonitorElement*>::iterator iter = 
+      monitorElements.find(histname);
+    if (iter != monitorElements.end()) {
+      element = iter->second;
+    } else if (dbe) {
+
+      std::string subhist1 = histname.substr(1,5);
+      std::string subhist2 = histname.substr(1,4);
 
-    if (dbe) {
       if (subhist1 == "CaloE" || subhist1 == "CaloP") {
 	dbe->setCurrentFolder("GlobalHitsV/ECal");
       } else if (subhist1 == "CaloH") {
@@ -209,27 +203,42 @@ void GlobalHitsProdHistStripper::endRun(const edm::Run& iRun,
 	dbe->setCurrentFolder("GlobalHitsV/Tracker");
       }
      
-      me[i] = dbe->book1D(histname,histogram1D->GetTitle(),
-		       histogram1D->GetXaxis()->GetNbins(),
-		       histogram1D->GetXaxis()->GetXmin(),
-		       histogram1D->GetXaxis()->GetXmax());
-      me[i]->setAxisTitle(histogram1D->GetXaxis()->GetTitle(),1);
-      me[i]->setAxisTitle(histogram1D->GetYaxis()->GetTitle(),2);
-      
+      element = dbe->book1D(histname,histogram1D->title(),
+			    histogram1D->nbins(),
+			    histogram1D->header().xmin,
+			    histogram1D->header().xmax);
+      element->setAxisTitle(histogram1D->xTitle(),1);
+      element->setAxisTitle(histogram1D->yTitle(),2);
+      monitorElements[histname] = element;
     }
-    
-    std::string mename = me[i]->getName();
-    
-    //std::cout << "Extracting histogram " << histname
-    //	      << " into MonitorElement " << mename
-    //	      << std::endl;
-    
-    for (Int_t x = 1; x <= histogram1D->GetXaxis()->GetNbins(); ++x) {
-      Double_t binx = histogram1D->GetBinCenter(x);
-      Double_t value = histogram1D->GetBinContent(x);
-      me[i]->Fill(binx,value);
+    if (!element) continue;
+
+    TH1* hist = element->getTH1();
+    if (hist->GetNbinsX() != (int)histogram1D->nbins() ||
+	hist->GetXaxis()->GetXmin() != histogram1D->header().xmin ||
+	hist->GetXaxis()->GetXmax() != histogram1D->header().xmax) {
+      edm::LogWarning(MsgLoggerCat)
+	<< "Binning of histogram " << histname 
+	<< " changed from the first run; skipped.";
+      continue;
     }
+
+    // add the bin contents including under- and overflow, their errors,
+    // the entries and the fill statistics in one go
+    if (!accumulateRuns) element->Reset();
+    histogram1D->addTo(hist);
+
+    if (verbosity > 1)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Extracted histogram " << histname << " into MonitorElement "
+	<< element->getName() << " with " << hist->GetEntries() 
+	<< " entries.";
   }
+
+  // rewritten at every run, so the file holds the last run, or all of
+  // them with AccumulateRuns
+  if (doOutput && outputfile.size() != 0 && dbe) dbe->save(outputfile);
+
   return;
 }
     /*
@@ -5,13 +5,20 @@
  *  
  *  Class to fill dqm monitor elements from existing EDM file
  *
+ *  The GlobalHitsHist1D run products of the ProdHistLabel module are
+ *  added into their MonitorElements as whole arrays: bin contents with
+ *  under- and overflow, errors, entries and statistics. Each element is
+ *  booked once and reused for later runs, where it is either reset
+ *  (default) or, with AccumulateRuns, keeps summing. With DoOutput the
+ *  DQMStore is saved into OutputFile at the end of every run.
+ *
  *  $Date: 2009/05/25 15:08:35 $
  *  $Revision: 1.6 $
  *  \author M. Strang SUNY-Buffalo
  */
 
 // framework & common header files
-#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/Run.h"
@@ -22,6 +29,7 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "Validation/GlobalHits/interface/GlobalHitsHist1D.h"
 
 //DQM services
 #include "DQMServices/Core/interface/DQMStore.h"
@@ -41,7 +49,9 @@
 #include "TString.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
 
-class GlobalHitsProdHistStripper : public edm::EDAnalyzer
+class GlobalHitsProdHistStripper : 
+  public edm::one::EDAnalyzer<edm::one::WatchRuns,
+			       edm::one::SharedResources>
 {
   
  public:
@@ -50,11 +60,11 @@ class GlobalHitsProdHistStripper : public edm::EDAnalyzer
 
   explicit GlobalHitsProdHistStripper(const edm::ParameterSet&);
   virtual ~GlobalHitsProdHistStripper();
-  virtual void beginJob( void );
-  virtual void endJob();  
-  virtual void analyze(const edm::Event&, const edm::EventSetup&);
-  virtual void beginRun(const edm::Run&, const edm::EventSetup&);
-  virtual void endRun(const edm::Run&, const edm::EventSetup&);
+  virtual void beginJob( void ) override;
+  virtual void endJob() override;
+  virtual void analyze(const edm::Event&, const edm::EventSetup&) override;
+  virtual void beginRun(const edm::Run&, const edm::EventSetup&) override;
+  virtual void endRun(const edm::Run&, const edm::EventSetup&) override;
   
  private:
 
@@ -70,11 +80,12 @@ class GlobalHitsProdHistStripper : public edm::EDAnalyzer
   DQMStore *dbe;
   std::string outputfile;
   bool doOutput;
+  std::string prodHistLabel;
+  bool accumulateRuns;
 
+  // booked MonitorElements by histogram name
   std::map<std::string,MonitorElement*> monitorElements;
 
-  std::vector<MonitorElement*> me;
-
   // G4MC info
   MonitorElement *meMCRGP[2];
   MonitorElement *meMCG4Vtx[2];
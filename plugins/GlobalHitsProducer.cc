@@ -0,0 +1,1305 @@
+/** \file GlobalHitsProducer.cc
+ *  
+ *  See header file for description of class
+ *
+ *  $Date: 2010/01/06 14:24:50 $
+ *  $Revision: 1.15 $
+ *  \author M. Strang SUNY-Buffalo
+ */
+
+#include "Validation/GlobalHits/plugins/GlobalHitsProducer.h"
+#include "Geometry/Records/interface/CaloGeometryRecord.h"
+
+#include "tbb/task_group.h"
+
+GlobalHitsProducer::GlobalHitsProducer(const edm::ParameterSet& iPSet,
+				       const GlobalHitsJobCache*) :
+  fName(""), verbosity(0), frequency(0), vtxunit(0), label(""), 
+  getAllProvenances(false), printProvenanceInfo(false), concurrentFill(false),
+  compactOutput(false),
+  subsystems(iPSet, "GlobalHitsProducer_GlobalHitsProducer"),
+  sampler(iPSet, "GlobalHitsProducer_GlobalHitsProducer"),
+  nRawGenPart(0), 
+  G4VtxSrc_(iPSet.getParameter<edm::InputTag>("G4VtxSrc")),
+  G4TrkSrc_(iPSet.getParameter<edm::InputTag>("G4TrkSrc")),
+  stageTimes(iPSet.getUntrackedParameter<bool>("Timing", false))
+  //ECalEBSrc_(""), ECalEESrc_(""), ECalESSrc_(""), HCalSrc_(""),
+  //PxlBrlLowSrc_(""), PxlBrlHighSrc_(""), PxlFwdLowSrc_(""),
+  //PxlFwdHighSrc_(""), SiTIBLowSrc_(""), SiTIBHighSrc_(""),
+  //SiTOBLowSrc_(""), SiTOBHighSrc_(""), SiTIDLowSrc_(""), 
+  //SiTIDHighSrc_(""), SiTECLowSrc_(""), SiTECHighSrc_(""),
+  //MuonDtSrc_(""), MuonCscSrc_(""), MuonRpcSrc_(""), 
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_GlobalHitsProducer";
+
+  // get information from parameter set
+  fName = iPSet.getUntrackedParameter<std::string>("Name");
+  verbosity = iPSet.getUntrackedParameter<int>("Verbosity");
+  frequency = iPSet.getUntrackedParameter<int>("Frequency");
+  vtxunit = iPSet.getUntrackedParameter<int>("VtxUnit");
+  label = iPSet.getParameter<std::string>("Label");
+  edm::ParameterSet m_Prov =
+    iPSet.getParameter<edm::ParameterSet>("ProvenanceLookup");
+  getAllProvenances = 
+    m_Prov.getUntrackedParameter<bool>("GetAllProvenances");
+  printProvenanceInfo = 
+    m_Prov.getUntrackedParameter<bool>("PrintProvenanceInfo");
+  concurrentFill = 
+    iPSet.getUntrackedParameter<bool>("ConcurrentFill", false);
+  compactOutput =
+    iPSet.getUntrackedParameter<bool>("CompactOutput", false);
+
+  //get Labels to use to extract information
+  HepMCSrc_ = iPSet.getParameter<edm::InputTag>("HepMCSrc");
+
+  PxlBrlLowSrc_ = iPSet.getParameter<edm::InputTag>("PxlBrlLowSrc");
+  PxlBrlHighSrc_ = iPSet.getParameter<edm::InputTag>("PxlBrlHighSrc");
+  PxlFwdLowSrc_ = iPSet.getParameter<edm::InputTag>("PxlFwdLowSrc");
+  PxlFwdHighSrc_ = iPSet.getParameter<edm::InputTag>("PxlFwdHighSrc");
+
+  SiTIBLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTIBLowSrc");
+  SiTIBHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTIBHighSrc");
+  SiTOBLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTOBLowSrc");
+  SiTOBHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTOBHighSrc");
+  SiTIDLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTIDLowSrc");
+  SiTIDHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTIDHighSrc");
+  SiTECLowSrc_ = iPSet.getParameter<edm::InputTag>("SiTECLowSrc");
+  SiTECHighSrc_ = iPSet.getParameter<edm::InputTag>("SiTECHighSrc");
+
+  MuonCscSrc_ = iPSet.getParameter<edm::InputTag>("MuonCscSrc");
+  MuonDtSrc_ = iPSet.getParameter<edm::InputTag>("MuonDtSrc");
+  MuonRpcSrc_ = iPSet.getParameter<edm::InputTag>("MuonRpcSrc");
+
+  ECalEBSrc_ = iPSet.getParameter<edm::InputTag>("ECalEBSrc");
+  ECalEESrc_ = iPSet.getParameter<edm::InputTag>("ECalEESrc");
+  ECalESSrc_ = iPSet.getParameter<edm::InputTag>("ECalESSrc");
+
+  HCalSrc_ = iPSet.getParameter<edm::InputTag>("HCalSrc");
+
+  // declare the products read in the event loop, for the enabled
+  // subsystems only
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    HepMCSrc_Token_ = consumes<edm::HepMCProduct>(HepMCSrc_);
+    G4VtxSrc_Token_ = consumes<edm::SimVertexContainer>(G4VtxSrc_);
+    G4TrkSrc_Token_ = consumes<edm::SimTrackContainer>(G4TrkSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    PxlBrlLowSrc_Token_ = consumes<edm::PSimHitContainer>(PxlBrlLowSrc_);
+    PxlBrlHighSrc_Token_ = consumes<edm::PSimHitContainer>(PxlBrlHighSrc_);
+    PxlFwdLowSrc_Token_ = consumes<edm::PSimHitContainer>(PxlFwdLowSrc_);
+    PxlFwdHighSrc_Token_ = consumes<edm::PSimHitContainer>(PxlFwdHighSrc_);
+    SiTIBLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIBLowSrc_);
+    SiTIBHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIBHighSrc_);
+    SiTOBLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTOBLowSrc_);
+    SiTOBHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTOBHighSrc_);
+    SiTIDLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIDLowSrc_);
+    SiTIDHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTIDHighSrc_);
+    SiTECLowSrc_Token_ = consumes<edm::PSimHitContainer>(SiTECLowSrc_);
+    SiTECHighSrc_Token_ = consumes<edm::PSimHitContainer>(SiTECHighSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    MuonCscSrc_Token_ = consumes<edm::PSimHitContainer>(MuonCscSrc_);
+    MuonDtSrc_Token_ = consumes<edm::PSimHitContainer>(MuonDtSrc_);
+    MuonRpcSrc_Token_ = consumes<edm::PSimHitContainer>(MuonRpcSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    ECalEBSrc_Token_ = consumes<edm::PCaloHitContainer>(ECalEBSrc_);
+    ECalEESrc_Token_ = consumes<edm::PCaloHitContainer>(ECalEESrc_);
+    ECalESSrc_Token_ = consumes<edm::PCaloHitContainer>(ECalESSrc_);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal))
+    HCalSrc_Token_ = consumes<edm::PCaloHitContainer>(HCalSrc_);
+
+  // use value of first digit to determine default output level (inclusive)
+  // 0 is none, 1 is basic, 2 is fill output, 3 is gather output
+  verbosity %= 10;
+  diag = GlobalHitsDiagnostics(verbosity);
+  if (verbosity > 0 && !GlobalHitsDiagnostics::compiled)
+    edm::LogInfo(MsgLoggerCat)
+      << "Fill and store output of Verbosity " << verbosity
+      << " needs a build with GLOBALHITS_DEBUG (or EDM_ML_DEBUG) defined";
+
+  // create persistent object
+  if (compactOutput)
+    produces<GlobalHitsCompactHits>(label);
+  else
+    produces<PGlobalSimHit>(label);
+  if (sampler.enabled()) {
+    SimHits.setSampler(&sampler);
+    produces<std::vector<float> >(label + "Weights");
+  }
+
+  // print out Parameter Set information being used
+  if (verbosity >= 0) {
+    edm::LogInfo(MsgLoggerCat) 
+      << "\n===============================\n"
+      << "Initialized as stream EDProducer with parameter values:\n"
+      << "    Name          = " << fName << "\n"
+      << "    Verbosity     = " << verbosity << "\n"
+      << "    Frequency     = " << frequency << "\n"
+      << "    VtxUnit       = " << vtxunit << "\n"
+      << "    Label         = " << label << "\n"
+      << "    GetProv       = " << getAllProvenances << "\n"
+      << "    PrintProv     = " << printProvenanceInfo << "\n"
+      << "    Subsystems    = " << subsystems.names() << "\n"
+      << "    Sampling      = " << sampler.summary() << "\n"
+      << "    ConcFill      = " << concurrentFill << "\n"
+      << "    CompactOutput = " << compactOutput << "\n"
+      << "    Timing        = " << stageTimes.enabled() << "\n"
+      << "    HepMCSrc      = " << HepMCSrc_.label() 
+      << ":" << HepMCSrc_.instance() << "\n"
+      << "    PxlBrlLowSrc  = " << PxlBrlLowSrc_.label() 
+      << ":" << PxlBrlLowSrc_.instance() << "\n"
+      << "    PxlBrlHighSrc = " << PxlBrlHighSrc_.label() 
+      << ":" << PxlBrlHighSrc_.instance() << "\n"
+      << "    PxlFwdLowSrc  = " << PxlFwdLowSrc_.label() 
+      << ":" << PxlBrlLowSrc_.instance() << "\n"
+      << "    PxlFwdHighSrc = " << PxlFwdHighSrc_.label() 
+      << ":" << PxlBrlHighSrc_.instance() << "\n"
+      << "    SiTIBLowSrc   = " << SiTIBLowSrc_.label() 
+      << ":" << SiTIBLowSrc_.instance() << "\n"
+      << "    SiTIBHighSrc  = " << SiTIBHighSrc_.label() 
+      << ":" << SiTIBHighSrc_.instance() << "\n"
+      << "    SiTOBLowSrc   = " << SiTOBLowSrc_.label() 
+      << ":" << SiTOBLowSrc_.instance() << "\n"
+      << "    SiTOBHighSrc  = " << SiTOBHighSrc_.label() 
+      << ":" << SiTOBHighSrc_.instance() << "\n"
+      << "    SiTIDLowSrc   = " << SiTIDLowSrc_.label() 
+      << ":" << SiTIDLowSrc_.instance() << "\n"
+      << "    SiTIDHighSrc  = " << SiTIDHighSrc_.label() 
+      << ":" << SiTIDHighSrc_.instance() << "\n"
+      << "    SiTECLowSrc   = " << SiTECLowSrc_.label() 
+      << ":" << SiTECLowSrc_.instance() << "\n"
+      << "    SiTECHighSrc  = " << SiTECHighSrc_.label() 
+      << ":" << SiTECHighSrc_.instance() << "\n"
+      << "    MuonCscSrc    = " << MuonCscSrc_.label() 
+      << ":" << MuonCscSrc_.instance() << "\n"
+      << "    MuonDtSrc     = " << MuonDtSrc_.label() 
+      << ":" << MuonDtSrc_.instance() << "\n"
+      << "    MuonRpcSrc    = " << MuonRpcSrc_.label() 
+      << ":" << MuonRpcSrc_.instance() << "\n"
+      << "    ECalEBSrc     = " << ECalEBSrc_.label() 
+      << ":" << ECalEBSrc_.instance() << "\n"
+      << "    ECalEESrc     = " << ECalEESrc_.label() 
+      << ":" << ECalEESrc_.instance() << "\n"
+      << "    ECalESSrc     = " << ECalESSrc_.label() 
+      << ":" << ECalESSrc_.instance() << "\n"
+      << "    HCalSrc       = " << HCalSrc_.label() 
+      << ":" << HCalSrc_.instance() << "\n"
+      << "===============================\n";
+  }
+
+  // migrated here from beginJob
+  clear();
+
+}
+
+GlobalHitsProducer::~GlobalHitsProducer() 
+{
+}
+
+std::unique_ptr<GlobalHitsJobCache> 
+GlobalHitsProducer::initializeGlobalCache(const edm::ParameterSet& iPSet)
+{
+  return std::unique_ptr<GlobalHitsJobCache>(new GlobalHitsJobCache(iPSet));
+}
+
+void GlobalHitsProducer::globalEndJob(const GlobalHitsJobCache* iCache)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_endJob";
+  if (iCache->verbosity >= 0)
+    edm::LogInfo(MsgLoggerCat) 
+      << "Terminating having processed " << iCache->count << " events.";
+
+  if (iCache->times.enabled()) {
+    if (iCache->verbosity >= 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Stage times of all streams:" << iCache->times.summary() << "\n";
+    if (!iCache->timingJSON.empty() &&
+	!iCache->times.writeJSON(iCache->timingJSON, "GlobalHitsProducer"))
+      edm::LogWarning(MsgLoggerCat)
+	<< "Unable to write stage times to " << iCache->timingJSON;
+  }
+  return;
+}
+
+void GlobalHitsProducer::endStream()
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_endStream";
+
+  if (stageTimes.enabled()) {
+    std::lock_guard<std::mutex> guard(globalCache()->timesLock);
+    globalCache()->times.merge(stageTimes);
+  }
+
+  if (verbosity >= 0) {
+    TString eventout("\nHit column high-water marks of this stream:");
+    for (int b = 0; b < GlobalHitsColumns::nBlocks; ++b) {
+      GlobalHitsColumns::Block block = GlobalHitsColumns::Block(b);
+      eventout += "\n          ";
+      eventout += GlobalHitsColumns::name(block);
+      eventout += " = ";
+      eventout += (ULong_t)SimHits.highWater(block);
+    }
+    eventout += "\n          Retained column memory (bytes) = ";
+    eventout += (ULong_t)SimHits.capacityBytes();
+    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  }
+  return;
+}
+
+void GlobalHitsProducer::produce(edm::Event& iEvent, 
+			       const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_produce";
+
+  // keep track of number of events processed by all streams
+  unsigned int count = ++(globalCache()->count);
+
+  // get event id information
+  int nrun = iEvent.id().run();
+  int nevt = iEvent.id().event();
+
+  if (verbosity > 0) {
+    edm::LogInfo(MsgLoggerCat)
+      << "Processing run " << nrun << ", event " << nevt
+      << " (" << count << " events total)";
+  } else if (verbosity == 0) {
+    if (nevt%frequency == 0 || nevt == 1) {
+      edm::LogInfo(MsgLoggerCat)
+	<< "Processing run " << nrun << ", event " << nevt
+	<< " (" << count << " events total)";
+    }
+  }
+
+  // clear event holders
+  clear();
+
+  // seed the hit sampling of this event
+  if (sampler.enabled()) sampler.setEvent(iEvent.id());
+
+  // look at information available in the event, once per job
+  if (globalCache()->getAllProvenances.exchange(false)) {
+
+    std::vector<const edm::Provenance*> AllProv;
+    iEvent.getAllProvenance(AllProv);
+
+    if (verbosity >= 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Number of Provenances = " << AllProv.size();
+
+    if (globalCache()->printProvenanceInfo.exchange(false) && 
+	(verbosity >= 0)) {
+      TString eventout("\nProvenance info:\n");      
+
+      for (unsigned int i = 0; i < AllProv.size(); ++i) {
+	eventout += "\n       ******************************";
+	eventout += "\n       Module       : ";
+	eventout += AllProv[i]->moduleLabel();
+	eventout += "\n       ProductID    : ";
+	eventout += AllProv[i]->productID().id();
+	eventout += "\n       ClassName    : ";
+	eventout += AllProv[i]->className();
+	eventout += "\n       InstanceName : ";
+	eventout += AllProv[i]->productInstanceName();
+	eventout += "\n       BranchName   : ";
+	eventout += AllProv[i]->branchName();
+      }
+      eventout += "\n       ******************************\n";
+      edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+    }
+  }
+
+  // fetch everything the fill functions need from the event and setup
+  getInputs(iEvent, iSetup);
+
+  // call fill functions; they only read the fetched products and each
+  // writes its own set of vectors, so they may run as concurrent tasks;
+  // each stage also only adds to its own entry of the stage times;
+  // disabled subsystems have nothing to fill or store
+  typedef GlobalHitsStageTimes T;
+  typedef GlobalHitsSubsystems S;
+  if (concurrentFill) {
+    tbb::task_group stages;
+    if (subsystems.enabled(S::G4MC))
+      stages.run([this] { stageTimes.time(T::FillG4MC, [this] { fillG4MC(); }); });
+    if (subsystems.enabled(S::Tracker))
+      stages.run([this] { stageTimes.time(T::FillTrk, [this] { fillTrk(); }); });
+    if (subsystems.enabled(S::Muon))
+      stages.run([this] { stageTimes.time(T::FillMuon, [this] { fillMuon(); }); });
+    if (subsystems.enabled(S::ECal))
+      stages.run([this] { stageTimes.time(T::FillECal, [this] { fillECal(); }); });
+    if (subsystems.enabled(S::HCal))
+      stages.run([this] { stageTimes.time(T::FillHCal, [this] { fillHCal(); }); });
+    stages.wait();
+  } else {
+    //gather G4MC information from event
+    if (subsystems.enabled(S::G4MC))
+      stageTimes.time(T::FillG4MC, [this] { fillG4MC(); });
+    // gather Tracker information from event
+    if (subsystems.enabled(S::Tracker))
+      stageTimes.time(T::FillTrk, [this] { fillTrk(); });
+    // gather muon information from event
+    if (subsystems.enabled(S::Muon))
+      stageTimes.time(T::FillMuon, [this] { fillMuon(); });
+    // gather Ecal information from event
+    if (subsystems.enabled(S::ECal))
+      stageTimes.time(T::FillECal, [this] { fillECal(); });
+    // gather Hcal information from event
+    if (subsystems.enabled(S::HCal))
+      stageTimes.time(T::FillHCal, [this] { fillHCal(); });
+  }
+
+  if (verbosity > 0)
+    edm::LogInfo (MsgLoggerCat)
+      << "Done gathering data from event.";
+
+  if (verbosity > 2)
+    edm::LogInfo (MsgLoggerCat)
+      << "Saving event contents:";
+
+  // produce object to put into event and store information in event
+  if (compactOutput) {
+    std::auto_ptr<GlobalHitsCompactHits> pOut(new GlobalHitsCompactHits);
+    store(*pOut);
+    iEvent.put(pOut,label);
+  } else {
+    std::auto_ptr<PGlobalSimHit> pOut(new PGlobalSimHit);
+    store(*pOut);
+    iEvent.put(pOut,label);
+  }
+
+  // weights of the sampled hits of every block
+  if (sampler.enabled()) {
+    std::auto_ptr<std::vector<float> >
+      pWeights(new std::vector<float>(GlobalHitsColumns::nBlocks));
+    for (int b = 0; b < GlobalHitsColumns::nBlocks; ++b)
+      (*pWeights)[b] = SimHits[GlobalHitsColumns::Block(b)].weight;
+    iEvent.put(pWeights,label + "Weights");
+  }
+
+  if (stageTimes.enabled()) countStageHits();
+
+  return;
+}
+
+template <class Product>
+void GlobalHitsProducer::store(Product& product)
+{
+  typedef GlobalHitsStageTimes T;
+  typedef GlobalHitsSubsystems S;
+
+  // call store functions
+  // store G4MC information in product
+  if (subsystems.enabled(S::G4MC))
+    stageTimes.time(T::StoreG4MC, [&] { storeG4MC(product); });
+  // store Tracker information in produce
+  if (subsystems.enabled(S::Tracker))
+    stageTimes.time(T::StoreTrk, [&] { storeTrk(product); });
+  // store Muon information in produce
+  if (subsystems.enabled(S::Muon))
+    stageTimes.time(T::StoreMuon, [&] { storeMuon(product); });
+  // store ECal information in produce
+  if (subsystems.enabled(S::ECal))
+    stageTimes.time(T::StoreECal, [&] { storeECal(product); });
+  // store HCal information in produce
+  if (subsystems.enabled(S::HCal))
+    stageTimes.time(T::StoreHCal, [&] { storeHCal(product); });
+}
+
+void GlobalHitsProducer::countStageHits()
+{
+  // every store stage writes the hits its fill stage gathered
+  typedef GlobalHitsStageTimes T;
+  const unsigned long long nG4 = G4VtxX.size() + G4TrkPt.size();
+  stageTimes.addHits(T::FillG4MC, nG4);
+  stageTimes.addHits(T::StoreG4MC, nG4);
+  const T::Stage fills[] = { T::FillTrk, T::FillMuon, T::FillECal,
+			     T::FillHCal };
+  const T::Stage stores[] = { T::StoreTrk, T::StoreMuon, T::StoreECal,
+			      T::StoreHCal };
+  for (unsigned int i = 0; i < 4; ++i) {
+    const unsigned long long n = T::columnHits(SimHits, fills[i]);
+    stageTimes.addHits(fills[i], n);
+    stageTimes.addHits(stores[i], n);
+  }
+  return;
+}
+
+void GlobalHitsProducer::getInputs(edm::Event& iEvent,
+				   const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_getInputs";
+
+  // G4MC info
+  if (subsystems.enabled(GlobalHitsSubsystems::G4MC)) {
+    iEvent.getByToken(HepMCSrc_Token_,HepMCEvt);
+    iEvent.getByToken(G4VtxSrc_Token_,G4VtxContainer);
+    iEvent.getByToken(G4TrkSrc_Token_,G4TrkContainer);
+  }
+
+  // tracker info
+  if (subsystems.enabled(GlobalHitsSubsystems::Tracker)) {
+    iSetup.get<TrackerDigiGeometryRecord>().get(theTrackerGeometry);
+    if (theTrackerGeometry.isValid() &&
+	theTrkCache.
+	update(iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier(),
+	       *theTrackerGeometry) && verbosity > 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Cached frames of " << theTrkCache.size() << " tracker DetUnits";
+    iEvent.getByToken(PxlBrlLowSrc_Token_,PxlBrlLowContainer);
+    iEvent.getByToken(PxlBrlHighSrc_Token_,PxlBrlHighContainer);
+    iEvent.getByToken(PxlFwdLowSrc_Token_,PxlFwdLowContainer);
+    iEvent.getByToken(PxlFwdHighSrc_Token_,PxlFwdHighContainer);
+    iEvent.getByToken(SiTIBLowSrc_Token_,SiTIBLowContainer);
+    iEvent.getByToken(SiTIBHighSrc_Token_,SiTIBHighContainer);
+    iEvent.getByToken(SiTOBLowSrc_Token_,SiTOBLowContainer);
+    iEvent.getByToken(SiTOBHighSrc_Token_,SiTOBHighContainer);
+    iEvent.getByToken(SiTIDLowSrc_Token_,SiTIDLowContainer);
+    iEvent.getByToken(SiTIDHighSrc_Token_,SiTIDHighContainer);
+    iEvent.getByToken(SiTECLowSrc_Token_,SiTECLowContainer);
+    iEvent.getByToken(SiTECHighSrc_Token_,SiTECHighContainer);
+  }
+
+  // muon info
+  if (subsystems.enabled(GlobalHitsSubsystems::Muon)) {
+    unsigned long long muonCacheId = 
+      iSetup.get<MuonGeometryRecord>().cacheIdentifier();
+    iSetup.get<MuonGeometryRecord>().get(theCSCGeometry);
+    if (theCSCGeometry.isValid() &&
+	theCSCCache.update(muonCacheId, *theCSCGeometry) && verbosity > 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Cached frames of " << theCSCCache.size() << " CSC DetUnits";
+    iSetup.get<MuonGeometryRecord>().get(theDTGeometry);
+    if (theDTGeometry.isValid() &&
+	theDTCache.update(muonCacheId, *theDTGeometry) && verbosity > 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Cached frames of " << theDTCache.size() << " DT DetUnits";
+    iSetup.get<MuonGeometryRecord>().get(theRPCGeometry);
+    if (theRPCGeometry.isValid() &&
+	theRPCCache.update(muonCacheId, *theRPCGeometry) && verbosity > 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Cached frames of " << theRPCCache.size() << " RPC DetUnits";
+    iEvent.getByToken(MuonCscSrc_Token_,MuonCSCContainer);
+    iEvent.getByToken(MuonDtSrc_Token_,MuonDtContainer);
+    iEvent.getByToken(MuonRpcSrc_Token_,MuonRPCContainer);
+  }
+
+  // calorimeter info
+  if (subsystems.calo()) {
+    iSetup.get<CaloGeometryRecord>().get(theCaloGeometry);
+    if (theCaloGeometry.isValid() &&
+	theCaloCache.
+	update(iSetup.get<CaloGeometryRecord>().cacheIdentifier(),
+	       *theCaloGeometry) && verbosity > 0)
+      edm::LogInfo(MsgLoggerCat)
+	<< "Cached " << theCaloCache.size() << " calorimeter cells";
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::ECal)) {
+    iEvent.getByToken(ECalEBSrc_Token_,EBContainer);
+    iEvent.getByToken(ECalEESrc_Token_,EEContainer);
+    iEvent.getByToken(ECalESSrc_Token_,PreShContainer);
+  }
+  if (subsystems.enabled(GlobalHitsSubsystems::HCal))
+    iEvent.getByToken(HCalSrc_Token_,HCalContainer);
+
+  return;
+}
+
+//==================fill and store functions================================
+void GlobalHitsProducer::fillG4MC()
+{
+
+  std::string MsgLoggerCat = "GlobalHitsProducer_fillG4MC";
+ 
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+
+  //////////////////////
+  // get MC information
+  /////////////////////
+  if (!HepMCEvt.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find HepMCProduct in event!";
+    return;
+  } else if (diag.gather()) {
+    eventout << "\n          Using HepMCProduct: ";
+    eventout << HepMCSrc_.encode();
+  }
+  const HepMC::GenEvent* MCEvt = HepMCEvt->GetEvent();
+  nRawGenPart = MCEvt->particles_size();
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Raw Particles collected:......... ";
+    eventout << nRawGenPart;
+  }  
+
+  ////////////////////////////
+  // get G4Vertex information
+  ////////////////////////////
+  // convert unit stored in SimVertex to mm
+  float unit = 0.;
+  if (vtxunit == 0) unit = 1.;  // already in mm
+  if (vtxunit == 1) unit = 10.; // stored in cm, convert to mm
+
+  if (!G4VtxContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find SimVertex in event!";
+    return;
+  }
+  G4VtxX.reserve(G4VtxContainer->size());
+  G4VtxY.reserve(G4VtxContainer->size());
+  G4VtxZ.reserve(G4VtxContainer->size());
+  int i = 0;
+  edm::SimVertexContainer::const_iterator itVtx;
+  for (itVtx = G4VtxContainer->begin(); itVtx != G4VtxContainer->end(); 
+       ++itVtx) {
+    
+    ++i;
+
+    const math::XYZTLorentzVector G4Vtx1(itVtx->position().x(),
+					 itVtx->position().y(),
+					 itVtx->position().z(),
+					 itVtx->position().e());
+    double G4Vtx[4];
+    G4Vtx1.GetCoordinates(G4Vtx);
+
+    G4VtxX.push_back((G4Vtx[0]*unit)/micrometer);
+    G4VtxY.push_back((G4Vtx[1]*unit)/micrometer);
+    G4VtxZ.push_back((G4Vtx[2]*unit)/millimeter);
+  }
+
+  if (diag.counts()) {
+    eventout << "\n          Number of G4Vertices collected:............ ";
+    eventout << i;
+  }  
+
+  ///////////////////////////
+  // get G4Track information
+  ///////////////////////////
+  if (!G4TrkContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find SimTrack in event!";
+    return;
+  }
+  G4TrkPt.reserve(G4TrkContainer->size());
+  G4TrkE.reserve(G4TrkContainer->size());
+  i = 0;
+  edm::SimTrackContainer::const_iterator itTrk;
+  for (itTrk = G4TrkContainer->begin(); itTrk != G4TrkContainer->end(); 
+       ++itTrk) {
+
+    ++i;
+
+    const math::XYZTLorentzVector G4Trk1(itTrk->momentum().x(),
+					 itTrk->momentum().y(),
+					 itTrk->momentum().z(),
+					 itTrk->momentum().e());
+    double G4Trk[4];
+    G4Trk1.GetCoordinates(G4Trk);
+
+    G4TrkPt.push_back(sqrt(G4Trk[0]*G4Trk[0]+G4Trk[1]*G4Trk[1])); //GeV
+    G4TrkE.push_back(G4Trk[3]);                                   //GeV
+  } 
+
+  if (diag.counts()) {
+    eventout << "\n          Number of G4Tracks collected:.............. ";
+    eventout << i;
+  }  
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+template <class Product>
+void GlobalHitsProducer::storeG4MC(Product& product)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_storeG4MC";
+
+  if (diag.dump()) {
+    GlobalHitsDiagnostics::Message eventout(true,
+					    "\n       nRawGenPart        = ");
+    eventout << nRawGenPart;
+    eventout << "\n       nG4Vtx             = ";
+    eventout << G4VtxX.size();
+    for (unsigned int i = 0; i < G4VtxX.size(); ++i) {
+      eventout << "\n          (x,y,z)         = (";
+      eventout << G4VtxX[i];
+      eventout << ", ";
+      eventout << G4VtxY[i];
+      eventout << ", ";
+      eventout << G4VtxZ[i];
+      eventout << ")";      
+    }
+    eventout << "\n       nG4Trk             = ";
+    eventout << G4TrkPt.size();
+    for (unsigned int i = 0; i < G4TrkPt.size(); ++i) {
+      eventout << "\n          (pt,e)          = (";
+      eventout << G4TrkPt[i];
+      eventout << ", ";
+      eventout << G4TrkE[i];
+      eventout << ")";
+    }    
+    eventout.log(MsgLoggerCat);
+  } // end verbose output
+
+  product.putRawGenPart(nRawGenPart);
+  product.putG4Vtx(G4VtxX, G4VtxY, G4VtxZ);
+  product.putG4Trk(G4TrkPt, G4TrkE);
+
+  return;
+}
+
+void GlobalHitsProducer::fillTrk()
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_fillTrk";
+
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+  
+  // access the tracker geometry
+  if (!theTrackerGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerDigiGeometryRecord in event!";
+    return;
+  }
+    
+  ///////////////////////////////
+  // get Pixel Barrel information
+  ///////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> thePxlBrlHits;
+  // check low container
+  if (!PxlBrlLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsPixelBarrelLowTof in event!";
+    return;
+  }
+  // check high container
+  if (!PxlBrlHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsPixelBarrelHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  thePxlBrlHits.add(*PxlBrlLowContainer);
+  thePxlBrlHits.add(*PxlBrlHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::PxlBrl>
+    (thePxlBrlHits, theTrkCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Pixel Barrel Hits collected:..... ";
+    eventout << j;
+  }  
+  
+  /////////////////////////////////
+  // get Pixel Forward information
+  ////////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> thePxlFwdHits;
+  // check low container
+  if (!PxlFwdLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsPixelEndcapLowTof in event!";
+    return;
+  }
+  // check high container
+  if (!PxlFwdHighContainer.isValid()) {
+    edm::LogWarning("GlobalHitsProducer_fillTrk")
+      << "Unable to find TrackerHitsPixelEndcapHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  thePxlFwdHits.add(*PxlFwdLowContainer);
+  thePxlFwdHits.add(*PxlFwdHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::PxlFwd>
+    (thePxlFwdHits, theTrkCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Pixel Forward Hits collected:.... ";
+    eventout << j;
+  }  
+
+  ///////////////////////////////////
+  // get Silicon Barrel information
+  //////////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> theSiBrlHits;
+  // check TIB low container
+  if (!SiTIBLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTIBLowTof in event!";
+    return;
+  }
+  // check TIB high container
+  if (!SiTIBHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTIBHighTof in event!";
+    return;
+  }
+  // check TOB low container
+  if (!SiTOBLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTOBLowTof in event!";
+    return;
+  }
+  // check TOB high container
+  if (!SiTOBHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTOBHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  theSiBrlHits.add(*SiTIBLowContainer);
+  theSiBrlHits.add(*SiTIBHighContainer);
+  theSiBrlHits.add(*SiTOBLowContainer);
+  theSiBrlHits.add(*SiTOBHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::SiBrl>
+    (theSiBrlHits, theTrkCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Silicon Barrel Hits collected:... ";
+    eventout << j;
+  }  
+
+  ///////////////////////////////////
+  // get Silicon Forward information
+  ///////////////////////////////////
+  GlobalHitsChainedRange<edm::PSimHitContainer> theSiFwdHits;
+  // check TID low container
+  if (!SiTIDLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTIDLowTof in event!";
+    return;
+  }
+  // check TID high container
+  if (!SiTIDHighContainer.isValid()) {
+    edm::LogWarning("GlobalHitsProducer_fillTrk")
+      << "Unable to find TrackerHitsTIDHighTof in event!";
+    return;
+  }
+  // check TEC low container
+  if (!SiTECLowContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTECLowTof in event!";
+    return;
+  }
+  // check TEC high container
+  if (!SiTECHighContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find TrackerHitsTECHighTof in event!";
+    return;
+  }
+  // chain the containers without copying them
+  theSiFwdHits.add(*SiTIDLowContainer);
+  theSiFwdHits.add(*SiTIDHighContainer);
+  theSiFwdHits.add(*SiTECLowContainer);
+  theSiFwdHits.add(*SiTECHighContainer);
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::SiFwd>
+    (theSiFwdHits, theTrkCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of Silicon Forward Hits collected:.. ";
+    eventout << j;
+  }  
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+template <class Product>
+void GlobalHitsProducer::storeTrk(Product& product)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_storeTrk";
+
+  // hit columns of this stage
+  const GlobalHitsColumns::Columns& PxlBrl =
+    SimHits[GlobalHitsColumns::PxlBrl];
+  const GlobalHitsColumns::Columns& PxlFwd =
+    SimHits[GlobalHitsColumns::PxlFwd];
+  const GlobalHitsColumns::Columns& SiBrl =
+    SimHits[GlobalHitsColumns::SiBrl];
+  const GlobalHitsColumns::Columns& SiFwd =
+    SimHits[GlobalHitsColumns::SiFwd];
+
+  if (diag.dump()) {
+    GlobalHitsDiagnostics::Message eventout(true,
+					    "\n       nPxlBrlHits        = ");
+    eventout << PxlBrl.tof.size();
+    for (unsigned int i = 0; i < PxlBrl.tof.size(); ++i) {
+      eventout << "\n          (tof,r,phi,eta) = (";
+      eventout << PxlBrl.tof[i];
+      eventout << ", ";
+      eventout << PxlBrl.pos[i];
+      eventout << ", ";
+      eventout << PxlBrl.phi[i];
+      eventout << ", ";
+      eventout << PxlBrl.eta[i];
+      eventout << ")";      
+    } // end PxlBrl output
+    eventout << "\n       nPxlFwdHits        = ";
+    eventout << PxlFwd.tof.size();
+    for (unsigned int i = 0; i < PxlFwd.tof.size(); ++i) {
+      eventout << "\n          (tof,z,phi,eta) = (";
+      eventout << PxlFwd.tof[i];
+      eventout << ", ";
+      eventout << PxlFwd.pos[i];
+      eventout << ", ";
+      eventout << PxlFwd.phi[i];
+      eventout << ", ";
+      eventout << PxlFwd.eta[i];
+      eventout << ")";      
+    } // end PxlFwd output
+    eventout << "\n       nSiBrlHits         = ";
+    eventout << SiBrl.tof.size();
+    for (unsigned int i = 0; i < SiBrl.tof.size(); ++i) {
+      eventout << "\n          (tof,r,phi,eta) = (";
+      eventout << SiBrl.tof[i];
+      eventout << ", ";
+      eventout << SiBrl.pos[i];
+      eventout << ", ";
+      eventout << SiBrl.phi[i];
+      eventout << ", ";
+      eventout << SiBrl.eta[i];
+      eventout << ")";      
+    } // end SiBrl output
+    eventout << "\n       nSiFwdHits         = ";
+    eventout << SiFwd.tof.size();
+    for (unsigned int i = 0; i < SiFwd.tof.size(); ++i) {
+      eventout << "\n          (tof,z,phi,eta) = (";
+      eventout << SiFwd.tof[i];
+      eventout << ", ";
+      eventout << SiFwd.pos[i];
+      eventout << ", ";
+      eventout << SiFwd.phi[i];
+      eventout << ", ";
+      eventout << SiFwd.eta[i];
+      eventout << ")";      
+    } // end SiFwd output
+    eventout.log(MsgLoggerCat);
+  } // end verbose output
+
+  product.putPxlBrlHits(PxlBrl.tof,PxlBrl.pos,PxlBrl.phi,PxlBrl.eta);
+  product.putPxlFwdHits(PxlFwd.tof,PxlFwd.pos,PxlFwd.phi,PxlFwd.eta);
+  product.putSiBrlHits(SiBrl.tof,SiBrl.pos,SiBrl.phi,SiBrl.eta);
+  product.putSiFwdHits(SiFwd.tof,SiFwd.pos,SiFwd.phi,SiFwd.eta);
+
+  return;
+}
+
+void GlobalHitsProducer::fillMuon()
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_fillMuon";
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+
+  //int i = 0, j = 0;
+  ///////////////////////
+  // access the CSC Muon
+  ///////////////////////
+  // access the CSC Muon geometry
+  if (!theCSCGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonGeometryRecord for the CSCGeometry in event!";
+    return;
+  }
+
+  // get Muon CSC information
+  if (!MuonCSCContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonCSCHits in event!";
+    return;
+  }
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  int j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonCsc>
+    (*MuonCSCContainer, theCSCCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of CSC muon Hits collected:......... ";
+    eventout << j;
+  }  
+
+  //i = 0, j = 0;
+  /////////////////////
+  // access the DT Muon
+  /////////////////////
+  // access the DT Muon geometry
+  if (!theDTGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonGeometryRecord for the DTGeometry in event!";
+    return;
+  }
+
+  // get Muon DT information
+  if (!MuonDtContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonDTHits in event!";
+    return;
+  }
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonDt>
+    (*MuonDtContainer, theDTCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of DT muon Hits collected:.......... ";
+    eventout << j;
+  } 
+
+  //i = 0, j = 0;
+  //int RPCBrl = 0, RPCFwd = 0;
+  ///////////////////////
+  // access the RPC Muon
+  ///////////////////////
+  // access the RPC Muon geometry
+  if (!theRPCGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonGeometryRecord for the RPCGeometry in event!";
+    return;
+  }
+
+  // get Muon RPC information
+  if (!MuonRPCContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find MuonRPCHits in event!";
+    return;
+  }
+
+  // stage the hits, transform them to global coordinates grouped by
+  // DetUnit and derive the R/Z, phi and eta columns
+  j = GlobalHitsEngine::fillSimHits<GlobalHitsSubdets::MuonRpc>
+    (*MuonRPCContainer, theRPCCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of RPC muon Hits collected:......... ";
+    eventout << j;
+    eventout << "\n                    RPC Barrel muon Hits:............ ";
+    eventout << SimHits[GlobalHitsColumns::MuonRpcBrl].size();
+    eventout << "\n                    RPC Forward muon Hits:........... ";
+    eventout << SimHits[GlobalHitsColumns::MuonRpcFwd].size();
+  }  
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+template <class Product>
+void GlobalHitsProducer::storeMuon(Product& product)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_storeMuon";
+
+  // hit columns of this stage
+  const GlobalHitsColumns::Columns& MuonCsc =
+    SimHits[GlobalHitsColumns::MuonCsc];
+  const GlobalHitsColumns::Columns& MuonDt =
+    SimHits[GlobalHitsColumns::MuonDt];
+  const GlobalHitsColumns::Columns& MuonRpcBrl =
+    SimHits[GlobalHitsColumns::MuonRpcBrl];
+  const GlobalHitsColumns::Columns& MuonRpcFwd =
+    SimHits[GlobalHitsColumns::MuonRpcFwd];
+
+  if (diag.dump()) {
+    GlobalHitsDiagnostics::Message eventout(true,
+					    "\n       nMuonCSCHits       = ");
+    eventout << MuonCsc.tof.size();
+    for (unsigned int i = 0; i < MuonCsc.tof.size(); ++i) {
+      eventout << "\n          (tof,z,phi,eta) = (";
+      eventout << MuonCsc.tof[i];
+      eventout << ", ";
+      eventout << MuonCsc.pos[i];
+      eventout << ", ";
+      eventout << MuonCsc.phi[i];
+      eventout << ", ";
+      eventout << MuonCsc.eta[i];
+      eventout << ")";      
+    } // end MuonCsc output
+    eventout << "\n       nMuonDtHits        = ";
+    eventout << MuonDt.tof.size();
+    for (unsigned int i = 0; i < MuonDt.tof.size(); ++i) {
+      eventout << "\n          (tof,r,phi,eta) = (";
+      eventout << MuonDt.tof[i];
+      eventout << ", ";
+      eventout << MuonDt.pos[i];
+      eventout << ", ";
+      eventout << MuonDt.phi[i];
+      eventout << ", ";
+      eventout << MuonDt.eta[i];
+      eventout << ")";      
+    } // end MuonDt output
+    eventout << "\n       nMuonRpcBrlHits    = ";
+    eventout << MuonRpcBrl.tof.size();
+    for (unsigned int i = 0; i < MuonRpcBrl.tof.size(); ++i) {
+      eventout << "\n          (tof,r,phi,eta) = (";
+      eventout << MuonRpcBrl.tof[i];
+      eventout << ", ";
+      eventout << MuonRpcBrl.pos[i];
+      eventout << ", ";
+      eventout << MuonRpcBrl.phi[i];
+      eventout << ", ";
+      eventout << MuonRpcBrl.eta[i];
+      eventout << ")";      
+    } // end MuonRpcBrl output
+    eventout << "\n       nMuonRpcFwdHits    = ";
+    eventout << MuonRpcFwd.tof.size();
+    for (unsigned int i = 0; i < MuonRpcFwd.tof.size(); ++i) {
+      eventout << "\n          (tof,z,phi,eta) = (";
+      eventout << MuonRpcFwd.tof[i];
+      eventout << ", ";
+      eventout << MuonRpcFwd.pos[i];
+      eventout << ", ";
+      eventout << MuonRpcFwd.phi[i];
+      eventout << ", ";
+      eventout << MuonRpcFwd.eta[i]; 
+      eventout << ")";      
+    } // end MuonRpcFwd output
+    eventout.log(MsgLoggerCat);
+  } // end verbose output
+
+  product.putMuonCscHits(MuonCsc.tof,MuonCsc.pos,MuonCsc.phi,MuonCsc.eta);
+  product.putMuonDtHits(MuonDt.tof,MuonDt.pos,MuonDt.phi,MuonDt.eta);
+  product.putMuonRpcBrlHits(MuonRpcBrl.tof,MuonRpcBrl.pos,MuonRpcBrl.phi,
+			     MuonRpcBrl.eta);
+  product.putMuonRpcFwdHits(MuonRpcFwd.tof,MuonRpcFwd.pos,MuonRpcFwd.phi,
+			     MuonRpcFwd.eta);
+
+  return;
+}
+
+void GlobalHitsProducer::fillECal()
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_fillECal";
+
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+  
+  // access the calorimeter geometry
+  if (!theCaloGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find CaloGeometryRecord in event!";
+    return;
+  }
+    
+  ///////////////////////////////
+  // get  ECal information
+  ///////////////////////////////
+  GlobalHitsChainedRange<edm::PCaloHitContainer> theECalHits;
+  // check EB container
+  if (!EBContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find EcalHitsEB in event!";
+    return;
+  }
+  // check EE container
+  if (!EEContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find EcalHitsEE in event!";
+    return;
+  }
+  // chain the containers without copying them
+  theECalHits.add(*EBContainer);
+  theECalHits.add(*EEContainer);
+
+  // stage the hits with the phi and eta of their cells
+  int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::ECal>
+    (theECalHits, theCaloCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of ECal Hits collected:............. ";
+    eventout << j;
+  }  
+
+  ////////////////////////////
+  // Get Preshower information
+  ////////////////////////////
+  // check PreShower container
+  if (!PreShContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find EcalHitsES in event!";
+    return;
+  }
+
+  GlobalHitsChainedRange<edm::PCaloHitContainer> thePreShHits;
+  thePreShHits.add(*PreShContainer);
+
+  // stage the hits with the phi and eta of their cells
+  j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::PreSh>
+    (thePreShHits, theCaloCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of PreSh Hits collected:............ ";
+    eventout << j;
+  }  
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+template <class Product>
+void GlobalHitsProducer::storeECal(Product& product)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_storeECal";
+
+  // hit columns of this stage
+  const GlobalHitsColumns::Columns& ECal =
+    SimHits[GlobalHitsColumns::ECal];
+  const GlobalHitsColumns::Columns& PreSh =
+    SimHits[GlobalHitsColumns::PreSh];
+
+  if (diag.dump()) {
+    GlobalHitsDiagnostics::Message eventout(true,
+					    "\n       nECalHits          = ");
+    eventout << ECal.e.size();
+    for (unsigned int i = 0; i < ECal.e.size(); ++i) {
+      eventout << "\n          (e,tof,phi,eta) = (";
+      eventout << ECal.e[i];
+      eventout << ", ";
+      eventout << ECal.tof[i];
+      eventout << ", ";
+      eventout << ECal.phi[i];
+      eventout << ", ";
+      eventout << ECal.eta[i];  
+      eventout << ")";   
+    } // end ECal output
+    eventout << "\n       nPreShHits         = ";
+    eventout << PreSh.e.size();
+    for (unsigned int i = 0; i < PreSh.e.size(); ++i) {
+      eventout << "\n          (e,tof,phi,eta) = (";
+      eventout << PreSh.e[i];
+      eventout << ", ";
+      eventout << PreSh.tof[i];
+      eventout << ", ";
+      eventout << PreSh.phi[i];
+      eventout << ", ";
+      eventout << PreSh.eta[i]; 
+      eventout << ")";    
+    } // end PreShower output
+    eventout.log(MsgLoggerCat);
+  } // end verbose output
+
+  product.putECalHits(ECal.e,ECal.tof,ECal.phi,ECal.eta);
+  product.putPreShHits(PreSh.e,PreSh.tof,PreSh.phi,PreSh.eta);
+
+  return;
+}
+
+void GlobalHitsProducer::fillHCal()
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_fillHCal";
+
+
+  GlobalHitsDiagnostics::Message eventout(diag.gather(),
+					  "\nGathering info:");
+  
+  // access the calorimeter geometry
+  if (!theCaloGeometry.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find CaloGeometryRecord in event!";
+    return;
+  }
+    
+  ///////////////////////////////
+  // get  HCal information
+  ///////////////////////////////
+  // check HCal container
+  if (!HCalContainer.isValid()) {
+    edm::LogWarning(MsgLoggerCat)
+      << "Unable to find HCalHits in event!";
+    return;
+  }
+
+  // stage the hits with the phi and eta of their cells
+  int j = GlobalHitsEngine::fillCaloHits<GlobalHitsSubdets::HCal>
+    (*HCalContainer, theCaloCache, SimHits, GlobalHitsColumnSink(),
+     MsgLoggerCat);
+
+  if (diag.counts()) {
+    eventout << "\n          Number of HCal Hits collected:............. ";
+    eventout << j;
+  }  
+
+  eventout.log(MsgLoggerCat);
+
+  return;
+}
+
+template <class Product>
+void GlobalHitsProducer::storeHCal(Product& product)
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_storeHCal";
+
+  // hit columns of this stage
+  const GlobalHitsColumns::Columns& HCal =
+    SimHits[GlobalHitsColumns::HCal];
+
+  if (diag.dump()) {
+    GlobalHitsDiagnostics::Message eventout(true,
+					    "\n       nHCalHits          = ");
+    eventout << HCal.e.size();
+    for (unsigned int i = 0; i < HCal.e.size(); ++i) {
+      eventout << "\n          (e,tof,phi,eta) = (";
+      eventout << HCal.e[i];
+      eventout << ", ";
+      eventout << HCal.tof[i];
+      eventout << ", ";
+      eventout << HCal.phi[i];
+      eventout << ", ";
+      eventout << HCal.eta[i];  
+      eventout << ")";      
+    } // end HCal output
+    eventout.log(MsgLoggerCat);
+  } // end verbose output
+
+  product.putHCalHits(HCal.e,HCal.tof,HCal.phi,HCal.eta);
+
+  return;
+}
+
+void GlobalHitsProducer::clear()
+{
+  std::string MsgLoggerCat = "GlobalHitsProducer_clear";
+
+  if (verbosity > 0)
+    edm::LogInfo(MsgLoggerCat)
+      << "Clearing event holders"; 
+
+  // reset G4MC info
+  nRawGenPart = 0;
+  G4VtxX.clear();
+  G4VtxY.clear();
+  G4VtxZ.clear();
+  G4TrkPt.clear();
+  G4TrkE.clear();
+
+  // reset hit columns, keeping their capacity
+  SimHits.clear();
+
+  return;
+}
@@ -0,0 +1,342 @@
+#ifndef GlobalHitsProducer_h
+#define GlobalHitsProducer_h
+
+/** \class GlobalHitsProducer
+ *  
+ *  Class to fill PGlobalSimHit object to be inserted into data stream 
+ *  containing information about various sub-systems in global coordinates 
+ *  with full geometry
+ *
+ *  Runs as an edm::stream module: each stream owns its copy of the hit
+ *  vectors and geometry caches below, so no per-event state is shared
+ *  between concurrently processed events. Job wide counters live in the
+ *  GlobalHitsJobCache.
+ *
+ *  All products and geometries are fetched by getInputs before the fill
+ *  functions run. The fill functions never touch the Event or EventSetup
+ *  and write disjoint vectors, so with ConcurrentFill = true they run as
+ *  parallel TBB tasks. The store functions still run in a fixed order
+ *  after the join, so the PGlobalSimHit is identical to the serial one.
+ *
+ *  The hit columns and G4 vectors are reserved from the input collection
+ *  sizes before each fill loop and keep their capacity between events;
+ *  endStream reports the per-block high-water marks and retained memory.
+ *
+ *  PSimHit positions are staged in local coordinates and each block is
+ *  moved to global coordinates by its geometry cache in one batch, grouped
+ *  by DetUnit. The hit loops themselves are the ones of GlobalHitsEngine,
+ *  shared with GlobalHitsAnalyzer and GlobalHitsProdHist.
+ *
+ *  With Timing = true the wall and CPU time and the hits of every fill and
+ *  store stage are summed per stream, merged at endStream and reported at
+ *  endJob as hits per second, and written to TimingJSON if it is set.
+ *
+ *  Only the subsystems in Subsystems are read and filled; the product
+ *  keeps empty hit lists for the others.
+ *
+ *  With CompactOutput = true a GlobalHitsCompactHits with 16 bit fixed
+ *  point hits is put instead of the PGlobalSimHit; the store functions
+ *  are templates over the product and write either one the same way.
+ *
+ *  With Sampling set, only a seeded random subset of the hits of each
+ *  block is kept (see GlobalHitsSampler), and the weight of the hits of
+ *  every block is put next to the product as a vector<float> in block
+ *  order, with instance name Label + "Weights".
+ *
+ *  $Date: 2012/09/04 20:38:33 $
+ *  $Revision: 1.15 $
+ *  \author M. Strang SUNY-Buffalo
+ */
+
+// framework & common header files
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "DataFormats/Provenance/interface/Provenance.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "Geometry/CommonDetUnit/interface/GeomDetUnit.h"
+#include "DataFormats/DetId/interface/DetId.h"
+#include "Validation/GlobalHits/interface/GlobalHitsGeometryCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsChainedRange.h"
+#include "Validation/GlobalHits/interface/GlobalHitsJobCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsColumns.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCaloCellCache.h"
+#include "Validation/GlobalHits/interface/GlobalHitsEngine.h"
+#include "Validation/GlobalHits/interface/GlobalHitsStageTimes.h"
+#include "Validation/GlobalHits/interface/GlobalHitsDiagnostics.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSubsystems.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCompactHits.h"
+#include "Validation/GlobalHits/interface/GlobalHitsSampler.h"
+
+// tracker info
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
+#include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
+
+// muon info
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+#include "Geometry/DTGeometry/interface/DTGeometry.h"
+#include "Geometry/RPCGeometry/interface/RPCGeometry.h"
+#include "DataFormats/MuonDetId/interface/MuonSubdetId.h"
+#include "DataFormats/MuonDetId/interface/RPCDetId.h"
+#include "DataFormats/MuonDetId/interface/DTWireId.h"
+
+// calorimeter info
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "DataFormats/HcalDetId/interface/HcalSubdetector.h"
+
+// data in edm::event
+#include "SimDataFormats/ValidationFormats/interface/PValidationFormats.h"
+#include "SimDataFormats/GeneratorProducts/interface/HepMCProduct.h"
+#include "SimDataFormats/Vertex/interface/SimVertexContainer.h"
+#include "SimDataFormats/Track/interface/SimTrackContainer.h"
+#include "SimDataFormats/TrackingHit/interface/PSimHitContainer.h"
+#include "SimDataFormats/CaloHit/interface/PCaloHitContainer.h"
+//#include "SimDataFormats/CrossingFrame/interface/CrossingFrame.h"
+//#include "SimDataFormats/CrossingFrame/interface/MixCollection.h"
+
+// helper files
+//#include <CLHEP/Vector/LorentzVector.h>
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "CLHEP/Units/GlobalSystemOfUnits.h"
+
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "TString.h"
+
+class PGlobalSimHit;
+  
+class GlobalHitsProducer : 
+  public edm::stream::EDProducer<edm::GlobalCache<GlobalHitsJobCache> >
+{
+  
+ public:
+
+  typedef std::vector<float> FloatVector;
+
+  explicit GlobalHitsProducer(const edm::ParameterSet&,
+			      const GlobalHitsJobCache*);
+  virtual ~GlobalHitsProducer();
+  virtual void produce(edm::Event&, const edm::EventSetup&) override;
+  virtual void endStream() override;
+
+  static std::unique_ptr<GlobalHitsJobCache> 
+    initializeGlobalCache(const edm::ParameterSet&);
+  static void globalEndJob(const GlobalHitsJobCache*);
+  
+ private:
+
+  //GlobalValidation(const GlobalValidation&);   
+  //const GlobalValidation& operator=(const GlobalValidation&);
+
+  // production related methods
+  void getInputs(edm::Event&, const edm::EventSetup&);
+  void fillG4MC();
+  template <class Product> void storeG4MC(Product&);
+  void fillTrk();
+  template <class Product> void storeTrk(Product&);
+  void fillMuon();
+  template <class Product> void storeMuon(Product&);
+  void fillECal();
+  template <class Product> void storeECal(Product&);
+  void fillHCal();
+  template <class Product> void storeHCal(Product&);
+
+  // run the store functions of the enabled subsystems into product
+  template <class Product> void store(Product&);
+
+  void clear();
+  void countStageHits();
+
+ private:
+
+  //  parameter information
+  std::string fName;
+  int verbosity;
+  GlobalHitsDiagnostics diag;    // per event output of fill and store
+  int frequency;
+  int vtxunit;
+  std::string label;
+  bool getAllProvenances;
+  bool printProvenanceInfo;
+  bool concurrentFill;
+  bool compactOutput;
+  GlobalHitsSubsystems subsystems;
+  GlobalHitsSampler sampler;
+
+  // G4MC info
+  int nRawGenPart;
+  FloatVector G4VtxX; 
+  FloatVector G4VtxY; 
+  FloatVector G4VtxZ; 
+  FloatVector G4TrkPt; 
+  FloatVector G4TrkE;
+
+  edm::InputTag HepMCSrc_;
+  edm::EDGetTokenT<edm::HepMCProduct> HepMCSrc_Token_;
+  edm::InputTag G4VtxSrc_;
+  edm::EDGetTokenT<edm::SimVertexContainer> G4VtxSrc_Token_;
+  edm::InputTag G4TrkSrc_;
+  edm::EDGetTokenT<edm::SimTrackContainer> G4TrkSrc_Token_;
+  edm::Handle<edm::HepMCProduct> HepMCEvt;
+  edm::Handle<edm::SimVertexContainer> G4VtxContainer;
+  edm::Handle<edm::SimTrackContainer> G4TrkContainer;
+
+  // Electromagnetic info
+  // ECal info
+  edm::InputTag ECalEBSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalEBSrc_Token_;
+  edm::InputTag ECalEESrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalEESrc_Token_;
+  edm::Handle<edm::PCaloHitContainer> EBContainer;
+  edm::Handle<edm::PCaloHitContainer> EEContainer;
+
+  // Preshower info
+  edm::InputTag ECalESSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> ECalESSrc_Token_;
+  edm::Handle<edm::PCaloHitContainer> PreShContainer;
+
+  // Hadronic info
+  // HCal info
+  edm::InputTag HCalSrc_;
+  edm::EDGetTokenT<edm::PCaloHitContainer> HCalSrc_Token_;
+  edm::Handle<edm::PCaloHitContainer> HCalContainer;
+
+  // calorimeter geometry, shared by the ECal and HCal stages
+  edm::ESHandle<CaloGeometry> theCaloGeometry;
+
+  // Tracker info
+  // Pixel info
+  edm::InputTag PxlBrlLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlBrlLowSrc_Token_;
+  edm::InputTag PxlBrlHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlBrlHighSrc_Token_;
+  edm::InputTag PxlFwdLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlFwdLowSrc_Token_;
+  edm::InputTag PxlFwdHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> PxlFwdHighSrc_Token_;
+  edm::Handle<edm::PSimHitContainer> PxlBrlLowContainer;
+  edm::Handle<edm::PSimHitContainer> PxlBrlHighContainer;
+  edm::Handle<edm::PSimHitContainer> PxlFwdLowContainer;
+  edm::Handle<edm::PSimHitContainer> PxlFwdHighContainer;
+
+  // Strip info
+  edm::InputTag SiTIBLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIBLowSrc_Token_;
+  edm::InputTag SiTIBHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIBHighSrc_Token_;
+  edm::InputTag SiTOBLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTOBLowSrc_Token_;
+  edm::InputTag SiTOBHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTOBHighSrc_Token_;
+  edm::InputTag SiTIDLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIDLowSrc_Token_;
+  edm::InputTag SiTIDHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTIDHighSrc_Token_;
+  edm::InputTag SiTECLowSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTECLowSrc_Token_;
+  edm::InputTag SiTECHighSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> SiTECHighSrc_Token_;
+  edm::Handle<edm::PSimHitContainer> SiTIBLowContainer;
+  edm::Handle<edm::PSimHitContainer> SiTIBHighContainer;
+  edm::Handle<edm::PSimHitContainer> SiTOBLowContainer;
+  edm::Handle<edm::PSimHitContainer> SiTOBHighContainer;
+  edm::Handle<edm::PSimHitContainer> SiTIDLowContainer;
+  edm::Handle<edm::PSimHitContainer> SiTIDHighContainer;
+  edm::Handle<edm::PSimHitContainer> SiTECLowContainer;
+  edm::Handle<edm::PSimHitContainer> SiTECHighContainer;
+
+  // tracker geometry
+  edm::ESHandle<TrackerGeometry> theTrackerGeometry;
+
+  // Muon info
+  // DT info
+  edm::InputTag MuonDtSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonDtSrc_Token_;
+  edm::Handle<edm::PSimHitContainer> MuonDtContainer;
+  // CSC info
+  edm::InputTag MuonCscSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonCscSrc_Token_;
+  edm::Handle<edm::PSimHitContainer> MuonCSCContainer;
+  // RPC info
+  edm::InputTag MuonRpcSrc_;
+  edm::EDGetTokenT<edm::PSimHitContainer> MuonRpcSrc_Token_;
+  edm::Handle<edm::PSimHitContainer> MuonRPCContainer;
+
+  // muon geometries
+  edm::ESHandle<CSCGeometry> theCSCGeometry;
+  edm::ESHandle<DTGeometry> theDTGeometry;
+  edm::ESHandle<RPCGeometry> theRPCGeometry;
+
+  // per event hit columns of all subsystems
+  GlobalHitsColumns SimHits;
+
+  // DetUnit frames, rebuilt when the geometry records change
+  GlobalHitsGeometryCache theTrkCache;
+  GlobalHitsGeometryCache theCSCCache;
+  GlobalHitsGeometryCache theDTCache;
+  GlobalHitsGeometryCache theRPCCache;
+
+  // calorimeter cells, rebuilt when the CaloGeometryRecord changes
+  GlobalHitsCaloCellCache theCaloCache;
+
+  // fill and store stage times of this stream
+  GlobalHitsStageTimes stageTimes;
+
+}; // end class declaration
+ 
+#endif
+ 
+#ifndef GlobalHitMap
+#define GlobalHitMap
+// geometry mapping
+static const int dTrk             = 1;
+static const int sdPxlBrl         = 1;
+static const int sdPxlFwd         = 2;
+static const int sdSiTIB          = 3;
+static const int sdSiTID          = 4;
+static const int sdSiTOB          = 5;
+static const int sdSiTEC          = 6;
+
+static const int dMuon            = 2;
+static const int sdMuonDT         = 1;
+static const int sdMuonCSC        = 2;
+static const int sdMuonRPC        = 3;
+static const int sdMuonRPCRgnBrl  = 0;
+static const int sdMuonRPCRgnFwdp = 1;
+static const int sdMuonRPCRgnFwdn = -1;
+
+static const int dEcal            = 3;
+static const int sdEcalBrl        = 1;
+static const int sdEcalFwd        = 2;
+static const int sdEcalPS         = 3;
+static const int sdEcalTT         = 4;
+static const int sdEcalLPnD       = 5;
+
+static const int dHcal            = 4;
+static const int sdHcalEmpty      = 0;
+static const int sdHcalBrl        = 1;
+static const int sdHcalEC         = 2;
+static const int sdHcalOut        = 3;
+static const int sdHcalFwd        = 4;
+static const int sdHcalTT         = 5;
+static const int sdHcalCalib      = 6;
+static const int sdHcalCompst     = 7;
+
+#endif
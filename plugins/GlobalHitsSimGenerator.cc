@@ -0,0 +1,508 @@
+/** \file GlobalHitsSimGenerator.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/plugins/GlobalHitsSimGenerator.h"
+
+#include "Geometry/Records/interface/TrackerDigiGeometryRecord.h"
+#include "Geometry/Records/interface/MuonGeometryRecord.h"
+#include "Geometry/Records/interface/CaloGeometryRecord.h"
+#include "Geometry/TrackerGeometryBuilder/interface/TrackerGeometry.h"
+#include "Geometry/CSCGeometry/interface/CSCGeometry.h"
+#include "Geometry/DTGeometry/interface/DTGeometry.h"
+#include "Geometry/DTGeometry/interface/DTLayer.h"
+#include "Geometry/DTGeometry/interface/DTTopology.h"
+#include "Geometry/RPCGeometry/interface/RPCGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
+#include "Geometry/CommonDetUnit/interface/GeomDetUnit.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "DataFormats/HcalDetId/interface/HcalSubdetector.h"
+#include "DataFormats/MuonDetId/interface/DTWireId.h"
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "DataFormats/Math/interface/Vector3D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace {
+
+  // speed of light in cm/ns
+  const double kC = 29.9792458;
+  const double kPionMass = 0.13957;
+
+  struct CollectionSpec {
+    const char* instance;
+    int pool;
+    bool highTof;
+    unsigned int count;      // default objects per event
+  };
+
+  // the g4SimHits collections read by the GlobalHits modules, with
+  // multiplicities of the order of a minimum bias event
+  const CollectionSpec kSimHitSpecs[] = {
+    { "TrackerHitsPixelBarrelLowTof",  0, false, 150 },
+    { "TrackerHitsPixelBarrelHighTof", 0, true,   10 },
+    { "TrackerHitsPixelEndcapLowTof",  1, false,  60 },
+    { "TrackerHitsPixelEndcapHighTof", 1, true,    5 },
+    { "TrackerHitsTIBLowTof",          2, false, 300 },
+    { "TrackerHitsTIBHighTof",         2, true,   20 },
+    { "TrackerHitsTIDLowTof",          3, false,  80 },
+    { "TrackerHitsTIDHighTof",         3, true,    5 },
+    { "TrackerHitsTOBLowTof",          4, false, 300 },
+    { "TrackerHitsTOBHighTof",         4, true,   20 },
+    { "TrackerHitsTECLowTof",          5, false, 300 },
+    { "TrackerHitsTECHighTof",         5, true,   20 },
+    { "MuonDTHits",                    6, false,  40 },
+    { "MuonCSCHits",                   7, false,  30 },
+    { "MuonRPCHits",                   8, false,  10 }
+  };
+
+  const CollectionSpec kCaloHitSpecs[] = {
+    { "EcalHitsEB", 9,  false, 2000 },
+    { "EcalHitsEE", 10, false, 1000 },
+    { "EcalHitsES", 11, false,  200 },
+    { "HcalHits",   12, false, 1000 }
+  };
+
+  // splitmix64 finalizer, to turn the seed and event numbers into
+  // unrelated engine seeds
+  unsigned long long mix(unsigned long long x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  double uniform(std::mt19937_64& engine, double a, double b)
+  {
+    return std::uniform_real_distribution<double>(a, b)(engine);
+  }
+
+  double exponential(std::mt19937_64& engine, double mean)
+  {
+    return std::exponential_distribution<double>(1. / mean)(engine);
+  }
+
+  unsigned int pick(std::mt19937_64& engine, std::size_t n)
+  {
+    return std::uniform_int_distribution<unsigned int>(0, n - 1)(engine);
+  }
+
+  // track like direction and momentum: falling pt spectrum, flat in eta
+  // and phi
+  void direction(std::mt19937_64& engine, double& pt, double& eta,
+		 double& phi)
+  {
+    pt = 0.1 + exponential(engine, 0.6);
+    eta = uniform(engine, -3., 3.);
+    phi = uniform(engine, -M_PI, M_PI);
+  }
+}
+
+GlobalHitsSimGenerator::GlobalHitsSimGenerator(const edm::ParameterSet&
+					       iPSet) :
+  fName(""), verbosity(0), seed(0), scale(1.), nVertices(0), nTracks(0),
+  trackerCacheId(0), muonCacheId(0), caloCacheId(0), count(0)
+{
+  std::string MsgLoggerCat = "GlobalHitsSimGenerator_GlobalHitsSimGenerator";
+
+  // get information from parameter set
+  fName = iPSet.getUntrackedParameter<std::string>("Name");
+  verbosity = iPSet.getUntrackedParameter<int>("Verbosity");
+  seed = iPSet.getParameter<unsigned int>("Seed");
+  scale = iPSet.getParameter<double>("MultiplicityScale");
+  edm::ParameterSet m_Hits =
+    iPSet.getParameter<edm::ParameterSet>("HitsPerEvent");
+  nVertices = m_Hits.getParameter<unsigned int>("SimVertices");
+  nTracks = m_Hits.getParameter<unsigned int>("SimTracks");
+
+  // use value of first digit to determine default output level (inclusive)
+  // 0 is none, 1 is basic, 2 is fill output, 3 is gather output
+  verbosity %= 10;
+
+  // multiplicities of every collection
+  for (unsigned int i = 0;
+       i < sizeof(kSimHitSpecs) / sizeof(kSimHitSpecs[0]); ++i) {
+    Collection c;
+    c.instance = kSimHitSpecs[i].instance;
+    c.pool = Pool(kSimHitSpecs[i].pool);
+    c.highTof = kSimHitSpecs[i].highTof;
+    c.count = m_Hits.getUntrackedParameter<unsigned int>
+      (c.instance, kSimHitSpecs[i].count);
+    simHitCollections.push_back(c);
+  }
+  for (unsigned int i = 0;
+       i < sizeof(kCaloHitSpecs) / sizeof(kCaloHitSpecs[0]); ++i) {
+    Collection c;
+    c.instance = kCaloHitSpecs[i].instance;
+    c.pool = Pool(kCaloHitSpecs[i].pool);
+    c.highTof = kCaloHitSpecs[i].highTof;
+    c.count = m_Hits.getUntrackedParameter<unsigned int>
+      (c.instance, kCaloHitSpecs[i].count);
+    caloHitCollections.push_back(c);
+  }
+
+  // print out Parameter Set information being used
+  if (verbosity >= 0) {
+    edm::LogInfo(MsgLoggerCat)
+      << "\n===============================\n"
+      << "Initialized as stream EDProducer with parameter values:\n"
+      << "    Name          = " << fName << "\n"
+      << "    Verbosity     = " << verbosity << "\n"
+      << "    Seed          = " << seed << "\n"
+      << "    MultiplicityScale = " << scale << "\n"
+      << "    SimVertices   = " << nVertices << "\n"
+      << "    SimTracks     = " << nTracks << "\n"
+      << "===============================\n";
+  }
+
+  // create persistent objects
+  produces<edm::HepMCProduct>();
+  produces<edm::SimVertexContainer>();
+  produces<edm::SimTrackContainer>();
+  for (unsigned int i = 0; i < simHitCollections.size(); ++i)
+    produces<edm::PSimHitContainer>(simHitCollections[i].instance);
+  for (unsigned int i = 0; i < caloHitCollections.size(); ++i)
+    produces<edm::PCaloHitContainer>(caloHitCollections[i].instance);
+}
+
+GlobalHitsSimGenerator::~GlobalHitsSimGenerator()
+{
+}
+
+void GlobalHitsSimGenerator::produce(edm::Event& iEvent,
+				     const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsSimGenerator_produce";
+
+  ++count;
+
+  updatePools(iSetup);
+
+  // one engine per event, seeded from the event numbers only
+  const edm::EventID& id = iEvent.id();
+  Engine engine(mix(mix(mix(mix(seed) ^ id.run()) ^
+			id.luminosityBlock()) ^ id.event()));
+
+  std::auto_ptr<edm::SimVertexContainer>
+    vertices(new edm::SimVertexContainer);
+  makeVertices(engine, *vertices);
+
+  std::auto_ptr<edm::SimTrackContainer> tracks(new edm::SimTrackContainer);
+  makeTracks(engine, vertices->size(), *tracks);
+
+  // generator event: the primary vertex (in mm) and its tracks
+  HepMC::GenEvent* evt = new HepMC::GenEvent();
+  evt->set_event_number(id.event());
+  const math::XYZVectorD& pv = (*vertices)[0].position().Vect();
+  HepMC::GenVertex* vtx =
+    new HepMC::GenVertex(HepMC::FourVector(10. * pv.x(), 10. * pv.y(),
+					   10. * pv.z(), 0.));
+  for (unsigned int i = 0; i < tracks->size(); ++i) {
+    const SimTrack& trk = (*tracks)[i];
+    if (trk.vertIndex() != 0) continue;
+    const math::XYZTLorentzVectorD& p = trk.momentum();
+    vtx->add_particle_out
+      (new HepMC::GenParticle(HepMC::FourVector(p.px(), p.py(), p.pz(),
+						p.e()), trk.type(), 1));
+  }
+  evt->add_vertex(vtx);
+  std::auto_ptr<edm::HepMCProduct> hepmc(new edm::HepMCProduct(evt));
+
+  const unsigned int nTrk = tracks->size();
+  const unsigned int nVtx = vertices->size();
+
+  // store information in event
+  iEvent.put(hepmc);
+  iEvent.put(vertices);
+  iEvent.put(tracks);
+
+  unsigned int nHits = 0;
+  for (unsigned int i = 0; i < simHitCollections.size(); ++i) {
+    std::auto_ptr<edm::PSimHitContainer> hits(new edm::PSimHitContainer);
+    makeSimHits(engine, simHitCollections[i], nTrk, *hits);
+    nHits += hits->size();
+    iEvent.put(hits, simHitCollections[i].instance);
+  }
+  for (unsigned int i = 0; i < caloHitCollections.size(); ++i) {
+    std::auto_ptr<edm::PCaloHitContainer> hits(new edm::PCaloHitContainer);
+    makeCaloHits(engine, caloHitCollections[i], nTrk, *hits);
+    nHits += hits->size();
+    iEvent.put(hits, caloHitCollections[i].instance);
+  }
+
+  if (verbosity > 1)
+    edm::LogInfo(MsgLoggerCat)
+      << "Event " << id.event() << ": " << nVtx << " SimVertices, "
+      << nTrk << " SimTracks, " << nHits << " hits";
+
+  return;
+}
+
+//==================pools of DetUnits and cells=============================
+void GlobalHitsSimGenerator::updatePools(const edm::EventSetup& iSetup)
+{
+  std::string MsgLoggerCat = "GlobalHitsSimGenerator_updatePools";
+
+  bool rebuilt = false;
+
+  unsigned long long cacheId =
+    iSetup.get<TrackerDigiGeometryRecord>().cacheIdentifier();
+  if (cacheId != trackerCacheId) {
+    edm::ESHandle<TrackerGeometry> theTrackerGeometry;
+    iSetup.get<TrackerDigiGeometryRecord>().get(theTrackerGeometry);
+    for (int p = PxlBrl; p <= SiTEC; ++p) pools[p].clear();
+    fillTrackingPool(*theTrackerGeometry, PxlBrl);
+    trackerCacheId = cacheId;
+    rebuilt = true;
+  }
+
+  cacheId = iSetup.get<MuonGeometryRecord>().cacheIdentifier();
+  if (cacheId != muonCacheId) {
+    edm::ESHandle<DTGeometry> theDTGeometry;
+    edm::ESHandle<CSCGeometry> theCSCGeometry;
+    edm::ESHandle<RPCGeometry> theRPCGeometry;
+    iSetup.get<MuonGeometryRecord>().get(theDTGeometry);
+    iSetup.get<MuonGeometryRecord>().get(theCSCGeometry);
+    iSetup.get<MuonGeometryRecord>().get(theRPCGeometry);
+    pools[MuonDt].clear();
+    pools[MuonCsc].clear();
+    pools[MuonRpc].clear();
+    fillTrackingPool(*theDTGeometry, MuonDt);
+    fillTrackingPool(*theCSCGeometry, MuonCsc);
+    fillTrackingPool(*theRPCGeometry, MuonRpc);
+    muonCacheId = cacheId;
+    rebuilt = true;
+  }
+
+  cacheId = iSetup.get<CaloGeometryRecord>().cacheIdentifier();
+  if (cacheId != caloCacheId) {
+    edm::ESHandle<CaloGeometry> theCaloGeometry;
+    iSetup.get<CaloGeometryRecord>().get(theCaloGeometry);
+    for (int p = EcalEB; p <= Hcal; ++p) pools[p].clear();
+    fillCaloPool(*theCaloGeometry, DetId::Ecal, EcalBarrel, EcalEB);
+    fillCaloPool(*theCaloGeometry, DetId::Ecal, EcalEndcap, EcalEE);
+    fillCaloPool(*theCaloGeometry, DetId::Ecal, EcalPreshower, EcalES);
+    fillCaloPool(*theCaloGeometry, DetId::Hcal, HcalBarrel, Hcal);
+    fillCaloPool(*theCaloGeometry, DetId::Hcal, HcalEndcap, Hcal);
+    fillCaloPool(*theCaloGeometry, DetId::Hcal, HcalOuter, Hcal);
+    fillCaloPool(*theCaloGeometry, DetId::Hcal, HcalForward, Hcal);
+    caloCacheId = cacheId;
+    rebuilt = true;
+  }
+
+  if (verbosity > 0 && rebuilt) {
+    TString eventout("\nDetUnits and cells available per collection:");
+    for (unsigned int i = 0; i < simHitCollections.size(); ++i) {
+      eventout += "\n    ";
+      eventout += simHitCollections[i].instance;
+      eventout += " = ";
+      eventout += pools[simHitCollections[i].pool].size();
+    }
+    for (unsigned int i = 0; i < caloHitCollections.size(); ++i) {
+      eventout += "\n    ";
+      eventout += caloHitCollections[i].instance;
+      eventout += " = ";
+      eventout += pools[caloHitCollections[i].pool].size();
+    }
+    edm::LogInfo(MsgLoggerCat) << eventout << "\n";
+  }
+
+  return;
+}
+
+void GlobalHitsSimGenerator::fillTrackingPool(const TrackingGeometry& geom,
+					      Pool pool)
+{
+  const TrackingGeometry::DetUnitContainer& dets = geom.detUnits();
+  TrackingGeometry::DetUnitContainer::const_iterator itDet;
+  for (itDet = dets.begin(); itDet != dets.end(); ++itDet) {
+
+    const DetId id = (*itDet)->geographicalId();
+
+    // tracker DetUnits go to the pool of their subdetector
+    Pool p = pool;
+    if (pool == PxlBrl) {
+      if (id.subdetId() < 1 || id.subdetId() > 6) continue;
+      p = Pool(PxlBrl + id.subdetId() - 1);
+    }
+
+    const BoundPlane& surface = (*itDet)->surface();
+    Cell c;
+    c.id = id.rawId();
+    c.halfWidth = 0.5 * surface.bounds().width();
+    c.halfLength = 0.5 * surface.bounds().length();
+    c.halfThickness = 0.5 * surface.bounds().thickness();
+    c.tof = surface.position().mag() / kC;
+    c.firstWire = c.wires = 0;
+
+    // DT hits are on a wire of the layer
+    if (p == MuonDt) {
+      const DTLayer* layer = dynamic_cast<const DTLayer*>(*itDet);
+      if (!layer) continue;
+      c.firstWire = layer->specificTopology().firstChannel();
+      c.wires = layer->specificTopology().channels();
+      if (c.wires == 0) continue;
+    }
+
+    pools[p].push_back(c);
+  }
+
+  return;
+}
+
+void GlobalHitsSimGenerator::fillCaloPool(const CaloGeometry& geom,
+					  DetId::Detector det, int subdet,
+					  Pool pool)
+{
+  const std::vector<DetId>& ids = geom.getValidDetIds(det, subdet);
+  for (unsigned int i = 0; i < ids.size(); ++i) {
+    const CaloCellGeometry* cell = geom.getGeometry(ids[i]);
+    if (!cell) continue;
+    Cell c;
+    c.id = ids[i].rawId();
+    c.halfWidth = c.halfLength = c.halfThickness = 0.;
+    c.tof = cell->getPosition().mag() / kC;
+    c.firstWire = c.wires = 0;
+    pools[pool].push_back(c);
+  }
+
+  return;
+}
+
+//==================event content===========================================
+void GlobalHitsSimGenerator::makeVertices(Engine& engine,
+					  edm::SimVertexContainer&
+					  vertices) const
+{
+  const unsigned int n = std::max(1u, (unsigned int)(scale * nVertices));
+  vertices.reserve(n);
+
+  // primary vertex in the luminous region, in cm
+  std::normal_distribution<double> transverse(0., 0.0015);
+  std::normal_distribution<double> longitudinal(0., 5.3);
+  const math::XYZVectorD pv(transverse(engine), transverse(engine),
+			    longitudinal(engine));
+  vertices.push_back(SimVertex(pv, 0., -1));
+
+  // secondary vertices inside the tracker volume, from earlier tracks
+  const unsigned int nTrk = (unsigned int)(scale * nTracks);
+  for (unsigned int i = 1; i < n; ++i) {
+    const double r = exponential(engine, 20.);
+    const double phi = uniform(engine, -M_PI, M_PI);
+    const math::XYZVectorD v(pv.x() + r * std::cos(phi),
+			     pv.y() + r * std::sin(phi),
+			     pv.z() + uniform(engine, -50., 50.));
+    vertices.push_back(SimVertex(v, v.R() / kC * 1.e-9,
+				 nTrk ? int(pick(engine, nTrk)) + 1 : -1));
+  }
+
+  return;
+}
+
+void GlobalHitsSimGenerator::makeTracks(Engine& engine,
+					unsigned int nVtx,
+					edm::SimTrackContainer& tracks) const
+{
+  const unsigned int n = (unsigned int)(scale * nTracks);
+  tracks.reserve(n);
+
+  for (unsigned int i = 0; i < n; ++i) {
+    double pt, eta, phi;
+    direction(engine, pt, eta, phi);
+    const double px = pt * std::cos(phi);
+    const double py = pt * std::sin(phi);
+    const double pz = pt * std::sinh(eta);
+    const double e = std::sqrt(px * px + py * py + pz * pz +
+			       kPionMass * kPionMass);
+    const int type = pick(engine, 2) ? 211 : -211;
+
+    // most tracks come from the primary vertex
+    const int vertex =
+      (nVtx > 1 && pick(engine, 4) == 0) ?
+      pick(engine, nVtx - 1) + 1 : 0;
+    tracks.push_back(SimTrack(type, math::XYZTLorentzVectorD(px, py, pz, e),
+			      vertex, vertex == 0 ? int(i) + 1 : -1));
+  }
+
+  return;
+}
+
+void GlobalHitsSimGenerator::makeSimHits(Engine& engine,
+					 const Collection& c,
+					 unsigned int nTrk,
+					 edm::PSimHitContainer& hits) const
+{
+  const std::vector<Cell>& pool = pools[c.pool];
+  if (pool.empty()) return;
+
+  const unsigned int n = (unsigned int)(scale * c.count);
+  hits.reserve(n);
+
+  const bool muon = c.pool >= MuonDt && c.pool <= MuonRpc;
+  for (unsigned int i = 0; i < n; ++i) {
+    const Cell& cell = pool[pick(engine, pool.size())];
+
+    // crossing of the DetUnit from one face to the other
+    const Local3DPoint entry(uniform(engine, -cell.halfWidth, cell.halfWidth),
+			     uniform(engine, -cell.halfLength,
+				     cell.halfLength),
+			     -cell.halfThickness);
+    const Local3DPoint exit(entry.x() + uniform(engine, -0.01, 0.01),
+			    entry.y() + uniform(engine, -0.01, 0.01),
+			    cell.halfThickness);
+
+    double pt, eta, phi;
+    direction(engine, pt, eta, phi);
+    const float pabs = pt * std::cosh(eta);
+    const float theta = 2. * std::atan(std::exp(-eta));
+
+    // loopers and late particles fill the high tof collections
+    const float tof = cell.tof +
+      (c.highTof ? exponential(engine, 50.) :
+       std::fabs(std::normal_distribution<double>(0., 0.5)(engine)));
+    const float eloss = (muon ? 1.e-6 : 8.e-5) *
+      (1. + exponential(engine, 0.5));
+    const int type = muon ? (pick(engine, 2) ? 13 : -13) :
+      (pick(engine, 2) ? 211 : -211);
+    const unsigned int track = nTrk ? pick(engine, nTrk) + 1 : 0;
+
+    unsigned int detId = cell.id;
+    if (c.pool == MuonDt)
+      detId = DTWireId(DTLayerId(cell.id),
+		       cell.firstWire + pick(engine, cell.wires)).rawId();
+
+    hits.push_back(PSimHit(entry, exit, pabs, tof, eloss, type, detId,
+			   track, theta, phi));
+  }
+
+  return;
+}
+
+void GlobalHitsSimGenerator::makeCaloHits(Engine& engine,
+					  const Collection& c,
+					  unsigned int nTrk,
+					  edm::PCaloHitContainer& hits) const
+{
+  const std::vector<Cell>& pool = pools[c.pool];
+  if (pool.empty()) return;
+
+  const unsigned int n = (unsigned int)(scale * c.count);
+  hits.reserve(n);
+
+  // mean deposit per hit, in GeV
+  const double mean = c.pool == EcalES ? 1.e-4 :
+    (c.pool == Hcal ? 0.05 : 0.1);
+  for (unsigned int i = 0; i < n; ++i) {
+    const Cell& cell = pool[pick(engine, pool.size())];
+    const float e = exponential(engine, mean);
+    const float t = cell.tof + exponential(engine, 2.);
+    const int track = nTrk ? pick(engine, nTrk) + 1 : 0;
+    hits.push_back(PCaloHit(cell.id, e, t, track));
+  }
+
+  return;
+}
@@ -0,0 +1,128 @@
+#ifndef GlobalHitsSimGenerator_h
+#define GlobalHitsSimGenerator_h
+
+/** \class GlobalHitsSimGenerator
+ *
+ *  Class to put synthetic simulation output into the event, so that the
+ *  GlobalHits modules can be exercised and timed without running the
+ *  generator and OscarProducer chain
+ *
+ *  Every event gets an edm::HepMCProduct with one vertex, SimVertex and
+ *  SimTrack containers, the PSimHitContainers of the tracker and muon
+ *  systems and the PCaloHitContainers of ECAL, preshower and HCAL, with
+ *  the product instance names of g4SimHits. The number of objects of
+ *  every collection is set per instance name in the HitsPerEvent PSet and
+ *  scaled by MultiplicityScale, e.g. to reach pileup like hit counts.
+ *
+ *  Hits are put on DetUnits (with DT wires) and calorimeter cells that
+ *  exist in the geometry of the EventSetup, at random local positions
+ *  within the DetUnit bounds and with a time of flight from the distance
+ *  to the origin, so they pass the same lookups as real hits. Energies and
+ *  momenta follow simple falling spectra; the content is meant to load the
+ *  validation code, not to be physics.
+ *
+ *  The random numbers of an event come from a generator seeded with Seed
+ *  and the run, luminosity block and event numbers, so the output does
+ *  not depend on the stream or thread that produces the event. The
+ *  tracker, muon and calorimeter geometries must be in the EventSetup.
+ */
+
+// framework & common header files
+#include "FWCore/Framework/interface/stream/EDProducer.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DataFormats/DetId/interface/DetId.h"
+
+// geometry
+#include "Geometry/CommonDetUnit/interface/TrackingGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloGeometry.h"
+
+// data in edm::event
+#include "SimDataFormats/GeneratorProducts/interface/HepMCProduct.h"
+#include "SimDataFormats/Vertex/interface/SimVertexContainer.h"
+#include "SimDataFormats/Track/interface/SimTrackContainer.h"
+#include "SimDataFormats/TrackingHit/interface/PSimHitContainer.h"
+#include "SimDataFormats/CaloHit/interface/PCaloHitContainer.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TString.h"
+
+class GlobalHitsSimGenerator : public edm::stream::EDProducer<>
+{
+
+ public:
+
+  explicit GlobalHitsSimGenerator(const edm::ParameterSet&);
+  virtual ~GlobalHitsSimGenerator();
+  virtual void produce(edm::Event&, const edm::EventSetup&) override;
+
+ private:
+
+  typedef std::mt19937_64 Engine;
+
+  // the DetUnits or cells a collection puts its hits on
+  enum Pool { PxlBrl, PxlFwd, SiTIB, SiTID, SiTOB, SiTEC, MuonDt, MuonCsc,
+	      MuonRpc, EcalEB, EcalEE, EcalES, Hcal, nPools };
+
+  struct Cell {
+    unsigned int id;
+    float halfWidth;         // local x, y and z half sizes of a DetUnit
+    float halfLength;
+    float halfThickness;
+    float tof;               // distance to the origin over c, in ns
+    unsigned short firstWire;
+    unsigned short wires;    // only for DT layers
+  };
+
+  struct Collection {
+    std::string instance;
+    Pool pool;
+    bool highTof;
+    unsigned int count;
+  };
+
+  // rebuild the pools whose geometry record changed
+  void updatePools(const edm::EventSetup&);
+  void fillTrackingPool(const TrackingGeometry&, Pool);
+  void fillCaloPool(const CaloGeometry&, DetId::Detector, int subdet,
+		    Pool pool);
+
+  void makeVertices(Engine&, edm::SimVertexContainer&) const;
+  void makeTracks(Engine&, unsigned int nVtx,
+		  edm::SimTrackContainer&) const;
+  void makeSimHits(Engine&, const Collection&, unsigned int nTrk,
+		   edm::PSimHitContainer&) const;
+  void makeCaloHits(Engine&, const Collection&, unsigned int nTrk,
+		    edm::PCaloHitContainer&) const;
+
+  //  parameter information
+  std::string fName;
+  int verbosity;
+  unsigned int seed;
+  double scale;
+  unsigned int nVertices;
+  unsigned int nTracks;
+
+  std::vector<Collection> simHitCollections;
+  std::vector<Collection> caloHitCollections;
+
+  // pools and the cacheIdentifiers of the records they were built from
+  std::vector<Cell> pools[nPools];
+  unsigned long long trackerCacheId;
+  unsigned long long muonCacheId;
+  unsigned long long caloCacheId;
+
+  // private statistics information
+  unsigned int count;
+
+}; // end class declaration
+
+#endif
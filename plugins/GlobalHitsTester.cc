@@ -1,4 +1,4 @@
-#include "Validation/GlobalHits/interface/GlobalHitsTester.h"
+#include "Validation/GlobalHits/plugins/GlobalHitsTester.h"
 #include "DQMServices/Core/interface/DQMStore.h"
 
 GlobalHitsTester::GlobalHitsTester(const edm::ParameterSet& iPSet) :
@@ -35,6 +35,9 @@ GlobalHitsTester::GlobalHitsTester(const edm::ParameterSet& iPSet) :
       << "===============================\n";
   }
  
+  // the DQMStore is not thread safe
+  usesResource("DQMStore");
+
   dbe = 0;
   dbe = edm::Service<DQMStore>().operator->();
   
@@ -90,8 +93,6 @@ GlobalHitsTester::GlobalHitsTester(const edm::ParameterSet& iPSet) :
 
 GlobalHitsTester::~GlobalHitsTester() 
 {
-  if (doOutput)
-    if (outputfile.size() != 0 && dbe) dbe->save(outputfile);
 }
 
 void GlobalHitsTester::beginJob( void )
@@ -120,6 +121,9 @@ void GlobalHitsTester::endRun(const edm::Run& iRun,
   meTestInt->Fill(100);
   meTestFloat->Fill(3.141592);
 
+  // rewritten at every run, so the file holds the last one
+  if (doOutput && outputfile.size() != 0 && dbe) dbe->save(outputfile);
+
   return;
 }
 
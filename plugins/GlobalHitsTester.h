@@ -11,7 +11,7 @@
  */
 
 // framework & common header files
-#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -75,18 +75,20 @@
 
 #include "TString.h"
 
-class GlobalHitsTester : public edm::EDAnalyzer
+class GlobalHitsTester : 
+  public edm::one::EDAnalyzer<edm::one::WatchRuns,
+			       edm::one::SharedResources>
 {
   
  public:
 
   explicit GlobalHitsTester(const edm::ParameterSet&);
   virtual ~GlobalHitsTester();
-  virtual void beginJob( void );
-  virtual void endJob();  
-  virtual void analyze(const edm::Event&, const edm::EventSetup&);
-  virtual void beginRun(const edm::Run&, const edm::EventSetup&);
-  virtual void endRun(const edm::Run&, const edm::EventSetup&);
+  virtual void beginJob( void ) override;
+  virtual void endJob() override;
+  virtual void analyze(const edm::Event&, const edm::EventSetup&) override;
+  virtual void beginRun(const edm::Run&, const edm::EventSetup&) override;
+  virtual void endRun(const edm::Run&, const edm::EventSetup&) override;
 
   
 private:
@@ -0,0 +1,26 @@
+#include "FWCore/PluginManager/interface/ModuleDef.h"
+
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+
+
+#include <Validation/GlobalHits/plugins/GlobalHitsProducer.h>
+DEFINE_FWK_MODULE(GlobalHitsProducer);
+
+#include <Validation/GlobalHits/plugins/GlobalHitsAnalyzer.h>
+DEFINE_FWK_MODULE(GlobalHitsAnalyzer);
+
+#include <Validation/GlobalHits/plugins/GlobalHitsHistogrammer.h>
+DEFINE_FWK_MODULE(GlobalHitsHistogrammer);
+
+#include <Validation/GlobalHits/plugins/GlobalHitsProdHist.h>
+DEFINE_FWK_MODULE(GlobalHitsProdHist);
+
+#include <Validation/GlobalHits/plugins/GlobalHitsProdHistStripper.h>
+DEFINE_FWK_MODULE(GlobalHitsProdHistStripper);
+
+#include <Validation/GlobalHits/plugins/GlobalHitsTester.h>
+DEFINE_FWK_MODULE(GlobalHitsTester);
+
+#include <Validation/GlobalHits/plugins/GlobalHitsSimGenerator.h>
+DEFINE_FWK_MODULE(GlobalHitsSimGenerator);
@@ -1,6 +1,8 @@
 import FWCore.ParameterSet.Config as cms
 
 globalhitsanalyze = cms.EDAnalyzer("GlobalHitsAnalyzer",
+    # generator event read for the primary vertex
+    HepMCSrc = cms.InputTag("VtxSmeared"),
     G4VtxSrc = cms.InputTag("g4SimHits"),
     G4TrkSrc = cms.InputTag("g4SimHits"),
     MuonRpcSrc = cms.InputTag("g4SimHits","MuonRPCHits"),
@@ -37,6 +39,27 @@ globalhitsanalyze = cms.EDAnalyzer("GlobalHitsAnalyzer",
     # 3 provides output of the store step + 2
     Frequency = cms.untracked.int32(50),
     ECalEBSrc = cms.InputTag("g4SimHits","EcalHitsEB"),
+    # subsystems to look at, any of G4MC, Tracker, Muon, ECal (with the
+    # preshower) and HCal; the others are neither read nor booked
+    Subsystems = cms.untracked.vstring('G4MC', 'Tracker', 'Muon', 'ECal',
+                                       'HCal'),
+    # keep a seeded random subset of the hits of every input collection
+    # of a subsystem: <System>Fraction of them, and at most
+    # <System>Reservoir (0 for no limit) per collection, RPC barrel and
+    # forward sharing one; the kept hits are weighted to the full number
+    Sampling = cms.untracked.PSet(
+        Seed = cms.untracked.uint32(12345),
+        TrackerFraction = cms.untracked.double(1.0),
+        TrackerReservoir = cms.untracked.uint32(0),
+        MuonFraction = cms.untracked.double(1.0),
+        MuonReservoir = cms.untracked.uint32(0),
+        ECalFraction = cms.untracked.double(1.0),
+        ECalReservoir = cms.untracked.uint32(0),
+        HCalFraction = cms.untracked.double(1.0),
+        HCalReservoir = cms.untracked.uint32(0)
+    ),
+    # time every fill stage, booked in GlobalHitsV/Timing
+    Timing = cms.untracked.bool(False),
 
     validHepMCevt = cms.untracked.bool(True),
     validG4VtxContainer = cms.untracked.bool(True),
@@ -1,6 +1,8 @@
 import FWCore.ParameterSet.Config as cms
 
 globalhits = cms.EDProducer("GlobalHitsProducer",
+    # generator event read for the primary vertex
+    HepMCSrc = cms.InputTag("VtxSmeared"),
     G4VtxSrc = cms.InputTag("g4SimHits"),
     G4TrkSrc = cms.InputTag("g4SimHits"),
     MuonRpcSrc = cms.InputTag("g4SimHits","MuonRPCHits"),
@@ -37,6 +39,34 @@ globalhits = cms.EDProducer("GlobalHitsProducer",
     Frequency = cms.untracked.int32(50),
     # as of 110p2, needs to be 1. Anything ealier should be 0.
     VtxUnit = cms.untracked.int32(1),
+    # run the five fill stages of an event as parallel tasks
+    ConcurrentFill = cms.untracked.bool(False),
+    # put a GlobalHitsCompactHits with 16 bit fixed point hits instead
+    # of the PGlobalSimHit; globalhithistogram reads either
+    CompactOutput = cms.untracked.bool(False),
+    # subsystems to look at, any of G4MC, Tracker, Muon, ECal (with the
+    # preshower) and HCal; the others are neither read nor booked
+    Subsystems = cms.untracked.vstring('G4MC', 'Tracker', 'Muon', 'ECal',
+                                       'HCal'),
+    # keep a seeded random subset of the hits of every input collection
+    # of a subsystem: <System>Fraction of them, and at most
+    # <System>Reservoir (0 for no limit) per collection, RPC barrel and
+    # forward sharing one; the kept hits are weighted to the full number
+    Sampling = cms.untracked.PSet(
+        Seed = cms.untracked.uint32(12345),
+        TrackerFraction = cms.untracked.double(1.0),
+        TrackerReservoir = cms.untracked.uint32(0),
+        MuonFraction = cms.untracked.double(1.0),
+        MuonReservoir = cms.untracked.uint32(0),
+        ECalFraction = cms.untracked.double(1.0),
+        ECalReservoir = cms.untracked.uint32(0),
+        HCalFraction = cms.untracked.double(1.0),
+        HCalReservoir = cms.untracked.uint32(0)
+    ),
+    # time every fill and store stage, summarized as hits/s at endJob
+    Timing = cms.untracked.bool(False),
+    # if not empty, also write the stage times to this JSON file
+    TimingJSON = cms.untracked.string(''),
     ECalEBSrc = cms.InputTag("g4SimHits","EcalHitsEB")
 )
 
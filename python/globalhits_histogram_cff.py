@@ -8,4 +8,10 @@ import FWCore.ParameterSet.Config as cms
 from Validation.GlobalHits.globalhits_histogram_cfi import *
 DQMStore = cms.Service("DQMStore")
 
+# the merged monitor elements are written by the DQM file saver, which
+# has to be put on an EndPath of the process
+from DQMServices.Components.DQMFileSaver_cfi import *
+dqmSaver.convention = 'RelVal'
+dqmSaver.workflow = '/GlobalValidation/Hits/Histogrammer'
+
 
@@ -1,6 +1,8 @@
 import FWCore.ParameterSet.Config as cms
 
 globalhitsprodhist = cms.EDProducer("GlobalHitsProdHist",
+    # generator event read for the primary vertex
+    HepMCSrc = cms.InputTag("VtxSmeared"),
     G4VtxSrc = cms.InputTag("g4SimHits"),
     G4TrkSrc = cms.InputTag("g4SimHits"),
     MuonRpcSrc = cms.InputTag("g4SimHits","MuonRPCHits"),
@@ -35,6 +37,16 @@ globalhitsprodhist = cms.EDProducer("GlobalHitsProdHist",
     # 2 provides output of the fill step + 1
     # 3 provides output of the store step + 2
     Frequency = cms.untracked.int32(50),
+    # also store the histograms of every luminosity block
+    LumiProducts = cms.untracked.bool(False),
+    # subsystems to look at, any of G4MC, Tracker, Muon, ECal (with the
+    # preshower) and HCal; the others are neither read nor booked
+    Subsystems = cms.untracked.vstring('G4MC', 'Tracker', 'Muon', 'ECal',
+                                       'HCal'),
+    # time every fill stage, summarized as hits/s at endJob
+    Timing = cms.untracked.bool(False),
+    # if not empty, also write the stage times to this JSON file
+    TimingJSON = cms.untracked.string(''),
     ECalEBSrc = cms.InputTag("g4SimHits","EcalHitsEB")
 )
 
@@ -12,6 +12,10 @@ globalhitprodhiststrip = cms.EDAnalyzer("GlobalHitsProdHistStripper",
     VtxUnit = cms.untracked.int32(1),
     Frequency = cms.untracked.int32(1),
     DoOutput = cms.bool(False),
+    # label of the GlobalHitsProdHist module whose run products are read
+    ProdHistLabel = cms.untracked.string('globalhitsprodhist'),
+    # sum the histograms of all runs instead of keeping the last one
+    AccumulateRuns = cms.untracked.bool(False),
     # 1 assumes cm in SimVertex
     ProvenanceLookup = cms.PSet(
         PrintProvenanceInfo = cms.untracked.bool(False),
@@ -0,0 +1,40 @@
+import FWCore.ParameterSet.Config as cms
+
+# synthetic HepMCProduct, SimVertex, SimTrack, PSimHit and PCaloHit
+# collections with the instance names of g4SimHits; to run the GlobalHits
+# modules on them use the label g4SimHits and point HepMCSrc at it
+globalhitssimgen = cms.EDProducer("GlobalHitsSimGenerator",
+    Name = cms.untracked.string('GlobalHitsSimGenerator'),
+    Verbosity = cms.untracked.int32(0), ## 0 provides no output
+
+    # 1 provides basic output
+    # 2 provides output of the event content + 1
+    # the random numbers of an event depend on the seed and event id only
+    Seed = cms.uint32(12345),
+    # multiplies every multiplicity below, e.g. for pileup like hit counts
+    MultiplicityScale = cms.double(1.0),
+    # objects per event; hit collections not listed keep their defaults
+    HitsPerEvent = cms.PSet(
+        SimVertices = cms.uint32(10),
+        SimTracks = cms.uint32(200),
+        TrackerHitsPixelBarrelLowTof = cms.untracked.uint32(150),
+        TrackerHitsPixelBarrelHighTof = cms.untracked.uint32(10),
+        TrackerHitsPixelEndcapLowTof = cms.untracked.uint32(60),
+        TrackerHitsPixelEndcapHighTof = cms.untracked.uint32(5),
+        TrackerHitsTIBLowTof = cms.untracked.uint32(300),
+        TrackerHitsTIBHighTof = cms.untracked.uint32(20),
+        TrackerHitsTIDLowTof = cms.untracked.uint32(80),
+        TrackerHitsTIDHighTof = cms.untracked.uint32(5),
+        TrackerHitsTOBLowTof = cms.untracked.uint32(300),
+        TrackerHitsTOBHighTof = cms.untracked.uint32(20),
+        TrackerHitsTECLowTof = cms.untracked.uint32(300),
+        TrackerHitsTECHighTof = cms.untracked.uint32(20),
+        MuonDTHits = cms.untracked.uint32(40),
+        MuonCSCHits = cms.untracked.uint32(30),
+        MuonRPCHits = cms.untracked.uint32(10),
+        EcalHitsEB = cms.untracked.uint32(2000),
+        EcalHitsEE = cms.untracked.uint32(1000),
+        EcalHitsES = cms.untracked.uint32(200),
+        HcalHits = cms.untracked.uint32(1000)
+    )
+)
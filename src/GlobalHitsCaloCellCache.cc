@@ -0,0 +1,161 @@
+/** \file GlobalHitsCaloCellCache.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsCaloCellCache.h"
+#include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/ESDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+#include "DataFormats/HcalDetId/interface/HcalSubdetector.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+  struct ById {
+    bool operator()(const std::pair<unsigned int,
+		    GlobalHitsCaloCellCache::Cell>& a,
+		    const std::pair<unsigned int,
+		    GlobalHitsCaloCellCache::Cell>& b) const
+    { return a.first < b.first; }
+  };
+
+  // dense index of an ECAL DetId within its subdetector
+  int ecalHashedIndex(const DetId& id)
+  {
+    switch (id.subdetId()) {
+    case EcalBarrel:    return EBDetId(id).hashedIndex();
+    case EcalEndcap:    return EEDetId(id).hashedIndex();
+    case EcalPreshower: return ESDetId(id).hashedIndex();
+    default:            return -1;
+    }
+  }
+
+  // cache the position of a cell together with its eta and phi
+  bool makeCell(const CaloGeometry& geom, const DetId& id,
+		GlobalHitsCaloCellCache::Cell& c)
+  {
+    const CaloSubdetectorGeometry* subGeom =
+      geom.getSubdetectorGeometry(id);
+    if (!subGeom) return false;
+    const CaloCellGeometry* theDet = subGeom->getGeometry(id);
+    if (!theDet) return false;
+
+    const GlobalPoint& globalposition = theDet->getPosition();
+    c.pos[0] = globalposition.x();
+    c.pos[1] = globalposition.y();
+    c.pos[2] = globalposition.z();
+    c.eta = globalposition.eta();
+    c.phi = globalposition.phi();
+    c.valid = true;
+
+    return true;
+  }
+}
+
+GlobalHitsCaloCellCache::GlobalHitsCaloCellCache() : cacheId_(0), nCells_(0)
+{
+}
+
+void GlobalHitsCaloCellCache::clear()
+{
+  cacheId_ = 0;
+  nCells_ = 0;
+  eb_.clear();
+  ee_.clear();
+  es_.clear();
+  hcalIds_.clear();
+  hcal_.clear();
+}
+
+void GlobalHitsCaloCellCache::fillDense(const CaloGeometry& geom, int subdet,
+					std::vector<Cell>& table,
+					unsigned int tableSize)
+{
+  Cell empty;
+  empty.pos[0] = empty.pos[1] = empty.pos[2] = 0.;
+  empty.eta = empty.phi = 0.;
+  empty.valid = false;
+  table.assign(tableSize, empty);
+
+  const std::vector<DetId>& ids = geom.getValidDetIds(DetId::Ecal, subdet);
+  for (unsigned int i = 0; i < ids.size(); ++i) {
+    const int idx = ecalHashedIndex(ids[i]);
+    if (idx < 0 || idx >= int(tableSize)) continue;
+    if (makeCell(geom, ids[i], table[idx])) ++nCells_;
+  }
+
+  return;
+}
+
+bool GlobalHitsCaloCellCache::update(unsigned long long cacheId,
+				     const CaloGeometry& geom)
+{
+  if (cacheId == cacheId_ && nCells_ > 0) return false;
+
+  nCells_ = 0;
+
+  // ECAL: dense tables by hashed index
+  fillDense(geom, EcalBarrel, eb_, EBDetId::kSizeForDenseIndexing);
+  fillDense(geom, EcalEndcap, ee_, EEDetId::kSizeForDenseIndexing);
+  fillDense(geom, EcalPreshower, es_, ESDetId::kSizeForDenseIndexing);
+
+  // HCAL: sorted by raw DetId
+  std::vector<std::pair<unsigned int, Cell> > table;
+  const int hcalSubdets[4] = { HcalBarrel, HcalEndcap, HcalOuter,
+			       HcalForward };
+  for (unsigned int s = 0; s < 4; ++s) {
+    const std::vector<DetId>& ids =
+      geom.getValidDetIds(DetId::Hcal, hcalSubdets[s]);
+    for (unsigned int i = 0; i < ids.size(); ++i) {
+      Cell c;
+      if (makeCell(geom, ids[i], c))
+	table.push_back(std::make_pair(ids[i].rawId(), c));
+    }
+  }
+
+  std::sort(table.begin(), table.end(), ById());
+
+  hcalIds_.resize(table.size());
+  hcal_.resize(table.size());
+  for (unsigned int i = 0; i < table.size(); ++i) {
+    hcalIds_[i] = table[i].first;
+    hcal_[i] = table[i].second;
+  }
+  nCells_ += table.size();
+
+  cacheId_ = cacheId;
+
+  return true;
+}
+
+const GlobalHitsCaloCellCache::Cell*
+GlobalHitsCaloCellCache::cell(const DetId& id) const
+{
+  if (id.det() == DetId::Ecal) {
+    const std::vector<Cell>* table = 0;
+    switch (id.subdetId()) {
+    case EcalBarrel:    table = &eb_; break;
+    case EcalEndcap:    table = &ee_; break;
+    case EcalPreshower: table = &es_; break;
+    default:            return 0;
+    }
+    const int idx = ecalHashedIndex(id);
+    if (idx < 0 || idx >= int(table->size())) return 0;
+    const Cell& c = (*table)[idx];
+    return c.valid ? &c : 0;
+  }
+
+  if (id.det() == DetId::Hcal) {
+    std::vector<unsigned int>::const_iterator it =
+      std::lower_bound(hcalIds_.begin(), hcalIds_.end(), id.rawId());
+    if (it == hcalIds_.end() || *it != id.rawId()) return 0;
+    return &hcal_[it - hcalIds_.begin()];
+  }
+
+  return 0;
+}
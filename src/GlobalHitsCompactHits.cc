@@ -0,0 +1,110 @@
+/** \file GlobalHitsCompactHits.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsCompactHits.h"
+
+GlobalHitsCompactHits::GlobalHitsCompactHits() :
+  nRawGenPart_(0), hits_(GlobalHitsColumns::nBlocks)
+{
+}
+
+GlobalHitsCompactHits::Range
+GlobalHitsCompactHits::range(GlobalHitsColumns::Block b, Quantity q)
+{
+  // widest GlobalHitsProdHist axis of each quantity, per block:
+  // ToF, R/Z/E, phi, eta
+  static const Range ranges[GlobalHitsColumns::nBlocks][nQuantities] = {
+    { {0., 40.},  {0., 50.},       {-3.2, 3.2}, {-3.5, 3.5} },  // PxlBrl
+    { {0., 50.},  {-100., 100.},   {-3.2, 3.2}, {-3.5, 3.5} },  // PxlFwd
+    { {0., 50.},  {0., 200.},      {-3.2, 3.2}, {-3.5, 3.5} },  // SiBrl
+    { {0., 75.},  {-300., 300.},   {-3.2, 3.2}, {-3.5, 3.5} },  // SiFwd
+    { {0., 250.}, {-1500., 1500.}, {-3.2, 3.2}, {-3.5, 3.5} },  // MuonCsc
+    { {0., 250.}, {0., 1500.},     {-3.2, 3.2}, {-3.5, 3.5} },  // MuonDt
+    { {0., 250.}, {0., 1500.},     {-3.2, 3.2}, {-3.5, 3.5} },  // MuonRpcBrl
+    { {0., 250.}, {-1500., 1500.}, {-3.2, 3.2}, {-3.5, 3.5} },  // MuonRpcFwd
+    { {0., 1000.}, {0., 10.},      {-3.2, 3.2}, {-5.5, 5.5} },  // ECal
+    { {0., 1000.}, {0., 10.},      {-3.2, 3.2}, {-5.5, 5.5} },  // PreSh
+    { {0., 1000.}, {0., 10.},      {-3.2, 3.2}, {-5.5, 5.5} }   // HCal
+  };
+  return ranges[b][q];
+}
+
+void GlobalHitsCompactHits::put(GlobalHitsColumns::Block b,
+				const FloatVector& tof,
+				const FloatVector& pos,
+				const FloatVector& phi,
+				const FloatVector& eta)
+{
+  const FloatVector* in[nQuantities] = { &tof, &pos, &phi, &eta };
+  Hits& hits = hits_[b];
+  CodeVector* out[nQuantities] =
+    { &hits.tof, &hits.pos, &hits.phi, &hits.eta };
+
+  for (int q = 0; q < nQuantities; ++q) {
+    const Range r = range(b, Quantity(q));
+    const FloatVector& x = *in[q];
+    CodeVector& codes = *out[q];
+    codes.resize(x.size());
+    for (unsigned int i = 0; i < x.size(); ++i)
+      codes[i] = encode(x[i], r);
+  }
+}
+
+void GlobalHitsCompactHits::get(GlobalHitsColumns::Block b, Quantity q,
+				FloatVector& out) const
+{
+  const Hits& hits = hits_[b];
+  const CodeVector* in[nQuantities] =
+    { &hits.tof, &hits.pos, &hits.phi, &hits.eta };
+  const CodeVector& codes = *in[q];
+  const Range r = range(b, q);
+
+  out.resize(codes.size());
+  for (unsigned int i = 0; i < codes.size(); ++i)
+    out[i] = decode(codes[i], r);
+}
+
+void GlobalHitsCompactHits::unpack(PGlobalSimHit& product) const
+{
+  product.putRawGenPart(nRawGenPart_);
+  product.putG4Vtx(g4VtxX_, g4VtxY_, g4VtxZ_);
+  product.putG4Trk(g4TrkPt_, g4TrkE_);
+
+  FloatVector tof, pos, phi, eta;
+  for (int i = 0; i < GlobalHitsColumns::nBlocks; ++i) {
+    const GlobalHitsColumns::Block b = GlobalHitsColumns::Block(i);
+    get(b, ToF, tof);
+    get(b, Pos, pos);
+    get(b, Phi, phi);
+    get(b, Eta, eta);
+
+    switch (b) {
+    case GlobalHitsColumns::PxlBrl:
+      product.putPxlBrlHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::PxlFwd:
+      product.putPxlFwdHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::SiBrl:
+      product.putSiBrlHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::SiFwd:
+      product.putSiFwdHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::MuonCsc:
+      product.putMuonCscHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::MuonDt:
+      product.putMuonDtHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::MuonRpcBrl:
+      product.putMuonRpcBrlHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::MuonRpcFwd:
+      product.putMuonRpcFwdHits(tof, pos, phi, eta); break;
+    case GlobalHitsColumns::ECal:
+      product.putECalHits(pos, tof, phi, eta); break;
+    case GlobalHitsColumns::PreSh:
+      product.putPreShHits(pos, tof, phi, eta); break;
+    case GlobalHitsColumns::HCal:
+      product.putHCalHits(pos, tof, phi, eta); break;
+    default:
+      break;
+    }
+  }
+}
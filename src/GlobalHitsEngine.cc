@@ -0,0 +1,25 @@
+/** \file GlobalHitsEngine.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsEngine.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+void GlobalHitsEngine::wrongDetector(const std::string& cat,
+				     GlobalHitsColumns::Block b,
+				     int hit, const DetId& id)
+{
+  edm::LogWarning(cat)
+    << GlobalHitsColumns::name(b) << " hit " << hit
+    << " is not of the expected subdetector; (det,subdet) returned is: ("
+    << id.det() << "," << id.subdetId() << ")";
+}
+
+void GlobalHitsEngine::missingGeometry(const std::string& cat,
+				       GlobalHitsColumns::Block b, int hit)
+{
+  edm::LogWarning(cat)
+    << "Unable to get the geometry of " << GlobalHitsColumns::name(b)
+    << " hit " << hit;
+}
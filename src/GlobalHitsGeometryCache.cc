@@ -0,0 +1,186 @@
+/** \file GlobalHitsGeometryCache.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsGeometryCache.h"
+#include "Geometry/CommonDetUnit/interface/GeomDetUnit.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+  struct ById {
+    bool operator()(const std::pair<unsigned int,
+		    GlobalHitsGeometryCache::Frame>& a,
+		    const std::pair<unsigned int,
+		    GlobalHitsGeometryCache::Frame>& b) const
+    { return a.first < b.first; }
+  };
+
+  // orders hit indices by the frame of the hit
+  struct ByFrame {
+    explicit ByFrame(const int* det) : det_(det) {}
+    bool operator()(unsigned int a, unsigned int b) const
+    { return det_[a] < det_[b]; }
+    const int* det_;
+  };
+
+  // below this mean number of hits per run of equal frames the block is
+  // sorted by frame before the transform
+  const unsigned int kMinRunLength = 4;
+
+  // apply one frame to n local positions; the frame is read into locals
+  // once so the loop is nothing but multiply-adds over the arrays. The
+  // outputs never overlap the inputs; without __restrict__ the compiler
+  // gives up on the alias checks for six arrays and keeps the loop scalar
+  void transformGroup(const GlobalHitsGeometryCache::Frame& f, 
+		      std::size_t n,
+		      const float* lx, const float* ly, const float* lz,
+		      float* __restrict__ gx, float* __restrict__ gy,
+		      float* __restrict__ gz)
+  {
+    const float r0 = f.rot[0], r1 = f.rot[1], r2 = f.rot[2];
+    const float r3 = f.rot[3], r4 = f.rot[4], r5 = f.rot[5];
+    const float r6 = f.rot[6], r7 = f.rot[7], r8 = f.rot[8];
+    const float p0 = f.pos[0], p1 = f.pos[1], p2 = f.pos[2];
+    for (std::size_t k = 0; k < n; ++k) {
+      gx[k] = r0 * lx[k] + r1 * ly[k] + r2 * lz[k] + p0;
+      gy[k] = r3 * lx[k] + r4 * ly[k] + r5 * lz[k] + p1;
+      gz[k] = r6 * lx[k] + r7 * ly[k] + r8 * lz[k] + p2;
+    }
+  }
+}
+
+GlobalHitsGeometryCache::GlobalHitsGeometryCache() : cacheId_(0)
+{
+}
+
+void GlobalHitsGeometryCache::clear()
+{
+  cacheId_ = 0;
+  ids_.clear();
+  frames_.clear();
+}
+
+bool GlobalHitsGeometryCache::update(unsigned long long cacheId,
+				     const TrackingGeometry& geom)
+{
+  if (cacheId == cacheId_ && !ids_.empty()) return false;
+
+  const TrackingGeometry::DetUnitContainer& dets = geom.detUnits();
+
+  std::vector<std::pair<unsigned int, Frame> > table;
+  table.reserve(dets.size());
+
+  TrackingGeometry::DetUnitContainer::const_iterator itDet;
+  for (itDet = dets.begin(); itDet != dets.end(); ++itDet) {
+
+    const BoundPlane& bSurface = (*itDet)->surface();
+    const Surface::RotationType& rot = bSurface.rotation();
+    const Surface::PositionType& pos = bSurface.position();
+
+    // toGlobal applies the transpose of the surface rotation
+    Frame f;
+    f.rot[0] = rot.xx(); f.rot[1] = rot.yx(); f.rot[2] = rot.zx();
+    f.rot[3] = rot.xy(); f.rot[4] = rot.yy(); f.rot[5] = rot.zy();
+    f.rot[6] = rot.xz(); f.rot[7] = rot.yz(); f.rot[8] = rot.zz();
+    f.pos[0] = pos.x(); f.pos[1] = pos.y(); f.pos[2] = pos.z();
+
+    table.push_back(std::make_pair((*itDet)->geographicalId().rawId(), f));
+  }
+
+  std::sort(table.begin(), table.end(), ById());
+
+  ids_.resize(table.size());
+  frames_.resize(table.size());
+  for (unsigned int i = 0; i < table.size(); ++i) {
+    ids_[i] = table[i].first;
+    frames_[i] = table[i].second;
+  }
+
+  cacheId_ = cacheId;
+
+  return true;
+}
+
+int GlobalHitsGeometryCache::index(unsigned int rawId) const
+{
+  std::vector<unsigned int>::const_iterator it =
+    std::lower_bound(ids_.begin(), ids_.end(), rawId);
+  if (it == ids_.end() || *it != rawId) return -1;
+  return it - ids_.begin();
+}
+
+void GlobalHitsGeometryCache::toGlobal(const std::vector<int>& det,
+				       std::vector<float>& x,
+				       std::vector<float>& y,
+				       std::vector<float>& z)
+{
+  const std::size_t n = det.size();
+  if (n == 0) return;
+
+  lx_.resize(n);
+  ly_.resize(n);
+  lz_.resize(n);
+
+  // the hits of a container mostly arrive clustered by DetUnit already
+  unsigned int nRuns = 1;
+  for (std::size_t k = 1; k < n; ++k)
+    if (det[k] != det[k - 1]) ++nRuns;
+
+  if (n >= kMinRunLength * nRuns) {
+
+    // transform every run of equal frames in place
+    std::copy(x.begin(), x.begin() + n, lx_.begin());
+    std::copy(y.begin(), y.begin() + n, ly_.begin());
+    std::copy(z.begin(), z.begin() + n, lz_.begin());
+
+    std::size_t begin = 0;
+    while (begin < n) {
+      std::size_t end = begin + 1;
+      while (end < n && det[end] == det[begin]) ++end;
+      transformGroup(frames_[det[begin]], end - begin,
+		     &lx_[begin], &ly_[begin], &lz_[begin],
+		     &x[begin], &y[begin], &z[begin]);
+      begin = end;
+    }
+
+  } else {
+
+    // gather the hits grouped by frame, transform the groups and scatter
+    // the results back to the original order
+    order_.resize(n);
+    for (std::size_t k = 0; k < n; ++k) order_[k] = k;
+    std::sort(order_.begin(), order_.end(), ByFrame(&det[0]));
+
+    for (std::size_t k = 0; k < n; ++k) {
+      lx_[k] = x[order_[k]];
+      ly_[k] = y[order_[k]];
+      lz_[k] = z[order_[k]];
+    }
+
+    gx_.resize(n);
+    gy_.resize(n);
+    gz_.resize(n);
+
+    std::size_t begin = 0;
+    while (begin < n) {
+      const int theDet = det[order_[begin]];
+      std::size_t end = begin + 1;
+      while (end < n && det[order_[end]] == theDet) ++end;
+      transformGroup(frames_[theDet], end - begin,
+		     &lx_[begin], &ly_[begin], &lz_[begin],
+		     &gx_[begin], &gy_[begin], &gz_[begin]);
+      begin = end;
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+      x[order_[k]] = gx_[k];
+      y[order_[k]] = gy_[k];
+      z[order_[k]] = gz_[k];
+    }
+  }
+
+  return;
+}
@@ -0,0 +1,168 @@
+/** \file GlobalHitsHist1D.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsHist1D.h"
+#include "TArrayD.h"
+#include "TDirectory.h"
+
+namespace {
+
+  // TAxis::FindBin of a fixed binning for every value of x. Out of range
+  // values are moved to xmin before the conversion to int and shifted to
+  // the under/overflow bin by an offset that is exact in double, so the
+  // loop has no branch, no undefined conversion and keeps the bin of
+  // FindBin; __restrict__ spares the aliasing checks that would otherwise
+  // keep it scalar
+  void findBins(const float* __restrict__ x, unsigned int n, int nbins,
+		double xmin, double xmax, int* __restrict__ bin)
+  {
+    const double width = xmax - xmin;
+    const double overflow = nbins;
+    for (unsigned int k = 0; k < n; ++k) {
+      const double v = x[k];
+      const bool under = v < xmin;
+      const bool over = !(v < xmax);  // also NaN, as in FindBin
+      const double c = (under || over) ? xmin : v;
+      const double offset = under ? -1. : (over ? overflow : 0.);
+      bin[k] = 1 + int(nbins * (c - xmin) / width + offset);
+    }
+  }
+}
+
+GlobalHitsHist1D::GlobalHitsHist1D() :
+  statOverflows_(TH1::GetStatOverflows()), statSumw2_(0.)
+{
+  header_.nbins = 0;
+  header_.xmin = header_.xmax = 0.;
+  header_.entries = header_.sumw = header_.sumwx = header_.sumwx2 = 0.;
+}
+
+GlobalHitsHist1D::GlobalHitsHist1D(const std::string& name,
+				   const std::string& title,
+				   unsigned int nbins, double xmin,
+				   double xmax) :
+  name_(name), title_(title), counts_(nbins + 2, 0.f),
+  statOverflows_(TH1::GetStatOverflows()), statSumw2_(0.)
+{
+  header_.nbins = nbins;
+  header_.xmin = xmin;
+  header_.xmax = xmax;
+  header_.entries = header_.sumw = header_.sumwx = header_.sumwx2 = 0.;
+}
+
+void GlobalHitsHist1D::fill(const float* x, unsigned int n, double w)
+{
+  if (bins_.size() < n) bins_.resize(n);
+  int* bin = bins_.data();
+  findBins(x, n, header_.nbins, header_.xmin, header_.xmax, bin);
+
+  if (w != 1. && sumw2_.empty()) weighted();
+
+  header_.entries += n;
+  const float fw = w;
+  for (unsigned int k = 0; k < n; ++k) counts_[bin[k]] += fw;
+  if (!sumw2_.empty()) {
+    const float fw2 = w * w;
+    for (unsigned int k = 0; k < n; ++k) sumw2_[bin[k]] += fw2;
+  }
+
+  // the sums run in fill order, as in TH1::Fill
+  const int nbins = header_.nbins;
+  const bool isWeighted = !sumw2_.empty();
+  for (unsigned int k = 0; k < n; ++k) {
+    if ((bin[k] == 0 || bin[k] > nbins) && !statOverflows_) continue;
+    const double v = x[k];
+    header_.sumw += w;
+    header_.sumwx += w * v;
+    header_.sumwx2 += w * v * v;
+    if (isWeighted) statSumw2_ += w * w;
+  }
+
+  return;
+}
+
+void GlobalHitsHist1D::weighted()
+{
+  sumw2_.assign(counts_.begin(), counts_.end());
+  statSumw2_ = header_.sumw;
+}
+
+bool GlobalHitsHist1D::add(const GlobalHitsHist1D& other)
+{
+  if (!sameBinning(other)) return false;
+
+  if (sumw2_.empty() && !other.sumw2_.empty()) weighted();
+  if (!sumw2_.empty()) {
+    const std::vector<float>& w2 =
+      other.sumw2_.empty() ? other.counts_ : other.sumw2_;
+    for (unsigned int bin = 0; bin < sumw2_.size(); ++bin)
+      sumw2_[bin] += w2[bin];
+    statSumw2_ += other.sumw2_.empty() ? other.header_.sumw :
+      other.statSumw2_;
+  }
+
+  for (unsigned int bin = 0; bin < counts_.size(); ++bin)
+    counts_[bin] += other.counts_[bin];
+  header_.entries += other.header_.entries;
+  header_.sumw += other.header_.sumw;
+  header_.sumwx += other.header_.sumwx;
+  header_.sumwx2 += other.header_.sumwx2;
+
+  return true;
+}
+
+void GlobalHitsHist1D::reset()
+{
+  counts_.assign(header_.nbins + 2, 0.f);
+  header_.entries = header_.sumw = header_.sumwx = header_.sumwx2 = 0.;
+  sumw2_.clear();
+  statSumw2_ = 0.;
+}
+
+void GlobalHitsHist1D::addTo(TH1* h) const
+{
+  if (header_.entries == 0.) return;
+
+  // take the statistics before touching the bins: TH1::GetStats
+  // recomputes them from the bin contents when they are still empty
+  double stats[4];
+  h->GetStats(stats);
+
+  // weighted fills need the squared weights of h as well; Sumw2 takes
+  // those of its present contents from the counts
+  const bool isWeighted = !sumw2_.empty();
+  if (isWeighted && !h->GetSumw2N()) h->Sumw2();
+
+  for (unsigned int bin = 0; bin < counts_.size(); ++bin) {
+    if (counts_[bin] == 0.f) continue;
+    h->AddBinContent(bin, counts_[bin]);
+    // unit weights: the sum of squared weights equals the count
+    if (h->GetSumw2N())
+      h->GetSumw2()->fArray[bin] +=
+	isWeighted ? sumw2_[bin] : counts_[bin];
+  }
+
+  stats[0] += header_.sumw;
+  stats[1] += isWeighted ? statSumw2_ : header_.sumw;
+  stats[2] += header_.sumwx;
+  stats[3] += header_.sumwx2;
+  h->PutStats(stats);
+  h->SetEntries(h->GetEntries() + header_.entries);
+
+  return;
+}
+
+std::unique_ptr<TH1F> GlobalHitsHist1D::toTH1F() const
+{
+  // owned by the caller, so never registered with the current directory
+  TDirectory::TContext ctx(nullptr);
+  std::unique_ptr<TH1F> h(new TH1F(name_.c_str(), title_.c_str(),
+				   header_.nbins, header_.xmin,
+				   header_.xmax));
+  h->GetXaxis()->SetTitle(xTitle_.c_str());
+  h->GetYaxis()->SetTitle(yTitle_.c_str());
+  addTo(h.get());
+  return h;
+}
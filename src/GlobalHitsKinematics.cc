@@ -0,0 +1,119 @@
+/** \file GlobalHitsKinematics.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsKinematics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+namespace {
+
+  const float kPiOver2 = 1.57079632679490f;
+  const float kPiOver4 = 0.78539816339745f;
+
+  // added to denominators that may be zero
+  const float kTiny = 1.e-30f;
+
+  // smallest perp/|z| used for eta, i.e. |eta| ~ 42 on the beam line
+  const float kMinCotLambda = 1.e-18f;
+
+  // atan on [0,1], minimax polynomial in a^2
+  inline float atanUnit(float a)
+  {
+    const float s = a * a;
+    return a * (0.99997726f +
+		s * (-0.33262347f +
+		     s * (0.19354346f +
+			  s * (-0.11643287f +
+			       s * (0.05265332f +
+				    s * -0.01172120f)))));
+  }
+
+  // branch free atan2: the octant corrections use copysign instead of
+  // selects, which the compiler does not reliably if-convert
+  inline float atan2Impl(float y, float x)
+  {
+    const float ax = std::fabs(x);
+    const float ay = std::fabs(y);
+    // the offset keeps x = y = 0 finite
+    float r = atanUnit(std::min(ax, ay) / (std::max(ax, ay) + kTiny));
+    // |y| > |x|: pi/2 - r
+    const float d = ay - ax - kTiny;
+    r = (std::copysign(kPiOver4, d) + kPiOver4) - std::copysign(r, d);
+    // x < 0: pi - r
+    r = (kPiOver2 - std::copysign(kPiOver2, x)) + std::copysign(r, x);
+    return std::copysign(r, y);
+  }
+
+  // natural log of a positive normal float (cephes logf polynomial); the
+  // mantissa is moved into [sqrt(0.5),sqrt(2)) with integer ops only
+  inline float logImpl(float x)
+  {
+    const uint32_t kSqrtHalf = 0x3f3504f3;
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const uint32_t tmp = bits - kSqrtHalf;
+    const float fe = float(int32_t(tmp) >> 23);
+    bits -= tmp & 0xff800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    m -= 1.f;
+
+    const float z = m * m;
+    float y = ((((((((7.0376836292E-2f * m - 1.1514610310E-1f) * m
+		     + 1.1676998740E-1f) * m - 1.2420140846E-1f) * m
+		   + 1.4249322787E-1f) * m - 1.6668057665E-1f) * m
+		 + 2.0000714765E-1f) * m - 2.4999993993E-1f) * m
+	       + 3.3333331174E-1f) * m * z;
+    y += fe * -2.12194440e-4f;
+    y += -0.5f * z;
+    return m + y + fe * 0.693359375f;
+  }
+
+  inline float asinhImpl(float x)
+  {
+    const float ax = std::fabs(x);
+    return std::copysign(logImpl(ax + std::sqrt(ax * ax + 1.f)), x);
+  }
+
+} // end unnamed namespace
+
+void GlobalHitsKinematics::compute(std::size_t n,
+				   const float* x, const float* y,
+				   const float* z,
+				   float* perp, float* phi, float* eta)
+{
+  if (perp) {
+    for (std::size_t i = 0; i < n; ++i)
+      perp[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+    phi[i] = atan2Impl(y[i], x[i]);
+
+  // eta = asinh(z/perp)
+  for (std::size_t i = 0; i < n; ++i) {
+    const float r = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+    // clamp through the denominator; clamping t itself lets the compiler
+    // branch around the sqrt of the constant and stops vectorization
+    const float az = std::fabs(z[i]);
+    const float t = az / std::max(r, az * kMinCotLambda + kTiny);
+    eta[i] = asinhImpl(std::copysign(t, z[i]));
+  }
+
+  return;
+}
+
+float GlobalHitsKinematics::fastAtan2(float y, float x)
+{
+  return atan2Impl(y, x);
+}
+
+float GlobalHitsKinematics::fastAsinh(float x)
+{
+  return asinhImpl(x);
+}
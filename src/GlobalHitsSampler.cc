@@ -0,0 +1,203 @@
+/** \file GlobalHitsSampler.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsSampler.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+  // splitmix64 finalizer, to turn the seed, event numbers and block into
+  // unrelated engine seeds
+  unsigned long long mix(unsigned long long x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+}
+
+GlobalHitsSampler::GlobalHitsSampler(const edm::ParameterSet& iPSet,
+				     const std::string& category) :
+  seed_(0), enabled_(false), eventSeed_(0)
+{
+  const edm::ParameterSet sampling =
+    iPSet.getUntrackedParameter<edm::ParameterSet>("Sampling",
+						   edm::ParameterSet());
+  seed_ = sampling.getUntrackedParameter<unsigned int>("Seed", 12345);
+
+  for (int s = 0; s < GlobalHitsSubsystems::nSystems; ++s) {
+    fraction_[s] = 1.;
+    reservoir_[s] = 0;
+    if (s == GlobalHitsSubsystems::G4MC) continue;
+
+    const std::string name =
+      GlobalHitsSubsystems::name(GlobalHitsSubsystems::System(s));
+    fraction_[s] =
+      sampling.getUntrackedParameter<double>(name + "Fraction", 1.);
+    reservoir_[s] =
+      sampling.getUntrackedParameter<unsigned int>(name + "Reservoir", 0);
+    if (!(fraction_[s] > 0. && fraction_[s] <= 1.)) {
+      edm::LogWarning(category)
+	<< "Ignoring " << name << "Fraction = " << fraction_[s]
+	<< " outside (0,1] in Sampling";
+      fraction_[s] = 1.;
+    }
+    if (fraction_[s] < 1. || reservoir_[s] > 0) enabled_ = true;
+  }
+}
+
+void GlobalHitsSampler::setEvent(const edm::EventID& id)
+{
+  eventSeed_ = mix(mix(mix(mix(seed_) ^ id.run()) ^ id.luminosityBlock()) ^
+		   id.event());
+}
+
+unsigned int GlobalHitsSampler::kept(GlobalHitsColumns::Block b,
+				     unsigned int n) const
+{
+  const int s = system(b);
+  unsigned int k = n;
+  if (fraction_[s] < 1.)
+    k = (unsigned int)std::ceil(fraction_[s] * n);
+  if (reservoir_[s] > 0 && k > reservoir_[s])
+    k = reservoir_[s];
+  return k;
+}
+
+GlobalHitsSampler::Selection::Selection(const GlobalHitsSampler* sampler,
+					GlobalHitsColumns::Block b,
+					unsigned int n) :
+  records0_(n), kept_(n), weight_(1.f), left_(n), records_(n), state_(0)
+{
+  if (!sampler) return;
+  kept_ = left_ = sampler->kept(b, n);
+  if (kept_ < n) {
+    weight_ = float(double(n) / kept_);
+    state_ = mix(sampler->eventSeed_ ^ (b + 1));
+  }
+}
+
+double GlobalHitsSampler::Selection::uniform()
+{
+  // splitmix64 stream, 53 bit mantissa, never 0 or 1
+  state_ += 0x9e3779b97f4a7c15ULL;
+  return ((mix(state_) >> 11) + 0.5) * (1. / 9007199254740992.);
+}
+
+unsigned int GlobalHitsSampler::Selection::skip()
+{
+  // J. S. Vitter, An efficient algorithm for sequential random sampling,
+  // ACM Trans. Math. Softw. 13 (1987) 58: method D draws the skip in O(1)
+  // expected time; method A, whose cost grows with the skip, is faster
+  // once the kept hits are more than 1/13 of the remaining ones
+  unsigned int s;
+  if (left_ == 1) s = (unsigned int)(records_ * uniform());
+  else if (13. * left_ < records_) s = skipD();
+  else s = skipA();
+  records_ -= s + 1;
+  --left_;
+  return s;
+}
+
+unsigned int GlobalHitsSampler::Selection::skipA()
+{
+  // the probability to skip s or more hits is the product of
+  // (records - left - i)/(records - i) for i < s
+  const double u = uniform();
+  double top = records_ - left_;
+  double bottom = records_;
+  double quot = top / bottom;
+  unsigned int s = 0;
+  while (quot > u) {
+    ++s;
+    top -= 1.;
+    bottom -= 1.;
+    quot *= top / bottom;
+  }
+  return s;
+}
+
+unsigned int GlobalHitsSampler::Selection::skipD()
+{
+  const double n = left_;
+  const double N = records_;
+  const double ninv = 1. / n;
+  const double nmin1inv = 1. / (n - 1.);
+  const unsigned int qu1 = records_ - left_ + 1;
+  const double qu1real = N - n + 1.;
+
+  double vprime = std::exp(std::log(uniform()) * ninv);
+  for (;;) {
+    // candidate X from the continuous approximation of the skip
+    double x;
+    unsigned int s;
+    for (;;) {
+      x = N * (1. - vprime);
+      s = (unsigned int)x;
+      if (s < qu1) break;
+      vprime = std::exp(std::log(uniform()) * ninv);
+    }
+
+    // accept with the squeeze test, or else the exact ratio
+    const double u = uniform();
+    const double y1 = std::exp(std::log(u * N / qu1real) * nmin1inv);
+    vprime = y1 * (1. - x / N) * (qu1real / (qu1real - s));
+    if (vprime <= 1.) return s;
+
+    double y2 = 1.;
+    double top = N - 1.;
+    double bottom;
+    unsigned int limit;
+    if (left_ - 1 > s) {
+      bottom = N - n;
+      limit = records_ - s;
+    } else {
+      bottom = N - s - 1.;
+      limit = qu1;
+    }
+    for (unsigned int t = records_ - 1; t >= limit; --t) {
+      y2 *= top / bottom;
+      top -= 1.;
+      bottom -= 1.;
+    }
+    if (N / (N - x) >= y1 * std::exp(std::log(y2) * nmin1inv)) return s;
+    vprime = std::exp(std::log(uniform()) * ninv);
+  }
+}
+
+GlobalHitsSubsystems::System
+GlobalHitsSampler::system(GlobalHitsColumns::Block b)
+{
+  switch (b) {
+  case GlobalHitsColumns::PxlBrl: case GlobalHitsColumns::PxlFwd:
+  case GlobalHitsColumns::SiBrl: case GlobalHitsColumns::SiFwd:
+    return GlobalHitsSubsystems::Tracker;
+  case GlobalHitsColumns::ECal: case GlobalHitsColumns::PreSh:
+    return GlobalHitsSubsystems::ECal;
+  case GlobalHitsColumns::HCal:
+    return GlobalHitsSubsystems::HCal;
+  default:
+    return GlobalHitsSubsystems::Muon;
+  }
+}
+
+std::string GlobalHitsSampler::summary() const
+{
+  if (!enabled_) return "off";
+
+  std::ostringstream out;
+  out << "Seed " << seed_;
+  for (int s = 0; s < GlobalHitsSubsystems::nSystems; ++s) {
+    if (fraction_[s] == 1. && reservoir_[s] == 0) continue;
+    out << ", " << GlobalHitsSubsystems::name(GlobalHitsSubsystems::System(s))
+	<< " " << fraction_[s];
+    if (reservoir_[s] > 0) out << " (at most " << reservoir_[s] << ")";
+  }
+  return out.str();
+}
@@ -0,0 +1,106 @@
+/** \file GlobalHitsStageTimes.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsStageTimes.h"
+
+#include <cstdio>
+#include <fstream>
+
+void GlobalHitsStageTimes::reset()
+{
+  for (int s = 0; s < nStages; ++s) {
+    totals_[s].calls = totals_[s].hits = 0;
+    totals_[s].wall = totals_[s].cpu = 0.;
+  }
+}
+
+const char* GlobalHitsStageTimes::name(Stage s)
+{
+  static const char* const names[nStages] =
+    { "fillG4MC", "fillTrk", "fillMuon", "fillECal", "fillHCal",
+      "storeG4MC", "storeTrk", "storeMuon", "storeECal", "storeHCal" };
+  return names[s];
+}
+
+unsigned long long
+GlobalHitsStageTimes::columnHits(const GlobalHitsColumns& columns, Stage s)
+{
+  GlobalHitsColumns::Block first, last;
+  switch (s) {
+  case FillTrk: case StoreTrk:
+    first = GlobalHitsColumns::PxlBrl; last = GlobalHitsColumns::SiFwd;
+    break;
+  case FillMuon: case StoreMuon:
+    first = GlobalHitsColumns::MuonCsc; last = GlobalHitsColumns::MuonRpcFwd;
+    break;
+  case FillECal: case StoreECal:
+    first = GlobalHitsColumns::ECal; last = GlobalHitsColumns::PreSh;
+    break;
+  case FillHCal: case StoreHCal:
+    first = last = GlobalHitsColumns::HCal;
+    break;
+  default:
+    return 0;
+  }
+
+  unsigned long long n = 0;
+  for (int b = first; b <= last; ++b)
+    n += columns[GlobalHitsColumns::Block(b)].size();
+  return n;
+}
+
+void GlobalHitsStageTimes::merge(const GlobalHitsStageTimes& other)
+{
+  for (int s = 0; s < nStages; ++s) {
+    totals_[s].calls += other.totals_[s].calls;
+    totals_[s].hits += other.totals_[s].hits;
+    totals_[s].wall += other.totals_[s].wall;
+    totals_[s].cpu += other.totals_[s].cpu;
+  }
+}
+
+std::string GlobalHitsStageTimes::summary() const
+{
+  std::string out =
+    "\n    stage          calls     wall [s]      cpu [s]         hits"
+    "       hits/s";
+  char line[128];
+  for (int s = 0; s < nStages; ++s) {
+    const Totals& t = totals_[s];
+    if (t.calls == 0) continue;
+    std::snprintf(line, sizeof(line),
+		  "\n    %-10s %9llu %12.4f %12.4f %12llu %12.0f",
+		  name(Stage(s)), t.calls, t.wall, t.cpu, t.hits,
+		  t.wall > 0. ? t.hits / t.wall : 0.);
+    out += line;
+  }
+  return out;
+}
+
+bool GlobalHitsStageTimes::writeJSON(const std::string& file,
+				     const std::string& module) const
+{
+  std::ofstream out(file.c_str());
+  if (!out) return false;
+
+  out << "{\n  \"module\": \"" << module << "\",\n  \"stages\": [";
+  bool first = true;
+  char line[256];
+  for (int s = 0; s < nStages; ++s) {
+    const Totals& t = totals_[s];
+    if (t.calls == 0) continue;
+    std::snprintf(line, sizeof(line),
+		  "%s\n    {\"stage\": \"%s\", \"calls\": %llu, "
+		  "\"wall\": %.6g, \"cpu\": %.6g, \"hits\": %llu, "
+		  "\"hitsPerSecond\": %.6g}",
+		  first ? "" : ",", name(Stage(s)), t.calls, t.wall, t.cpu,
+		  t.hits, t.wall > 0. ? t.hits / t.wall : 0.);
+    out << line;
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+
+  return true;
+}
@@ -0,0 +1,48 @@
+/** \file GlobalHitsSubsystems.cc
+ *
+ *  See header file for description of class
+ */
+
+#include "Validation/GlobalHits/interface/GlobalHitsSubsystems.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+GlobalHitsSubsystems::GlobalHitsSubsystems(const edm::ParameterSet& iPSet,
+					   const std::string& category)
+{
+  std::vector<std::string> defaults;
+  for (int s = 0; s < nSystems; ++s)
+    defaults.push_back(name(System(s)));
+  const std::vector<std::string> wanted =
+    iPSet.getUntrackedParameter<std::vector<std::string> >("Subsystems",
+							    defaults);
+
+  for (int s = 0; s < nSystems; ++s)
+    enabled_[s] = false;
+  for (std::size_t i = 0; i < wanted.size(); ++i) {
+    int s = 0;
+    while (s < nSystems && wanted[i] != name(System(s))) ++s;
+    if (s < nSystems)
+      enabled_[s] = true;
+    else
+      edm::LogWarning(category)
+	<< "Ignoring unknown subsystem " << wanted[i] << " in Subsystems";
+  }
+}
+
+const char* GlobalHitsSubsystems::name(System s)
+{
+  static const char* const names[nSystems] =
+    { "G4MC", "Tracker", "Muon", "ECal", "HCal" };
+  return names[s];
+}
+
+std::string GlobalHitsSubsystems::names() const
+{
+  std::string out;
+  for (int s = 0; s < nSystems; ++s) {
+    if (!enabled_[s]) continue;
+    if (!out.empty()) out += " ";
+    out += name(System(s));
+  }
+  return out;
+}
@@ -0,0 +1,13 @@
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "Validation/GlobalHits/interface/GlobalHitsHist1D.h"
+#include "Validation/GlobalHits/interface/GlobalHitsCompactHits.h"
+
+namespace Validation_GlobalHits {
+  struct dictionary {
+    GlobalHitsHist1D hist1D;
+    edm::Wrapper<GlobalHitsHist1D> wrappedHist1D;
+    GlobalHitsCompactHits compactHits;
+    std::vector<GlobalHitsCompactHits::Hits> compactHitsBlocks;
+    edm::Wrapper<GlobalHitsCompactHits> wrappedCompactHits;
+  };
+}